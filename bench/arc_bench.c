@@ -0,0 +1,186 @@
+#include "bench_util.h"
+
+/*
+Kernel-level benchmark sweeping every codec's encode and decode across parameters,
+data sizes, thread counts, and error rates.
+
+usage: ./arc_bench [options]
+-c codecs       comma separated list of parity,hamming,secded,rs (default all)
+-b block sizes  comma separated Parity block sizes, Hamming/SECDED use the 1 and 8 entries (default 1,8,64,1024)
+-k rs devices   comma separated data:code device pairs for Reed-Solomon (default 16:4,32:8)
+-s data sizes   comma separated sizes with optional K/M/G suffix, 4K up to UINT32_MAX bytes (default 4K,64K,1M,16M,256M)
+-t threads      comma separated thread counts (default 1,2,4,... up to omp_get_max_threads)
+-e error rates  comma separated single bit errors injected per MB of data before decoding, with fractional counts rounded stochastically (default 0,1,100)
+-w warmups      untimed runs before measuring (default 2)
+-r repetitions  timed runs per measurement (default 10)
+-o format       csv or json (default csv)
+-f file         write results to file instead of stdout
+
+example:
+./arc_bench -c hamming,rs -s 1M,64M -t 1,8 -r 20 -o json -f hamming_rs.json
+-- This would time Hamming-1/8 and RS-16:4/32:8 encoding and decoding on 1 MB and 64 MB of random data with 1 and 8 threads
+*/
+
+// Summary of the timed runs of one configuration
+struct bench_result {
+    const char* codec;
+    uint32_t parameter_a;
+    uint32_t parameter_b;
+    uint64_t data_size;
+    uint32_t encoded_size;
+    uint32_t threads;
+    double error_rate;
+    uint32_t errors_injected;
+    double encode_median;
+    double encode_p99;
+    double decode_median;
+    double decode_p99;
+    int decode_successes;
+};
+
+// Writes a single result row
+void bench_write(struct bench_settings* settings, struct bench_result* result){
+    double megabytes = (double)result->data_size / 1E6;
+    // Encoding and decoding both read one side and write the other, so both move data_size + encoded_size bytes
+    double encode_roofline = arc_roofline_fraction(result->data_size, result->encoded_size, result->encode_median, result->threads);
+    double decode_roofline = arc_roofline_fraction(result->encoded_size, result->data_size, result->decode_median, result->threads);
+    bench_field(settings, "codec", "%s", result->codec);
+    bench_field(settings, "parameter_a", "%" PRIu32, result->parameter_a);
+    bench_field(settings, "parameter_b", "%" PRIu32, result->parameter_b);
+    bench_field(settings, "data_size", "%" PRIu64, result->data_size);
+    bench_field(settings, "encoded_size", "%" PRIu32, result->encoded_size);
+    bench_field(settings, "threads", "%" PRIu32, result->threads);
+    bench_field(settings, "error_rate", "%lf", result->error_rate);
+    bench_field(settings, "errors_injected", "%" PRIu32, result->errors_injected);
+    bench_field(settings, "repetitions", "%d", settings->repetitions);
+    bench_field(settings, "encode_median_s", "%.9lf", result->encode_median);
+    bench_field(settings, "encode_p99_s", "%.9lf", result->encode_p99);
+    bench_field(settings, "encode_mbps", "%lf", megabytes / result->encode_median);
+    bench_field(settings, "encode_roofline", "%lf", encode_roofline);
+    bench_field(settings, "decode_median_s", "%.9lf", result->decode_median);
+    bench_field(settings, "decode_p99_s", "%.9lf", result->decode_p99);
+    bench_field(settings, "decode_mbps", "%lf", megabytes / result->decode_median);
+    bench_field(settings, "decode_roofline", "%lf", decode_roofline);
+    bench_field(settings, "decode_successes", "%d", result->decode_successes);
+    bench_row(settings);
+}
+
+// Times one codec configuration on one data size and thread count across every error rate
+void bench_configuration(struct bench_settings* settings, int codec, uint32_t parameter_a, uint32_t parameter_b, uint8_t* data, uint64_t data_size, uint32_t threads, void* context){
+    (void)context;
+    int total_runs = settings->warmups + settings->repetitions;
+    double* encode_times = malloc(sizeof(double) * settings->repetitions);
+    double* decode_times = malloc(sizeof(double) * settings->repetitions);
+    uint8_t* encoded_data = NULL;
+    uint32_t encoded_data_size = 0;
+    uint8_t* decoded_data;
+    uint32_t decoded_data_size;
+    int i, j;
+    if (bench_encoded_size(codec, parameter_a, parameter_b, data_size) > UINT32_MAX){
+        fprintf(stderr, "Skipping %s-%" PRIu32 "-%" PRIu32 " on %" PRIu64 " bytes: encoded data would exceed UINT32_MAX bytes\n", bench_codec_names[codec], parameter_a, parameter_b, data_size);
+        free(encode_times);
+        free(decode_times);
+        return;
+    }
+
+    // Time encoding
+    bench_quiet();
+    int err = 1;
+    for (i = 0; i < total_runs && err == 1; i++){
+        if (encoded_data != NULL){
+            free(encoded_data);
+        }
+        double start = bench_now();
+        err = bench_encode(codec, parameter_a, parameter_b, threads, data, (uint32_t)data_size, &encoded_data, &encoded_data_size);
+        double stop = bench_now();
+        if (i >= settings->warmups){
+            encode_times[i - settings->warmups] = stop - start;
+        }
+    }
+    bench_loud();
+    if (err == 0){
+        fprintf(stderr, "Skipping %s-%" PRIu32 "-%" PRIu32 " on %" PRIu64 " bytes: encoding failed\n", bench_codec_names[codec], parameter_a, parameter_b, data_size);
+        free(encode_times);
+        free(decode_times);
+        return;
+    }
+    qsort(encode_times, settings->repetitions, sizeof(double), bench_compare);
+
+    // Time decoding at every error rate with a fresh corrupted copy of the encoded data
+    uint8_t* corrupted_data = malloc(encoded_data_size);
+    for (j = 0; j < settings->error_rate_count; j++){
+        struct bench_result result;
+        unsigned int seed = (unsigned int)(j + 1);
+        uint32_t errors = bench_error_count(settings->error_rates[j], data_size, &seed);
+        uint32_t error;
+        memcpy(corrupted_data, encoded_data, encoded_data_size);
+        for (error = 0; error < errors; error++){
+            uint32_t location = ARC_HEADER_LENGTH + (uint32_t)(((uint64_t)rand_r(&seed) * RAND_MAX + rand_r(&seed)) % (encoded_data_size - ARC_HEADER_LENGTH));
+            corrupted_data[location] ^= (uint8_t)(1 << (rand_r(&seed) % 8));
+        }
+
+        result.decode_successes = 0;
+        bench_quiet();
+        for (i = 0; i < total_runs; i++){
+            double start = bench_now();
+            err = bench_decode(codec, corrupted_data, encoded_data_size, &decoded_data, &decoded_data_size);
+            double stop = bench_now();
+            if (err == 1){
+                free(decoded_data);
+            }
+            if (i >= settings->warmups){
+                decode_times[i - settings->warmups] = stop - start;
+                result.decode_successes += (err == 1);
+            }
+        }
+        bench_loud();
+        qsort(decode_times, settings->repetitions, sizeof(double), bench_compare);
+
+        result.codec = bench_codec_names[codec];
+        result.parameter_a = parameter_a;
+        result.parameter_b = parameter_b;
+        result.data_size = data_size;
+        result.encoded_size = encoded_data_size;
+        result.threads = threads;
+        result.error_rate = settings->error_rates[j];
+        result.errors_injected = errors;
+        result.encode_median = bench_percentile(encode_times, settings->repetitions, 0.5);
+        result.encode_p99 = bench_percentile(encode_times, settings->repetitions, 0.99);
+        result.decode_median = bench_percentile(decode_times, settings->repetitions, 0.5);
+        result.decode_p99 = bench_percentile(decode_times, settings->repetitions, 0.99);
+        bench_write(settings, &result);
+    }
+    free(corrupted_data);
+    free(encoded_data);
+    free(encode_times);
+    free(decode_times);
+}
+
+int main(int argc, char *argv[]){
+    char default_block_sizes[] = "1,8,64,1024";
+    char default_rs_devices[] = "16:4,32:8";
+    char default_data_sizes[] = "4K,64K,1M,16M,256M";
+    char default_error_rates[] = "0,1,100";
+
+    // Read in options
+    struct bench_settings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.block_size_option = default_block_sizes;
+    settings.rs_option = default_rs_devices;
+    settings.data_size_option = default_data_sizes;
+    settings.error_rate_option = default_error_rates;
+    settings.warmups = 2;
+    settings.repetitions = 10;
+    if (bench_options(&settings, argc, argv, NULL, "[-c codecs] [-b block sizes] [-k rs data:code pairs] [-s data sizes] [-t threads] "
+        "[-e errors per MB] [-w warmups] [-r repetitions] [-o csv|json] [-f output file]", NULL, NULL) == 0){
+        return 1;
+    }
+    if (bench_open(&settings) == 0){
+        return 1;
+    }
+
+    // Sweep every data size, codec configuration, and thread count
+    bench_sweep(&settings, bench_configuration, NULL);
+    bench_close(&settings);
+    return 0;
+}
@@ -0,0 +1,492 @@
+#include "bench_util.h"
+
+/*
+End-to-end benchmark driving whole data sets through compress -> arc_encode -> corrupt -> arc_decode -> decompress,
+recording end-to-end throughput and overhead for every constraint setting. Everything runs offline: inputs are local
+raw float32 files and synthetic fields, and the optional compression stage is a built-in error-bounded quantizer
+(uniform quantization to 2 * error bound, delta coded and zigzag varint packed), which produces the kind of
+dense byte stream ARC normally protects.
+
+usage: ./arc_dataset_bench [options]
+-i files        comma separated raw float32 files (default examples/data/hurricane_1_500_500.bin when found)
+-s              byte swap the input files, which are read as big-endian (always on for the bundled hurricane data)
+-g fields       comma separated synthetic fields smooth,noisy,sparse or none (default smooth,noisy)
+-n size         number of floats in each synthetic field with optional K/M/G suffix (default 4M)
+-z bounds       comma separated absolute error bounds for the quantizer, 0 skips compression (default 0,1e-2,1e-4)
+-c constraints  comma separated memory:throughput:ecc settings, each any or a value, ecc any/parity/hamming/secded/rs
+                (default any:any:any,0.25:any:any,any:500:any,any:any:rs)
+-e error rates  comma separated single bit errors injected per MB of data handed to ARC (default 0,10)
+-t threads      maximum number of threads ARC is initialized with (default omp_get_max_threads)
+-w warmups      untimed runs before measuring (default 1)
+-r repetitions  timed runs per measurement (default 5)
+-o format       csv or json (default csv)
+-f file         write results to file instead of stdout
+
+example:
+./arc_dataset_bench -i examples/data/hurricane_1_500_500.bin -g smooth -z 1e-3 -c any:any:any,any:any:secded -e 0,100
+-- This would compress the bundled hurricane field and a smooth synthetic field to within 1e-3, protect them with
+   ARC's unconstrained choice and with SECDED, flip 100 bits per MB, and report how each setting holds up
+*/
+
+// Bundled sample data set, looked for relative to the repository root and the bench folder
+const char* default_inputs[] = {"examples/data/hurricane_1_500_500.bin", "../examples/data/hurricane_1_500_500.bin"};
+const char* field_names[3] = {"smooth", "noisy", "sparse"};
+
+// A single constraint setting handed to arc_encode
+struct dataset_constraint {
+    char label[100];
+    double memory_constraint;
+    double throughput_constraint;
+    int ecc;
+};
+
+// Data set settings on top of the shared error rate, thread, repetition, and output options
+struct dataset_settings {
+    char* input_option;
+    char* field_option;
+    char* error_bound_option;
+    char* constraint_option;
+    char* inputs[BENCH_MAX_LIST];
+    int input_count;
+    int swap_inputs;
+    int fields[3];
+    uint64_t field_size;
+    double error_bounds[BENCH_MAX_LIST];
+    int error_bound_count;
+    struct dataset_constraint constraints[BENCH_MAX_LIST];
+    int constraint_count;
+};
+
+// Summary of the timed runs of one data set under one constraint setting
+struct dataset_result {
+    const char* dataset;
+    uint64_t original_size;
+    double error_bound;
+    uint64_t compressed_size;
+    uint32_t encoded_size;
+    const char* constraint;
+    struct arc_encode_report report;
+    double error_rate;
+    uint32_t errors_injected;
+    double compress_median;
+    double encode_median;
+    double decode_median;
+    double decompress_median;
+    int decode_successes;
+    int within_bound;
+};
+
+// Writes a single result row
+void dataset_write(struct bench_settings* settings, struct dataset_result* result){
+    const char* ecc_names[] = {"none", "parity", "hamming", "secded", "rs"};
+    double megabytes = (double)result->original_size / 1E6;
+    double write_time = result->compress_median + result->encode_median;
+    double read_time = result->decode_median + result->decompress_median;
+    const char* ecc = (result->report.ecc_algorithm >= 1 && result->report.ecc_algorithm <= 4) ? ecc_names[result->report.ecc_algorithm] : ecc_names[0];
+    bench_field(settings, "dataset", "%s", result->dataset);
+    bench_field(settings, "original_size", "%" PRIu64, result->original_size);
+    bench_field(settings, "error_bound", "%g", result->error_bound);
+    bench_field(settings, "compressed_size", "%" PRIu64, result->compressed_size);
+    bench_field(settings, "compression_ratio", "%lf", (double)result->original_size / (double)result->compressed_size);
+    bench_field(settings, "constraint", "%s", result->constraint);
+    bench_field(settings, "ecc", "%s", ecc);
+    bench_field(settings, "parameter_a", "%" PRIu32, result->report.ecc_parameter_a);
+    bench_field(settings, "parameter_b", "%" PRIu32, result->report.ecc_parameter_b);
+    bench_field(settings, "threads", "%" PRIu32, result->report.num_threads);
+    bench_field(settings, "encoded_size", "%" PRIu32, result->encoded_size);
+    bench_field(settings, "arc_overhead", "%lf", ((double)result->encoded_size / (double)result->compressed_size) - 1);
+    bench_field(settings, "predicted_mbps", "%lf", result->report.predicted_throughput);
+    bench_field(settings, "error_rate", "%lf", result->error_rate);
+    bench_field(settings, "errors_injected", "%" PRIu32, result->errors_injected);
+    bench_field(settings, "repetitions", "%d", settings->repetitions);
+    bench_field(settings, "compress_median_s", "%.9lf", result->compress_median);
+    bench_field(settings, "encode_median_s", "%.9lf", result->encode_median);
+    bench_field(settings, "decode_median_s", "%.9lf", result->decode_median);
+    bench_field(settings, "decompress_median_s", "%.9lf", result->decompress_median);
+    bench_field(settings, "encode_mbps", "%lf", ((double)result->compressed_size / 1E6) / result->encode_median);
+    bench_field(settings, "decode_mbps", "%lf", ((double)result->compressed_size / 1E6) / result->decode_median);
+    bench_field(settings, "write_path_mbps", "%lf", megabytes / write_time);
+    bench_field(settings, "read_path_mbps", "%lf", megabytes / read_time);
+    bench_field(settings, "decode_successes", "%d", result->decode_successes);
+    bench_field(settings, "within_bound", "%d", result->within_bound);
+    bench_row(settings);
+}
+
+// Compresses floats to within error_bound by uniform quantization, delta coding, and zigzag varints
+// (an error bound of 0 copies the data unchanged). A varint of 0 escapes a value that cannot be quantized,
+// such as a fill value or NaN, which is then stored as its 4 raw bytes
+uint64_t dataset_compress(const float* data, uint64_t count, double error_bound, uint8_t* compressed){
+    uint64_t i, length = 0;
+    if (error_bound <= 0){
+        memcpy(compressed, data, count * sizeof(float));
+        return count * sizeof(float);
+    }
+    int64_t previous = 0;
+    for (i = 0; i < count; i++){
+        double scaled = (double)data[i] / (2 * error_bound);
+        if (!isfinite(scaled) || fabs(scaled) > 1E15){
+            compressed[length++] = 0;
+            memcpy(&compressed[length], &data[i], sizeof(float));
+            length += sizeof(float);
+            continue;
+        }
+        int64_t quantized = (int64_t)llround(scaled);
+        int64_t delta = quantized - previous;
+        uint64_t code = (((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63)) + 1;
+        previous = quantized;
+        while (code >= 0x80){
+            compressed[length++] = (uint8_t)(code | 0x80);
+            code = code >> 7;
+        }
+        compressed[length++] = (uint8_t)code;
+    }
+    return length;
+}
+
+// Reverses dataset_compress, returning 0 if the compressed data stream does not hold count values
+int dataset_decompress(const uint8_t* compressed, uint64_t length, double error_bound, float* data, uint64_t count){
+    uint64_t i, position = 0;
+    if (error_bound <= 0){
+        if (length != count * sizeof(float)){
+            return 0;
+        }
+        memcpy(data, compressed, length);
+        return 1;
+    }
+    int64_t previous = 0;
+    for (i = 0; i < count; i++){
+        uint64_t code = 0;
+        int shift = 0;
+        while (position < length && (compressed[position] & 0x80) && shift < 63){
+            code |= (uint64_t)(compressed[position++] & 0x7F) << shift;
+            shift += 7;
+        }
+        if (position >= length){
+            return 0;
+        }
+        code |= (uint64_t)compressed[position++] << shift;
+        if (code == 0){
+            if (position + sizeof(float) > length){
+                return 0;
+            }
+            memcpy(&data[i], &compressed[position], sizeof(float));
+            position += sizeof(float);
+            continue;
+        }
+        code = code - 1;
+        previous += (int64_t)(code >> 1) ^ -(int64_t)(code & 1);
+        data[i] = (float)((double)previous * 2 * error_bound);
+    }
+    return position == length;
+}
+
+// Builds a synthetic field of count floats
+void dataset_field(int field, float* data, uint64_t count){
+    uint64_t i;
+    unsigned int seed = (unsigned int)field + 1;
+    for (i = 0; i < count; i++){
+        double x = (double)i / 4096.0;
+        if (field == 0){
+            data[i] = (float)(sin(x) + (0.5 * cos(3.1 * x)) + (0.25 * sin(0.017 * (double)i)));
+        } else if (field == 1){
+            data[i] = (float)(sin(x) + (0.05 * (((double)rand_r(&seed) / RAND_MAX) - 0.5)));
+        } else {
+            data[i] = ((rand_r(&seed) % 64) == 0) ? (float)((double)rand_r(&seed) / RAND_MAX) : 0.0f;
+        }
+    }
+}
+
+// Parses a single memory:throughput:ecc constraint setting
+int dataset_parse_constraint(char* text, struct dataset_constraint* constraint){
+    char memory[32], throughput[32], ecc[32];
+    if (sscanf(text, "%31[^:]:%31[^:]:%31s", memory, throughput, ecc) != 3){
+        return 0;
+    }
+    snprintf(constraint->label, sizeof(constraint->label), "%s:%s:%s", memory, throughput, ecc);
+    constraint->memory_constraint = (strcmp(memory, "any") == 0) ? ARC_ANY_SIZE : atof(memory);
+    constraint->throughput_constraint = (strcmp(throughput, "any") == 0) ? ARC_ANY_BW : atof(throughput);
+    if (strcmp(ecc, "any") == 0){
+        constraint->ecc = ARC_ANY_ECC;
+    } else if (strcmp(ecc, "parity") == 0){
+        constraint->ecc = ARC_PARITY;
+    } else if (strcmp(ecc, "hamming") == 0){
+        constraint->ecc = ARC_HAMMING;
+    } else if (strcmp(ecc, "secded") == 0){
+        constraint->ecc = ARC_SECDED;
+    } else if (strcmp(ecc, "rs") == 0){
+        constraint->ecc = ARC_RS;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+// Drives one data set through the full path at every error bound, constraint setting, and error rate
+void dataset_run(struct bench_settings* settings, struct dataset_settings* dataset, const char* name, float* data, uint64_t count){
+    int total_runs = settings->warmups + settings->repetitions;
+    uint64_t original_size = count * sizeof(float);
+    double* compress_times = malloc(sizeof(double) * settings->repetitions);
+    double* encode_times = malloc(sizeof(double) * settings->repetitions);
+    double* decode_times = malloc(sizeof(double) * settings->repetitions);
+    double* decompress_times = malloc(sizeof(double) * settings->repetitions);
+    // Varints never take more than 10 bytes per value
+    uint8_t* compressed = malloc(count * 10);
+    float* restored = malloc(original_size);
+    int b, c, e, i;
+
+    for (b = 0; b < dataset->error_bound_count; b++){
+        double error_bound = dataset->error_bounds[b];
+        uint64_t compressed_size = 0;
+        for (i = 0; i < total_runs; i++){
+            double start = bench_now();
+            compressed_size = dataset_compress(data, count, error_bound, compressed);
+            double stop = bench_now();
+            if (i >= settings->warmups){
+                compress_times[i - settings->warmups] = stop - start;
+            }
+        }
+        qsort(compress_times, settings->repetitions, sizeof(double), bench_compare);
+        if (compressed_size > UINT32_MAX){
+            fprintf(stderr, "Skipping %s at error bound %g: compressed data exceeds UINT32_MAX bytes\n", name, error_bound);
+            continue;
+        }
+
+        for (c = 0; c < dataset->constraint_count; c++){
+            struct dataset_constraint* constraint = &dataset->constraints[c];
+            int resiliency_constraint[] = {constraint->ecc};
+            uint8_t* encoded_data = NULL;
+            uint32_t encoded_data_size = 0;
+            struct arc_encode_report report;
+            int err = 1;
+            bench_quiet();
+            for (i = 0; i < total_runs && err == 1; i++){
+                if (encoded_data != NULL){
+                    free(encoded_data);
+                    encoded_data = NULL;
+                }
+                double start = bench_now();
+                err = arc_encode_reported(compressed, (uint32_t)compressed_size, constraint->memory_constraint, constraint->throughput_constraint,
+                    resiliency_constraint, 1, &encoded_data, &encoded_data_size, &report);
+                double stop = bench_now();
+                if (i >= settings->warmups){
+                    encode_times[i - settings->warmups] = stop - start;
+                }
+            }
+            bench_loud();
+            if (err == 0){
+                fprintf(stderr, "Skipping %s at error bound %g with constraint %s: no configuration meets it\n", name, error_bound, constraint->label);
+                continue;
+            }
+            qsort(encode_times, settings->repetitions, sizeof(double), bench_compare);
+
+            uint8_t* corrupted_data = malloc(encoded_data_size);
+            for (e = 0; e < settings->error_rate_count; e++){
+                struct dataset_result result;
+                memset(&result, 0, sizeof(result));
+                unsigned int seed = (unsigned int)(e + 1);
+                uint32_t errors = bench_error_count(settings->error_rates[e], compressed_size, &seed);
+                uint32_t error;
+                memcpy(corrupted_data, encoded_data, encoded_data_size);
+                for (error = 0; error < errors; error++){
+                    uint32_t location = ARC_HEADER_LENGTH + (uint32_t)(((uint64_t)rand_r(&seed) * RAND_MAX + rand_r(&seed)) % (encoded_data_size - ARC_HEADER_LENGTH));
+                    corrupted_data[location] ^= (uint8_t)(1 << (rand_r(&seed) % 8));
+                }
+
+                result.within_bound = 1;
+                bench_quiet();
+                for (i = 0; i < total_runs; i++){
+                    uint8_t* decoded_data;
+                    uint32_t decoded_data_size;
+                    double start = bench_now();
+                    err = arc_decode(corrupted_data, encoded_data_size, &decoded_data, &decoded_data_size);
+                    double stop = bench_now();
+                    double decompress_time = 0;
+                    int restored_ok = 0;
+                    if (err == 1){
+                        double decompress_start = bench_now();
+                        restored_ok = dataset_decompress(decoded_data, decoded_data_size, error_bound, restored, count);
+                        decompress_time = bench_now() - decompress_start;
+                        free(decoded_data);
+                    }
+                    if (i >= settings->warmups){
+                        decode_times[i - settings->warmups] = stop - start;
+                        decompress_times[i - settings->warmups] = decompress_time;
+                        result.decode_successes += (err == 1);
+                        // Every restored value must be within the error bound (bit exact without compression)
+                        if (restored_ok && err == 1){
+                            uint64_t v;
+                            for (v = 0; v < count && result.within_bound; v++){
+                                if (memcmp(&restored[v], &data[v], sizeof(float)) != 0 &&
+                                    !(fabs((double)restored[v] - (double)data[v]) <= error_bound * 1.0001 + ((error_bound > 0) ? fabs((double)data[v]) * 1E-6 : 0))){
+                                    result.within_bound = 0;
+                                }
+                            }
+                        } else {
+                            result.within_bound = 0;
+                        }
+                    }
+                }
+                bench_loud();
+                qsort(decode_times, settings->repetitions, sizeof(double), bench_compare);
+                qsort(decompress_times, settings->repetitions, sizeof(double), bench_compare);
+
+                result.dataset = name;
+                result.original_size = original_size;
+                result.error_bound = error_bound;
+                result.compressed_size = compressed_size;
+                result.encoded_size = encoded_data_size;
+                result.constraint = constraint->label;
+                result.report = report;
+                result.error_rate = settings->error_rates[e];
+                result.errors_injected = errors;
+                result.compress_median = bench_percentile(compress_times, settings->repetitions, 0.5);
+                result.encode_median = bench_percentile(encode_times, settings->repetitions, 0.5);
+                result.decode_median = bench_percentile(decode_times, settings->repetitions, 0.5);
+                result.decompress_median = bench_percentile(decompress_times, settings->repetitions, 0.5);
+                dataset_write(settings, &result);
+            }
+            free(corrupted_data);
+            free(encoded_data);
+        }
+    }
+    free(compressed);
+    free(restored);
+    free(compress_times);
+    free(encode_times);
+    free(decode_times);
+    free(decompress_times);
+}
+
+// Reads the input, synthetic field, error bound, and constraint options
+int dataset_option(int option, char* argument, void* context){
+    struct dataset_settings* dataset = (struct dataset_settings*)context;
+    if (option == 'i'){
+        dataset->input_option = argument;
+    } else if (option == 's'){
+        dataset->swap_inputs = 1;
+    } else if (option == 'g'){
+        dataset->field_option = argument;
+    } else if (option == 'n'){
+        dataset->field_size = bench_parse_size(argument);
+    } else if (option == 'z'){
+        dataset->error_bound_option = argument;
+    } else if (option == 'c'){
+        dataset->constraint_option = argument;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]){
+    int i, j;
+    char* tokens[BENCH_MAX_LIST];
+    char default_fields[] = "smooth,noisy";
+    char default_error_bounds[] = "0,1e-2,1e-4";
+    char default_constraints[] = "any:any:any,0.25:any:any,any:500:any,any:any:rs";
+    char default_error_rates[] = "0,10";
+    char default_threads[16];
+    snprintf(default_threads, sizeof(default_threads), "%d", omp_get_max_threads());
+
+    // Read in options
+    struct bench_settings settings;
+    struct dataset_settings dataset;
+    memset(&settings, 0, sizeof(settings));
+    memset(&dataset, 0, sizeof(dataset));
+    settings.thread_option = default_threads;
+    settings.error_rate_option = default_error_rates;
+    settings.warmups = 1;
+    settings.repetitions = 5;
+    dataset.field_option = default_fields;
+    dataset.error_bound_option = default_error_bounds;
+    dataset.constraint_option = default_constraints;
+    dataset.field_size = 4 << 20;
+    if (bench_options(&settings, argc, argv, "i:sg:n:z:c:", "[-i float32 files] [-s] [-g smooth,noisy,sparse|none] [-n field size] [-z error bounds] "
+        "[-c memory:throughput:ecc settings] [-e errors per MB] [-t threads] [-w warmups] [-r repetitions] [-o csv|json] [-f output file]",
+        dataset_option, &dataset) == 0){
+        return 1;
+    }
+
+    // Parse the data sets and settings
+    if (dataset.input_option == NULL){
+        for (i = 0; i < 2; i++){
+            if (access(default_inputs[i], R_OK) == 0){
+                // The bundled hurricane data (like the rest of the Hurricane Isabel data set) is big-endian
+                dataset.inputs[dataset.input_count++] = (char*)default_inputs[i];
+                dataset.swap_inputs = 1;
+                break;
+            }
+        }
+    } else {
+        dataset.input_count = bench_split(dataset.input_option, dataset.inputs);
+    }
+    int count = bench_split(dataset.field_option, tokens);
+    for (i = 0; i < count; i++){
+        for (j = 0; j < 3; j++){
+            if (strcmp(tokens[i], field_names[j]) == 0){
+                dataset.fields[j] = 1;
+            }
+        }
+    }
+    dataset.error_bound_count = bench_split(dataset.error_bound_option, tokens);
+    for (i = 0; i < dataset.error_bound_count; i++){
+        dataset.error_bounds[i] = atof(tokens[i]);
+    }
+    dataset.constraint_count = bench_split(dataset.constraint_option, tokens);
+    for (i = 0; i < dataset.constraint_count; i++){
+        if (dataset_parse_constraint(tokens[i], &dataset.constraints[i]) == 0){
+            printf("Error: Constraints must be given as memory:throughput:ecc with ecc one of any,parity,hamming,secded,rs\n");
+            return 1;
+        }
+    }
+    if (bench_open(&settings) == 0){
+        return 1;
+    }
+
+    // Local files
+    for (i = 0; i < dataset.input_count; i++){
+        FILE* fp = fopen(dataset.inputs[i], "rb");
+        if (fp == NULL){
+            fprintf(stderr, "Skipping %s: unable to open file\n", dataset.inputs[i]);
+            continue;
+        }
+        fseek(fp, 0, SEEK_END);
+        uint64_t file_size = (uint64_t)ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+        uint64_t values = file_size / sizeof(float);
+        float* data = malloc(values * sizeof(float));
+        if (values == 0 || data == NULL || fread(data, sizeof(float), values, fp) != values){
+            fprintf(stderr, "Skipping %s: unable to read float32 values\n", dataset.inputs[i]);
+            free(data);
+            fclose(fp);
+            continue;
+        }
+        fclose(fp);
+        if (dataset.swap_inputs){
+            uint32_t* words = (uint32_t*)data;
+            uint64_t v;
+            for (v = 0; v < values; v++){
+                words[v] = __builtin_bswap32(words[v]);
+            }
+        }
+        dataset_run(&settings, &dataset, dataset.inputs[i], data, values);
+        free(data);
+    }
+
+    // Synthetic fields
+    for (i = 0; i < 3; i++){
+        if (!dataset.fields[i] || dataset.field_size == 0){
+            continue;
+        }
+        float* data = malloc(dataset.field_size * sizeof(float));
+        if (data == NULL){
+            fprintf(stderr, "Skipping %s field: unable to allocate data\n", field_names[i]);
+            continue;
+        }
+        dataset_field(i, data, dataset.field_size);
+        dataset_run(&settings, &dataset, field_names[i], data, dataset.field_size);
+        free(data);
+    }
+    bench_close(&settings);
+    return 0;
+}
@@ -0,0 +1,332 @@
+#include "bench_util.h"
+
+/*
+Fault-injection benchmark measuring what it costs each codec to find and repair errors. Every
+configuration is encoded once, then for every fault model, length, and rate a fresh corrupted copy
+is checked (arc_check), decoded (arc_decode), and repaired in place (arc_repair).
+
+fault models:
+bit         independent single bit flips
+burst       runs of consecutive flipped bits, -l gives the run length in bits
+erasure     runs of bytes overwritten with zeros (e.g. a lost sector), -l gives the run length in bytes
+
+usage: ./arc_fault_bench [options]
+-c codecs       comma separated list of parity,hamming,secded,rs (default all)
+-b block sizes  comma separated Parity block sizes, Hamming/SECDED use the 1 and 8 entries (default 1,8,64)
+-k rs devices   comma separated data:code device pairs for Reed-Solomon (default 16:4,32:8)
+-s data sizes   comma separated sizes with optional K/M/G suffix (default 16M)
+-t threads      comma separated thread counts (default omp_get_max_threads)
+-m models       comma separated list of bit,burst,erasure (default all)
+-l lengths      comma separated burst/erasure lengths (default 2,8,64)
+-e fault rates  comma separated faults injected per MB of data, with fractional counts rounded stochastically (default 0,1,10,100,1000)
+-w warmups      untimed runs before measuring (default 1)
+-r repetitions  timed runs per measurement (default 5)
+-o format       csv or json (default csv)
+-f file         write results to file instead of stdout
+
+Faults land anywhere after the header (check bits and data alike). Corrupting the header itself
+makes the whole stream unreadable, which says nothing about the repair cost of a codec.
+
+example:
+./arc_fault_bench -c hamming,secded,rs -s 64M -t 8 -m bit,burst -l 2,16 -e 1,100,10000
+-- This would measure how Hamming-1/8, SECDED-1/8, and RS-16:4/32:8 cope with 1 to 10000 single bit
+   flips or 2 and 16 bit bursts per MB of 64 MB of random data when decoding with 8 threads
+*/
+
+// Fault Models
+#define FAULT_BIT 0
+#define FAULT_BURST 1
+#define FAULT_ERASURE 2
+const char* fault_names[3] = {"bit", "burst", "erasure"};
+
+// Fault injection settings on top of the shared sweep, whose error rates are the fault rates
+struct fault_settings {
+    char* model_option;
+    char* length_option;
+    int models[3];
+    uint32_t lengths[BENCH_MAX_LIST];
+    int length_count;
+};
+
+// Summary of the timed runs of one configuration under one fault pattern
+struct fault_result {
+    const char* codec;
+    uint32_t parameter_a;
+    uint32_t parameter_b;
+    uint64_t data_size;
+    uint32_t encoded_size;
+    uint32_t threads;
+    const char* model;
+    uint32_t length;
+    double fault_rate;
+    uint32_t faults_injected;
+    uint32_t correctable_blocks;
+    uint32_t uncorrectable_blocks;
+    double check_median;
+    double decode_median;
+    double decode_p99;
+    double repair_median;
+    double repair_p99;
+    int decode_successes;
+    int silent_corruptions;
+    int repair_successes;
+};
+
+// Writes a single result row
+void fault_write(struct bench_settings* settings, struct fault_result* result){
+    double megabytes = (double)result->data_size / 1E6;
+    bench_field(settings, "codec", "%s", result->codec);
+    bench_field(settings, "parameter_a", "%" PRIu32, result->parameter_a);
+    bench_field(settings, "parameter_b", "%" PRIu32, result->parameter_b);
+    bench_field(settings, "data_size", "%" PRIu64, result->data_size);
+    bench_field(settings, "encoded_size", "%" PRIu32, result->encoded_size);
+    bench_field(settings, "threads", "%" PRIu32, result->threads);
+    bench_field(settings, "model", "%s", result->model);
+    bench_field(settings, "length", "%" PRIu32, result->length);
+    bench_field(settings, "fault_rate", "%lf", result->fault_rate);
+    bench_field(settings, "faults_injected", "%" PRIu32, result->faults_injected);
+    bench_field(settings, "correctable_blocks", "%" PRIu32, result->correctable_blocks);
+    bench_field(settings, "uncorrectable_blocks", "%" PRIu32, result->uncorrectable_blocks);
+    bench_field(settings, "repetitions", "%d", settings->repetitions);
+    bench_field(settings, "check_median_s", "%.9lf", result->check_median);
+    bench_field(settings, "check_mbps", "%lf", megabytes / result->check_median);
+    bench_field(settings, "decode_median_s", "%.9lf", result->decode_median);
+    bench_field(settings, "decode_p99_s", "%.9lf", result->decode_p99);
+    bench_field(settings, "decode_mbps", "%lf", megabytes / result->decode_median);
+    bench_field(settings, "repair_median_s", "%.9lf", result->repair_median);
+    bench_field(settings, "repair_p99_s", "%.9lf", result->repair_p99);
+    bench_field(settings, "repair_mbps", "%lf", megabytes / result->repair_median);
+    bench_field(settings, "decode_successes", "%d", result->decode_successes);
+    bench_field(settings, "silent_corruptions", "%d", result->silent_corruptions);
+    bench_field(settings, "repair_successes", "%d", result->repair_successes);
+    bench_row(settings);
+}
+
+// Returns a random 64 bit value below limit
+uint64_t fault_random(unsigned int* seed, uint64_t limit){
+    uint64_t value = ((uint64_t)rand_r(seed) << 31) ^ (uint64_t)rand_r(seed);
+    return value % limit;
+}
+
+// Injects faults of the given model after the header of an encoded data stream, returning how many were injected
+uint32_t fault_inject(uint8_t* encoded_data, uint32_t encoded_data_size, int model, uint32_t length, uint32_t faults, unsigned int seed){
+    uint64_t protected_size = encoded_data_size - ARC_HEADER_LENGTH;
+    uint8_t* protected_data = encoded_data + ARC_HEADER_LENGTH;
+    uint32_t fault;
+    if (protected_size == 0){
+        return 0;
+    }
+    for (fault = 0; fault < faults; fault++){
+        if (model == FAULT_BIT){
+            uint64_t bit = fault_random(&seed, protected_size * 8);
+            protected_data[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        } else if (model == FAULT_BURST){
+            // Every bit of the burst is flipped, clipped at the end of the stream
+            uint64_t bit = fault_random(&seed, protected_size * 8);
+            uint64_t last_bit = bit + length;
+            if (last_bit > protected_size * 8){
+                last_bit = protected_size * 8;
+            }
+            for (; bit < last_bit; bit++){
+                protected_data[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+            }
+        } else {
+            uint64_t byte = fault_random(&seed, protected_size);
+            uint64_t erased = (byte + length > protected_size) ? protected_size - byte : length;
+            memset(protected_data + byte, 0, erased);
+        }
+    }
+    return faults;
+}
+
+// Measures one codec configuration on one data size and thread count under every fault pattern
+void fault_configuration(struct bench_settings* settings, int codec, uint32_t parameter_a, uint32_t parameter_b, uint8_t* data, uint64_t data_size, uint32_t threads, void* context){
+    struct fault_settings* patterns = (struct fault_settings*)context;
+    int total_runs = settings->warmups + settings->repetitions;
+    double* check_times = malloc(sizeof(double) * settings->repetitions);
+    double* decode_times = malloc(sizeof(double) * settings->repetitions);
+    double* repair_times = malloc(sizeof(double) * settings->repetitions);
+    uint8_t* encoded_data;
+    uint32_t encoded_data_size;
+    uint8_t* decoded_data;
+    uint32_t decoded_data_size;
+    int i, j, k, model;
+    if (bench_encoded_size(codec, parameter_a, parameter_b, data_size) > UINT32_MAX){
+        fprintf(stderr, "Skipping %s-%" PRIu32 "-%" PRIu32 " on %" PRIu64 " bytes: encoded data would exceed UINT32_MAX bytes\n", bench_codec_names[codec], parameter_a, parameter_b, data_size);
+        free(check_times);
+        free(decode_times);
+        free(repair_times);
+        return;
+    }
+    bench_quiet();
+    int err = bench_encode(codec, parameter_a, parameter_b, threads, data, (uint32_t)data_size, &encoded_data, &encoded_data_size);
+    bench_loud();
+    if (err == 0){
+        fprintf(stderr, "Skipping %s-%" PRIu32 "-%" PRIu32 " on %" PRIu64 " bytes: encoding failed\n", bench_codec_names[codec], parameter_a, parameter_b, data_size);
+        free(check_times);
+        free(decode_times);
+        free(repair_times);
+        return;
+    }
+
+    uint8_t* corrupted_data = malloc(encoded_data_size);
+    uint8_t* repaired_data = malloc(encoded_data_size);
+    for (model = 0; model < 3; model++){
+        if (!patterns->models[model]){
+            continue;
+        }
+        // Single bit flips have no length
+        int length_count = (model == FAULT_BIT) ? 1 : patterns->length_count;
+        for (k = 0; k < length_count; k++){
+            uint32_t length = (model == FAULT_BIT) ? 1 : patterns->lengths[k];
+            for (j = 0; j < settings->error_rate_count; j++){
+                struct fault_result result;
+                memset(&result, 0, sizeof(result));
+                unsigned int seed = (unsigned int)(j + 1);
+                uint32_t faults = bench_error_count(settings->error_rates[j], data_size, &seed);
+                memcpy(corrupted_data, encoded_data, encoded_data_size);
+                result.faults_injected = fault_inject(corrupted_data, encoded_data_size, model, length, faults, seed);
+
+                bench_quiet();
+                // Count the damage once
+                uint32_t clean_blocks;
+                arc_check(corrupted_data, encoded_data_size, &clean_blocks, &result.correctable_blocks, &result.uncorrectable_blocks);
+                for (i = 0; i < total_runs; i++){
+                    // Detection only
+                    double start = bench_now();
+                    uint32_t correctable_blocks, uncorrectable_blocks;
+                    arc_check(corrupted_data, encoded_data_size, NULL, &correctable_blocks, &uncorrectable_blocks);
+                    double stop = bench_now();
+                    if (i >= settings->warmups){
+                        check_times[i - settings->warmups] = stop - start;
+                    }
+
+                    // Decoding into a new buffer
+                    start = bench_now();
+                    err = arc_decode(corrupted_data, encoded_data_size, &decoded_data, &decoded_data_size);
+                    stop = bench_now();
+                    if (i >= settings->warmups){
+                        decode_times[i - settings->warmups] = stop - start;
+                        result.decode_successes += (err == 1);
+                        // A decode that reports success but returns the wrong data is the worst outcome
+                        result.silent_corruptions += (err == 1 && (decoded_data_size != data_size || memcmp(decoded_data, data, data_size) != 0));
+                    }
+                    if (err == 1){
+                        free(decoded_data);
+                    }
+
+                    // Repairing a fresh corrupted copy in place
+                    memcpy(repaired_data, corrupted_data, encoded_data_size);
+                    uint32_t repaired_blocks;
+                    start = bench_now();
+                    err = arc_repair(repaired_data, encoded_data_size, &repaired_blocks, &uncorrectable_blocks);
+                    stop = bench_now();
+                    if (i >= settings->warmups){
+                        repair_times[i - settings->warmups] = stop - start;
+                        result.repair_successes += (err == 1 && uncorrectable_blocks == 0);
+                    }
+                }
+                bench_loud();
+                qsort(check_times, settings->repetitions, sizeof(double), bench_compare);
+                qsort(decode_times, settings->repetitions, sizeof(double), bench_compare);
+                qsort(repair_times, settings->repetitions, sizeof(double), bench_compare);
+
+                result.codec = bench_codec_names[codec];
+                result.parameter_a = parameter_a;
+                result.parameter_b = parameter_b;
+                result.data_size = data_size;
+                result.encoded_size = encoded_data_size;
+                result.threads = threads;
+                result.model = fault_names[model];
+                result.length = length;
+                result.fault_rate = settings->error_rates[j];
+                result.check_median = bench_percentile(check_times, settings->repetitions, 0.5);
+                result.decode_median = bench_percentile(decode_times, settings->repetitions, 0.5);
+                result.decode_p99 = bench_percentile(decode_times, settings->repetitions, 0.99);
+                result.repair_median = bench_percentile(repair_times, settings->repetitions, 0.5);
+                result.repair_p99 = bench_percentile(repair_times, settings->repetitions, 0.99);
+                fault_write(settings, &result);
+            }
+        }
+    }
+    free(repaired_data);
+    free(corrupted_data);
+    free(encoded_data);
+    free(check_times);
+    free(decode_times);
+    free(repair_times);
+}
+
+// Reads the fault model and length options
+int fault_option(int option, char* argument, void* context){
+    struct fault_settings* patterns = (struct fault_settings*)context;
+    if (option == 'm'){
+        patterns->model_option = argument;
+    } else if (option == 'l'){
+        patterns->length_option = argument;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]){
+    int i, j;
+    char* tokens[BENCH_MAX_LIST];
+    char default_block_sizes[] = "1,8,64";
+    char default_rs_devices[] = "16:4,32:8";
+    char default_data_sizes[] = "16M";
+    char default_threads[16];
+    char default_lengths[] = "2,8,64";
+    char default_fault_rates[] = "0,1,10,100,1000";
+    snprintf(default_threads, sizeof(default_threads), "%d", omp_get_max_threads());
+
+    // Read in options
+    struct bench_settings settings;
+    struct fault_settings patterns;
+    memset(&settings, 0, sizeof(settings));
+    memset(&patterns, 0, sizeof(patterns));
+    settings.block_size_option = default_block_sizes;
+    settings.rs_option = default_rs_devices;
+    settings.data_size_option = default_data_sizes;
+    settings.thread_option = default_threads;
+    settings.error_rate_option = default_fault_rates;
+    settings.warmups = 1;
+    settings.repetitions = 5;
+    patterns.length_option = default_lengths;
+    if (bench_options(&settings, argc, argv, "m:l:", "[-c codecs] [-b block sizes] [-k rs data:code pairs] [-s data sizes] [-t threads] "
+        "[-m bit,burst,erasure] [-l burst/erasure lengths] [-e faults per MB] [-w warmups] [-r repetitions] [-o csv|json] [-f output file]",
+        fault_option, &patterns) == 0){
+        return 1;
+    }
+
+    // Parse the fault patterns
+    if (patterns.model_option == NULL){
+        patterns.models[FAULT_BIT] = patterns.models[FAULT_BURST] = patterns.models[FAULT_ERASURE] = 1;
+    } else {
+        int count = bench_split(patterns.model_option, tokens);
+        for (i = 0; i < count; i++){
+            for (j = 0; j < 3; j++){
+                if (strcmp(tokens[i], fault_names[j]) == 0){
+                    patterns.models[j] = 1;
+                }
+            }
+        }
+    }
+    patterns.length_count = bench_split(patterns.length_option, tokens);
+    for (i = 0; i < patterns.length_count; i++){
+        patterns.lengths[i] = (uint32_t)atoi(tokens[i]);
+        if (patterns.lengths[i] < 1){
+            printf("Error: Burst and erasure lengths must be at least 1\n");
+            return 1;
+        }
+    }
+    if (bench_open(&settings) == 0){
+        return 1;
+    }
+
+    // Sweep every data size, codec configuration, and thread count
+    bench_sweep(&settings, fault_configuration, &patterns);
+    bench_close(&settings);
+    return 0;
+}
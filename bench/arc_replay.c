@@ -0,0 +1,241 @@
+#include "bench_util.h"
+
+/*
+Replays a workload captured with arc_capture_start (or ARC_CAPTURE=path) against synthetic data, so a build or
+configuration change can be judged on real call patterns. Every captured arc_encode call is re-issued with the same
+data size and constraints (or overridden ones) and the plan ARC now chooses and the time it takes are compared with
+what was captured.
+
+usage: ./arc_replay -i capture [options]
+-i capture      capture file to replay
+-m memory       override every call's memory constraint (any or a value)
+-b throughput   override every call's throughput constraint in MB/s (any or a value)
+-c ecc          override every call's resiliency constraint with an ECC method (any/parity/hamming/secded/rs)
+-t threads      maximum number of threads ARC is initialized with (default omp_get_max_threads)
+-n passes       number of times the whole workload is replayed (default 1)
+-p              pace calls to the captured timestamps instead of issuing them back to back
+-d              decode every encoded stream and verify it
+-o format       per call output, csv or json (default only the summary is printed)
+-f file         write per call output to file instead of stdout
+
+example:
+ARC_CAPTURE=workload.cap ./my_app
+./arc_replay -i workload.cap -n 3 -o csv -f replay.csv
+-- This would capture every arc_encode call my_app makes, then replay the workload three times, writing how each
+   call's plan and timing compares with the capture to replay.csv and a summary to stdout
+*/
+
+const char* replay_ecc_names[] = {"none", "parity", "hamming", "secded", "rs"};
+
+// Returns the name of an ECC method identifier
+const char* replay_ecc_name(int ecc_algorithm){
+    return (ecc_algorithm >= 1 && ecc_algorithm <= 4) ? replay_ecc_names[ecc_algorithm] : replay_ecc_names[0];
+}
+
+int main(int argc, char *argv[]){
+    char* input_path = NULL;
+    char* output_path = NULL;
+    int override_memory = 0, override_throughput = 0, override_ecc = 0;
+    double memory_constraint = ARC_ANY_SIZE, throughput_constraint = ARC_ANY_BW;
+    int ecc_constraint = ARC_ANY_ECC;
+    uint32_t threads = (uint32_t)omp_get_max_threads();
+    int passes = 1, pace = 0, verify = 0, per_call = 0, json = 0;
+
+    // Read in options
+    int option;
+    while ((option = getopt(argc, argv, "i:m:b:c:t:n:pdo:f:h")) != -1){
+        if (option == 'i'){
+            input_path = optarg;
+        } else if (option == 'm'){
+            override_memory = 1;
+            memory_constraint = (strcmp(optarg, "any") == 0) ? ARC_ANY_SIZE : atof(optarg);
+        } else if (option == 'b'){
+            override_throughput = 1;
+            throughput_constraint = (strcmp(optarg, "any") == 0) ? ARC_ANY_BW : atof(optarg);
+        } else if (option == 'c'){
+            int codec_constraints[] = {ARC_PARITY, ARC_HAMMING, ARC_SECDED, ARC_RS};
+            int codec;
+            override_ecc = 1;
+            ecc_constraint = ARC_ANY_ECC;
+            for (codec = 0; codec < 4; codec++){
+                if (strcmp(optarg, bench_codec_names[codec]) == 0){
+                    ecc_constraint = codec_constraints[codec];
+                }
+            }
+            if (ecc_constraint == ARC_ANY_ECC && strcmp(optarg, "any") != 0){
+                printf("Error: ECC override must be one of any,parity,hamming,secded,rs\n");
+                return 1;
+            }
+        } else if (option == 't'){
+            threads = (uint32_t)atoi(optarg);
+        } else if (option == 'n'){
+            passes = atoi(optarg);
+        } else if (option == 'p'){
+            pace = 1;
+        } else if (option == 'd'){
+            verify = 1;
+        } else if (option == 'o'){
+            per_call = 1;
+            json = (strcmp(optarg, "json") == 0);
+        } else if (option == 'f'){
+            output_path = optarg;
+        } else {
+            printf("usage: %s -i capture [-m memory] [-b throughput] [-c ecc] [-t threads] [-n passes] [-p] [-d] [-o csv|json] [-f output file]\n", argv[0]);
+            return (option == 'h') ? 0 : 1;
+        }
+    }
+    if (input_path == NULL || passes < 1){
+        printf("Error: A capture file and at least one pass are required (see -h)\n");
+        return 1;
+    }
+
+    // Load the captured workload
+    FILE* capture = arc_capture_open(input_path);
+    if (capture == NULL){
+        return 1;
+    }
+    uint32_t record_count = 0, record_capacity = 1024, max_size = 0;
+    struct arc_capture_record* records = malloc(sizeof(struct arc_capture_record) * record_capacity);
+    while (arc_capture_read(capture, &records[record_count]) == 1){
+        if (records[record_count].data_size > max_size){
+            max_size = records[record_count].data_size;
+        }
+        record_count++;
+        if (record_count == record_capacity){
+            record_capacity = record_capacity * 2;
+            records = realloc(records, sizeof(struct arc_capture_record) * record_capacity);
+        }
+    }
+    fclose(capture);
+    if (record_count == 0){
+        printf("Error: %s holds no calls\n", input_path);
+        free(records);
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if (output_path != NULL){
+        output = fopen(output_path, "w");
+        if (output == NULL){
+            perror("ERROR: ");
+            free(records);
+            return 1;
+        }
+    }
+
+    bench_quiet();
+    int err = arc_init(threads);
+    bench_loud();
+    if (err == 0){
+        printf("Error: Unable to initialize ARC\n");
+        free(records);
+        return 1;
+    }
+
+    // Compressed data is close to random, so replay against random bytes
+    uint8_t* data = malloc((max_size > 0) ? max_size : 1);
+    unsigned int seed = 1;
+    uint32_t i;
+    for (i = 0; i < max_size; i++){
+        data[i] = (uint8_t)rand_r(&seed);
+    }
+
+    int pass;
+    int written = 0;
+    for (pass = 0; pass < passes; pass++){
+        uint64_t bytes = 0;
+        uint32_t calls = 0, failures = 0, plan_matches = 0, verify_failures = 0;
+        double captured_encode = 0, replayed_encode = 0, captured_total = 0, replayed_total = 0;
+        double pass_start = bench_now();
+        for (i = 0; i < record_count; i++){
+            struct arc_capture_record* record = &records[i];
+            struct arc_encode_report report;
+            uint8_t* encoded_data = NULL;
+            uint32_t encoded_data_size = 0;
+            int single_constraint[] = {ecc_constraint};
+            int* resiliency_constraint = override_ecc ? single_constraint : record->resiliency_constraint;
+            int resiliency_count = override_ecc ? 1 : record->resiliency_count;
+            if (pace){
+                double wait = record->timestamp - (bench_now() - pass_start);
+                if (wait > 0){
+                    struct timespec delay = {(time_t)wait, (long)((wait - (double)(time_t)wait) * 1E9)};
+                    nanosleep(&delay, NULL);
+                }
+            }
+
+            memset(&report, 0, sizeof(report));
+            bench_quiet();
+            err = arc_encode_reported(data, record->data_size, override_memory ? memory_constraint : record->memory_constraint,
+                override_throughput ? throughput_constraint : record->throughput_constraint, resiliency_constraint, resiliency_count,
+                &encoded_data, &encoded_data_size, &report);
+            if (err == 1 && verify){
+                uint8_t* decoded_data;
+                uint32_t decoded_data_size;
+                if (arc_decode(encoded_data, encoded_data_size, &decoded_data, &decoded_data_size) == 1){
+                    verify_failures += (decoded_data_size != record->data_size || memcmp(decoded_data, data, decoded_data_size) != 0);
+                    free(decoded_data);
+                } else {
+                    verify_failures++;
+                }
+            }
+            bench_loud();
+            if (err == 1){
+                free(encoded_data);
+            } else {
+                failures++;
+            }
+            int plan_match = (err == 1) && report.ecc_algorithm == record->ecc_algorithm && report.ecc_parameter_a == record->ecc_parameter_a &&
+                report.ecc_parameter_b == record->ecc_parameter_b && report.num_threads == record->num_threads;
+            calls++;
+            bytes += record->data_size;
+            plan_matches += plan_match;
+            captured_encode += record->encode_seconds;
+            captured_total += record->total_seconds;
+            replayed_encode += report.encode_seconds;
+            replayed_total += report.total_seconds;
+
+            if (per_call){
+                if (json){
+                    fprintf(output, "%s\n  {\"pass\": %d, \"call\": %" PRIu32 ", \"data_size\": %" PRIu32 ", \"captured_ecc\": \"%s\", \"captured_parameter_a\": %" PRIu32
+                        ", \"captured_parameter_b\": %" PRIu32 ", \"captured_threads\": %" PRIu32 ", \"replayed_ecc\": \"%s\", \"replayed_parameter_a\": %" PRIu32
+                        ", \"replayed_parameter_b\": %" PRIu32 ", \"replayed_threads\": %" PRIu32 ", \"plan_match\": %d, \"captured_encode_s\": %.9lf, "
+                        "\"replayed_encode_s\": %.9lf, \"captured_total_s\": %.9lf, \"replayed_total_s\": %.9lf, \"success\": %d}",
+                        (written == 0) ? "[" : ",", pass, i, record->data_size, replay_ecc_name(record->ecc_algorithm), record->ecc_parameter_a,
+                        record->ecc_parameter_b, record->num_threads, replay_ecc_name(report.ecc_algorithm), report.ecc_parameter_a, report.ecc_parameter_b,
+                        report.num_threads, plan_match, record->encode_seconds, report.encode_seconds, record->total_seconds, report.total_seconds, err);
+                } else {
+                    if (written == 0){
+                        fprintf(output, "pass,call,data_size,captured_ecc,captured_parameter_a,captured_parameter_b,captured_threads,replayed_ecc,replayed_parameter_a,"
+                            "replayed_parameter_b,replayed_threads,plan_match,captured_encode_s,replayed_encode_s,captured_total_s,replayed_total_s,success\n");
+                    }
+                    fprintf(output, "%d,%" PRIu32 ",%" PRIu32 ",%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%d,%.9lf,%.9lf,%.9lf,%.9lf,%d\n",
+                        pass, i, record->data_size, replay_ecc_name(record->ecc_algorithm), record->ecc_parameter_a, record->ecc_parameter_b, record->num_threads,
+                        replay_ecc_name(report.ecc_algorithm), report.ecc_parameter_a, report.ecc_parameter_b, report.num_threads, plan_match,
+                        record->encode_seconds, report.encode_seconds, record->total_seconds, report.total_seconds, err);
+                }
+                written++;
+            }
+        }
+
+        // Summarize the pass on stderr when per call output shares stdout
+        FILE* summary = (per_call && output == stdout) ? stderr : stdout;
+        fprintf(summary, "Pass %d: %" PRIu32 " calls, %.3lf MB, %" PRIu32 " failed, %" PRIu32 " (%.1lf%%) chose the captured plan\n",
+            pass, calls, (double)bytes / 1E6, failures, plan_matches, 100.0 * plan_matches / calls);
+        fprintf(summary, "  encode time: captured %.6lf s (%.3lf MB/s), replayed %.6lf s (%.3lf MB/s), speedup %.3lfx\n",
+            captured_encode, ((double)bytes / 1E6) / captured_encode, replayed_encode, ((double)bytes / 1E6) / replayed_encode, captured_encode / replayed_encode);
+        fprintf(summary, "  call time:   captured %.6lf s, replayed %.6lf s, speedup %.3lfx\n", captured_total, replayed_total, captured_total / replayed_total);
+        if (verify){
+            fprintf(summary, "  verification: %" PRIu32 " decodes did not return the original data\n", verify_failures);
+        }
+    }
+    if (per_call && json){
+        fprintf(output, "\n]\n");
+    }
+    if (output != stdout){
+        fclose(output);
+    }
+    free(data);
+    free(records);
+    arc_close();
+    return 0;
+}
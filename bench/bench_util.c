@@ -0,0 +1,363 @@
+#include "bench_util.h"
+
+// Codec indices used by every benchmark
+const char* bench_codec_names[4] = {"parity", "hamming", "secded", "rs"};
+
+// Library diagnostics are silenced while timing so they neither skew results nor mix into them
+int saved_stdout = -1;
+
+// Silences stdout while timing
+void bench_quiet(){
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+}
+
+// Restores stdout after timing
+void bench_loud(){
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+}
+
+// Returns seconds on the monotonic clock
+double bench_now(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1E9);
+}
+
+// Sorts doubles in ascending order
+int bench_compare(const void* a, const void* b){
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Returns the nearest-rank percentile of sorted times
+double bench_percentile(double* sorted, int count, double percentile){
+    int rank = (int)ceil(percentile * count) - 1;
+    if (rank < 0){
+        rank = 0;
+    }
+    return sorted[rank];
+}
+
+// Parses a size with an optional K/M/G suffix
+uint64_t bench_parse_size(const char* text){
+    char* end;
+    uint64_t value = strtoull(text, &end, 10);
+    if (*end == 'K' || *end == 'k'){
+        value = value << 10;
+    } else if (*end == 'M' || *end == 'm'){
+        value = value << 20;
+    } else if (*end == 'G' || *end == 'g'){
+        value = value << 30;
+    }
+    return value;
+}
+
+// Converts a rate per MB of data into a whole number of errors, rounding the fraction up with that probability
+// so small streams at low rates still see errors on average
+uint32_t bench_error_count(double rate, uint64_t data_size, unsigned int* seed){
+    double expected = rate * ((double)data_size / 1E6);
+    double whole = floor(expected);
+    if (whole >= UINT32_MAX){
+        return UINT32_MAX;
+    }
+    uint32_t errors = (uint32_t)whole;
+    if ((double)rand_r(seed) / ((double)RAND_MAX + 1) < expected - whole){
+        errors++;
+    }
+    return errors;
+}
+
+// Splits a comma separated option into at most BENCH_MAX_LIST tokens, returning how many were found
+int bench_split(char* text, char** tokens){
+    int count = 0;
+    char* token = strtok(text, ",");
+    while (token != NULL && count < BENCH_MAX_LIST){
+        tokens[count++] = token;
+        token = strtok(NULL, ",");
+    }
+    return count;
+}
+
+// Marks the codecs named in a comma separated list (NULL selects all four)
+int bench_parse_codecs(char* text, int* codecs){
+    char* tokens[BENCH_MAX_LIST];
+    int i, j;
+    if (text == NULL){
+        codecs[0] = codecs[1] = codecs[2] = codecs[3] = 1;
+        return 4;
+    }
+    int selected = 0;
+    int count = bench_split(text, tokens);
+    for (i = 0; i < count; i++){
+        for (j = 0; j < 4; j++){
+            if (strcmp(tokens[i], bench_codec_names[j]) == 0){
+                selected += (codecs[j] == 0);
+                codecs[j] = 1;
+            }
+        }
+    }
+    return selected;
+}
+
+// Encodes data with the given codec configuration
+int bench_encode(int codec, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, uint8_t* data, uint32_t data_size, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (codec == 0){
+        return arc_parity_encode(data, data_size, parameter_a, threads, encoded_data, encoded_data_size);
+    } else if (codec == 1){
+        return arc_hamming_encode(data, data_size, parameter_a, threads, encoded_data, encoded_data_size);
+    } else if (codec == 2){
+        return arc_secded_encode(data, data_size, parameter_a, threads, encoded_data, encoded_data_size);
+    }
+    return arc_reed_solomon_encode(data, data_size, parameter_a, parameter_b, threads, encoded_data, encoded_data_size);
+}
+
+// Decodes data with the given codec
+int bench_decode(int codec, uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t* data_size){
+    if (codec == 0){
+        return arc_parity_decode(encoded_data, encoded_data_size, data, data_size);
+    } else if (codec == 1){
+        return arc_hamming_decode(encoded_data, encoded_data_size, data, data_size);
+    } else if (codec == 2){
+        return arc_secded_decode(encoded_data, encoded_data_size, data, data_size);
+    }
+    return arc_reed_solomon_decode(encoded_data, encoded_data_size, data, data_size);
+}
+
+// Predicts the encoded size of a codec configuration so streams over ARC's 32 bit sizes are skipped
+uint64_t bench_encoded_size(int codec, uint32_t parameter_a, uint32_t parameter_b, uint64_t data_size){
+    if (codec == 0){
+        return ARC_HEADER_LENGTH + data_size + ((data_size + parameter_a - 1) / parameter_a);
+    } else if (codec == 1 || codec == 2){
+        return ARC_HEADER_LENGTH + data_size + (data_size / parameter_a) + (data_size % parameter_a);
+    }
+    uint64_t longs = (data_size + 7) / 8;
+    uint64_t blocks = (longs + parameter_a - 1) / parameter_a;
+    return ARC_HEADER_LENGTH + ((longs + (blocks * parameter_b)) * 9);
+}
+
+// Reads the command line into the settings. Options in extra_options are offered to the handler first, so a
+// benchmark can add options or give a shared letter its own meaning; everything else is a shared sweep or output
+// option. Returns 1 if the benchmark should run and 0 if it should stop (exiting right away for -h)
+int bench_options(struct bench_settings* settings, int argc, char* argv[], const char* extra_options, const char* usage, bench_option_handler handler, void* context){
+    char* tokens[BENCH_MAX_LIST];
+    char options[128];
+    int i, k, option;
+    // getopt takes the first match, so the benchmark's own options shadow the shared ones
+    snprintf(options, sizeof(options), "%sc:b:k:s:t:e:w:r:o:f:h", (extra_options != NULL) ? extra_options : "");
+    while ((option = getopt(argc, argv, options)) != -1){
+        if (handler != NULL && handler(option, optarg, context)){
+            continue;
+        } else if (option == 'c'){
+            settings->codec_option = optarg;
+        } else if (option == 'b'){
+            settings->block_size_option = optarg;
+        } else if (option == 'k'){
+            settings->rs_option = optarg;
+        } else if (option == 's'){
+            settings->data_size_option = optarg;
+        } else if (option == 't'){
+            settings->thread_option = optarg;
+        } else if (option == 'e'){
+            settings->error_rate_option = optarg;
+        } else if (option == 'w'){
+            settings->warmups = atoi(optarg);
+        } else if (option == 'r'){
+            settings->repetitions = atoi(optarg);
+        } else if (option == 'o'){
+            settings->json = (strcmp(optarg, "json") == 0);
+        } else if (option == 'f'){
+            settings->output_path = optarg;
+        } else {
+            printf("usage: %s %s\n", argv[0], usage);
+            if (option == 'h'){
+                exit(0);
+            }
+            return 0;
+        }
+    }
+    if (settings->warmups < 0 || settings->repetitions < 1){
+        printf("Error: Warmups must be at least 0 and repetitions at least 1\n");
+        return 0;
+    }
+
+    // Parse the sweep
+    bench_parse_codecs(settings->codec_option, settings->codecs);
+    if (settings->block_size_option != NULL){
+        settings->block_size_count = bench_split(settings->block_size_option, tokens);
+        for (i = 0; i < settings->block_size_count; i++){
+            settings->block_sizes[i] = (uint32_t)atoi(tokens[i]);
+        }
+    }
+    if (settings->rs_option != NULL){
+        settings->rs_count = bench_split(settings->rs_option, tokens);
+        for (i = 0; i < settings->rs_count; i++){
+            if (sscanf(tokens[i], "%" SCNu32 ":%" SCNu32, &settings->rs_data_devices[i], &settings->rs_code_devices[i]) != 2){
+                printf("Error: Reed-Solomon devices must be given as data:code pairs\n");
+                return 0;
+            }
+        }
+    }
+    if (settings->data_size_option != NULL){
+        settings->data_size_count = bench_split(settings->data_size_option, tokens);
+        for (i = 0; i < settings->data_size_count; i++){
+            settings->data_sizes[i] = bench_parse_size(tokens[i]);
+        }
+    }
+    if (settings->thread_option == NULL){
+        uint32_t max_threads = (uint32_t)omp_get_max_threads();
+        for (k = 1; k < (int)max_threads && settings->thread_count < BENCH_MAX_LIST - 1; k *= 2){
+            settings->threads[settings->thread_count++] = (uint32_t)k;
+        }
+        settings->threads[settings->thread_count++] = max_threads;
+    } else {
+        settings->thread_count = bench_split(settings->thread_option, tokens);
+        for (i = 0; i < settings->thread_count; i++){
+            settings->threads[i] = (uint32_t)atoi(tokens[i]);
+        }
+    }
+    if (settings->error_rate_option != NULL){
+        settings->error_rate_count = bench_split(settings->error_rate_option, tokens);
+        for (i = 0; i < settings->error_rate_count; i++){
+            settings->error_rates[i] = atof(tokens[i]);
+        }
+    }
+    return 1;
+}
+
+// Opens the output and initializes ARC with the most threads any measurement uses
+int bench_open(struct bench_settings* settings){
+    int i;
+    settings->output = stdout;
+    if (settings->output_path != NULL){
+        settings->output = fopen(settings->output_path, "w");
+        if (settings->output == NULL){
+            perror("ERROR: ");
+            return 0;
+        }
+    }
+    uint32_t max_threads = 1;
+    for (i = 0; i < settings->thread_count; i++){
+        if (settings->threads[i] > max_threads){
+            max_threads = settings->threads[i];
+        }
+    }
+    bench_quiet();
+    int err = arc_init(max_threads);
+    bench_loud();
+    if (err == 0){
+        printf("Error: Unable to initialize ARC\n");
+        if (settings->output != stdout){
+            fclose(settings->output);
+        }
+        return 0;
+    }
+    return 1;
+}
+
+// Closes the JSON array and the output, and shuts ARC down
+void bench_close(struct bench_settings* settings){
+    if (settings->json){
+        fprintf(settings->output, "%s\n", (settings->results_written == 0) ? "[]" : "\n]");
+    }
+    if (settings->output != stdout){
+        fclose(settings->output);
+    }
+    arc_close();
+}
+
+// Sweeps every data size, thread count, and codec configuration, handing each to the configuration handler.
+// Parity runs every block size, Hamming and SECDED the block sizes of 1 and 8, and Reed-Solomon every device pair
+void bench_sweep(struct bench_settings* settings, bench_configuration_handler configuration, void* context){
+    int i, j, k;
+    for (i = 0; i < settings->data_size_count; i++){
+        uint64_t data_size = settings->data_sizes[i];
+        // Data streams must fit ARC's 32 bit sizes
+        if (data_size < 1 || data_size > UINT32_MAX){
+            fprintf(stderr, "Skipping data size %" PRIu64 ": sizes must be between 1 and UINT32_MAX bytes\n", data_size);
+            continue;
+        }
+        uint8_t* data = malloc(data_size);
+        if (data == NULL){
+            fprintf(stderr, "Skipping data size %" PRIu64 ": unable to allocate data\n", data_size);
+            continue;
+        }
+        // Random data simulates a compressed data stream
+        unsigned int seed = 0;
+        uint64_t byte;
+        for (byte = 0; byte < data_size; byte++){
+            data[byte] = (uint8_t)(rand_r(&seed) % 256);
+        }
+
+        for (k = 0; k < settings->thread_count; k++){
+            uint32_t threads = settings->threads[k];
+            for (j = 0; j < settings->block_size_count; j++){
+                uint32_t block_size = settings->block_sizes[j];
+                if (settings->codecs[0] && block_size > 0){
+                    configuration(settings, 0, block_size, 0, data, data_size, threads, context);
+                }
+                if (block_size == 1 || block_size == 8){
+                    if (settings->codecs[1]){
+                        configuration(settings, 1, block_size, 0, data, data_size, threads, context);
+                    }
+                    if (settings->codecs[2]){
+                        configuration(settings, 2, block_size, 0, data, data_size, threads, context);
+                    }
+                }
+            }
+            for (j = 0; j < settings->rs_count && settings->codecs[3]; j++){
+                configuration(settings, 3, settings->rs_data_devices[j], settings->rs_code_devices[j], data, data_size, threads, context);
+            }
+        }
+        free(data);
+    }
+}
+
+// Adds one named value, formatted with a printf format, to the row being written. Values formatted
+// with "%s" are quoted in JSON
+void bench_field(struct bench_settings* settings, const char* name, const char* format, ...){
+    char value[256];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(value, sizeof(value), format, arguments);
+    va_end(arguments);
+    int first = (settings->row_length == 0);
+    if (settings->json){
+        const char* quote = (strcmp(format, "%s") == 0) ? "\"" : "";
+        settings->row_length += snprintf(settings->row + settings->row_length, BENCH_MAX_ROW - settings->row_length,
+            "%s\"%s\": %s%s%s", first ? "" : ", ", name, quote, value, quote);
+    } else {
+        settings->header_length += snprintf(settings->header + settings->header_length, BENCH_MAX_ROW - settings->header_length,
+            "%s%s", first ? "" : ",", name);
+        settings->row_length += snprintf(settings->row + settings->row_length, BENCH_MAX_ROW - settings->row_length,
+            "%s%s", first ? "" : ",", value);
+    }
+    if (settings->row_length >= BENCH_MAX_ROW){
+        settings->row_length = BENCH_MAX_ROW - 1;
+    }
+    if (settings->header_length >= BENCH_MAX_ROW){
+        settings->header_length = BENCH_MAX_ROW - 1;
+    }
+}
+
+// Writes the row built with bench_field, as a JSON object or a CSV line under a header written before the first row
+void bench_row(struct bench_settings* settings){
+    if (settings->json){
+        fprintf(settings->output, "%s\n  {%s}", (settings->results_written == 0) ? "[" : ",", settings->row);
+    } else {
+        if (settings->results_written == 0){
+            fprintf(settings->output, "%s\n", settings->header);
+        }
+        fprintf(settings->output, "%s\n", settings->row);
+    }
+    fflush(settings->output);
+    settings->results_written++;
+    settings->row_length = 0;
+    settings->header_length = 0;
+}
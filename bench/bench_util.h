@@ -0,0 +1,84 @@
+// Helpers shared by the ARC benchmarks
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include "arc.h"
+#include <omp.h>      //OpenMP
+
+// Maximum number of entries in any list option
+#define BENCH_MAX_LIST 64
+
+// Codec indices used by every benchmark
+extern const char* bench_codec_names[4];
+
+// Maximum length of one result row or CSV header
+#define BENCH_MAX_ROW 4096
+
+// Sweep and output settings shared by every benchmark. A benchmark points the list options at its defaults,
+// reads the command line with bench_options, and writes each result with bench_field and bench_row
+struct bench_settings {
+    // Comma separated list options, a NULL codec option selects every codec and a NULL thread option 1,2,4,... threads
+    char* codec_option;
+    char* block_size_option;
+    char* rs_option;
+    char* data_size_option;
+    char* thread_option;
+    char* error_rate_option;
+    char* output_path;
+    // Parsed sweep
+    int codecs[4];
+    uint32_t block_sizes[BENCH_MAX_LIST];
+    int block_size_count;
+    uint32_t rs_data_devices[BENCH_MAX_LIST];
+    uint32_t rs_code_devices[BENCH_MAX_LIST];
+    int rs_count;
+    uint64_t data_sizes[BENCH_MAX_LIST];
+    int data_size_count;
+    uint32_t threads[BENCH_MAX_LIST];
+    int thread_count;
+    double error_rates[BENCH_MAX_LIST];
+    int error_rate_count;
+    int warmups;
+    int repetitions;
+    // Output
+    int json;
+    FILE* output;
+    int results_written;
+    char header[BENCH_MAX_ROW];
+    size_t header_length;
+    char row[BENCH_MAX_ROW];
+    size_t row_length;
+};
+
+// Handles a benchmark specific option, returning 1 if it was consumed
+typedef int (*bench_option_handler)(int option, char* argument, void* context);
+
+// Measures one codec configuration on one data size and thread count
+typedef void (*bench_configuration_handler)(struct bench_settings* settings, int codec, uint32_t parameter_a, uint32_t parameter_b,
+    uint8_t* data, uint64_t data_size, uint32_t threads, void* context);
+
+void bench_quiet();
+void bench_loud();
+double bench_now();
+int bench_compare(const void* a, const void* b);
+double bench_percentile(double* sorted, int count, double percentile);
+uint64_t bench_parse_size(const char* text);
+uint32_t bench_error_count(double rate, uint64_t data_size, unsigned int* seed);
+int bench_split(char* text, char** tokens);
+int bench_parse_codecs(char* text, int* codecs);
+int bench_encode(int codec, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, uint8_t* data, uint32_t data_size, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int bench_decode(int codec, uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t* data_size);
+uint64_t bench_encoded_size(int codec, uint32_t parameter_a, uint32_t parameter_b, uint64_t data_size);
+int bench_options(struct bench_settings* settings, int argc, char* argv[], const char* extra_options, const char* usage, bench_option_handler handler, void* context);
+int bench_open(struct bench_settings* settings);
+void bench_close(struct bench_settings* settings);
+void bench_sweep(struct bench_settings* settings, bench_configuration_handler configuration, void* context);
+void bench_field(struct bench_settings* settings, const char* name, const char* format, ...);
+void bench_row(struct bench_settings* settings);
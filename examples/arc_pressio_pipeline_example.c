@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <math.h>
+#include <float.h>
+#include <sys/time.h>
+#include <execinfo.h>
+// ARC Libraries
+#include "arc.h"
+#include<omp.h>
+
+// Libpressio Libraries
+#include "libpressio.h"
+#include "sz.h"
+
+/*
+ARGV[1] := path/to/data
+ARGV[2] := path/to/output
+ARGV[3] := error bound
+ARGV[4] := number of cores
+ARGV[5] := ECC
+ARGV[6] := number of slabs
+ARGV[7] := queue depth between stages
+
+example run on palmetto:
+./arc_pressio_pipeline_example /zfs/fthpc/common/sdrbench/nyx/baryon_density.dat baryon_density.arc 0.001 24 2 16 2
+-- This would split the field into 16 slabs along its slowest dimension and overlap SZ compression,
+-- ARC Hamming encoding, and writing of neighbouring slabs with at most 2 slabs waiting between stages
+*/
+
+// Pipeline state shared by the compress and write stages
+struct pressio_pipeline {
+    float* data;
+    size_t dims[3];
+    size_t slab_planes;
+    struct pressio_compressor* compressor;
+    FILE* output;
+    double compress_time_taken;
+    double write_time_taken;
+    size_t compressed_size;
+    size_t encoded_size;
+};
+
+// Compress a slab of planes along the slowest dimension with libPressio
+int pipeline_compress(uint32_t slab, void* user_data, uint8_t** compressed_data, uint32_t* compressed_data_size){
+    struct pressio_pipeline* pipeline = (struct pressio_pipeline*)user_data;
+    struct timeval start, stop;
+    gettimeofday(&start, NULL);
+
+    // Determine which planes belong to this slab
+    size_t first_plane = slab * pipeline->slab_planes;
+    size_t planes = pipeline->slab_planes;
+    if (first_plane + planes > pipeline->dims[2]){
+        planes = pipeline->dims[2] - first_plane;
+    }
+    size_t plane_size = pipeline->dims[0] * pipeline->dims[1];
+    size_t slab_dims[] = {pipeline->dims[0], pipeline->dims[1], planes};
+
+    // Compress the slab in place without copying the input
+    struct pressio_data* input_data = pressio_data_new_nonowning(pressio_float_dtype, pipeline->data + first_plane * plane_size, 3, slab_dims);
+    struct pressio_data* output_data = pressio_data_new_empty(pressio_byte_dtype, 0, NULL);
+    if (pressio_compressor_compress(pipeline->compressor, input_data, output_data)){
+        printf("%s\n", pressio_compressor_error_msg(pipeline->compressor));
+        pressio_data_free(input_data);
+        pressio_data_free(output_data);
+        return 0;
+    }
+
+    // Hand ARC a malloc'd copy of the compressed bytes
+    size_t output_size;
+    uint8_t* output_ptr = (uint8_t*)pressio_data_ptr(output_data, &output_size);
+    *compressed_data = malloc(output_size);
+    memcpy(*compressed_data, output_ptr, output_size);
+    *compressed_data_size = (uint32_t)output_size;
+    pipeline->compressed_size += output_size;
+    pressio_data_free(input_data);
+    pressio_data_free(output_data);
+
+    gettimeofday(&stop, NULL);
+    pipeline->compress_time_taken += (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
+    return 1;
+}
+
+// Write an ARC encoded slab to the output file as [4B slab size][encoded slab]
+int pipeline_write(uint32_t slab, uint8_t* encoded_data, uint32_t encoded_data_size, void* user_data){
+    struct pressio_pipeline* pipeline = (struct pressio_pipeline*)user_data;
+    struct timeval start, stop;
+    gettimeofday(&start, NULL);
+    if (fwrite(&encoded_data_size, sizeof(uint32_t), 1, pipeline->output) != 1){
+        return 0;
+    }
+    if (fwrite(encoded_data, 1, encoded_data_size, pipeline->output) != encoded_data_size){
+        return 0;
+    }
+    pipeline->encoded_size += encoded_data_size;
+    gettimeofday(&stop, NULL);
+    pipeline->write_time_taken += (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Declare dataset file and dimensions to compress with libPressio
+    char *data_path = argv[1];
+    char *output_path = argv[2];
+    double error_bound = atof(argv[3]);
+    int number_threads = atoi(argv[4]);
+    int ecc_selection = atoi(argv[5]);
+    uint32_t slab_count = (uint32_t)atoi(argv[6]);
+    uint32_t queue_depth = (uint32_t)atoi(argv[7]);
+    size_t dims[] = {512, 512, 512};
+    int ndims = sizeof(dims)/sizeof(dims[0]);
+    struct timeval start, stop;
+
+    // Read in data from file
+    size_t data_size = sizeof(float);
+    for(int k = 0; k < ndims; k++)
+        data_size *= dims[k];
+    FILE *fp;
+    float* data = malloc(data_size);
+    fp = fopen(data_path,"rb");
+    if (fp == NULL){
+        perror("ERROR: ");
+        exit(-1);
+    } else {
+        fread(data, 1, data_size, fp);
+        fclose(fp);
+    }
+
+    // Set ECC
+    int resiliency_constraint[1];
+    if (ecc_selection >= 1 && ecc_selection <= 4){
+        resiliency_constraint[0] = -ecc_selection;
+    } else {
+        printf("UNSUPPORTED ECC INPUT\n");
+        exit(-1);
+    }
+    if (slab_count < 1 || slab_count > dims[2]){
+        printf("UNSUPPORTED SLAB COUNT\n");
+        exit(-1);
+    }
+
+    // Initialize libPressio and configure SZ
+    struct pressio* library = pressio_instance();
+    struct pressio_compressor* compressor = pressio_get_compressor(library, "sz");
+    struct pressio_options* sz_options = pressio_compressor_get_options(compressor);
+    pressio_options_set_integer(sz_options, "sz:error_bound_mode", ABS);
+    pressio_options_set_double(sz_options, "sz:abs_err_bound", error_bound);
+    if (pressio_compressor_check_options(compressor, sz_options)) {
+        printf("%s\n", pressio_compressor_error_msg(compressor));
+        exit(pressio_compressor_error_code(compressor));
+    }
+    if (pressio_compressor_set_options(compressor, sz_options)) {
+        printf("%s\n", pressio_compressor_error_msg(compressor));
+        exit(pressio_compressor_error_code(compressor));
+    }
+
+    // Utilize ARC library
+    arc_init(number_threads);
+
+    // Set up pipeline
+    struct pressio_pipeline pipeline;
+    pipeline.data = data;
+    memcpy(pipeline.dims, dims, sizeof(dims));
+    pipeline.slab_planes = (dims[2] + slab_count - 1) / slab_count;
+    slab_count = (uint32_t)((dims[2] + pipeline.slab_planes - 1) / pipeline.slab_planes);
+    pipeline.compressor = compressor;
+    pipeline.compress_time_taken = 0.0;
+    pipeline.write_time_taken = 0.0;
+    pipeline.compressed_size = 0;
+    pipeline.encoded_size = 0;
+    pipeline.output = fopen(output_path, "wb");
+    if (pipeline.output == NULL){
+        perror("ERROR: ");
+        exit(-1);
+    }
+
+    // Run compress -> protect -> write with neighbouring slabs overlapped
+    double pipeline_time_taken;
+    gettimeofday(&start, NULL);
+    int ret = arc_pipeline(slab_count, queue_depth, pipeline_compress, pipeline_write, &pipeline, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1);
+    gettimeofday(&stop, NULL);
+    pipeline_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
+    fclose(pipeline.output);
+    if (ret == 0){
+        printf("Error Found In ARC...\nExiting...\n");
+    }
+
+    // Time spent in ARC is hidden whenever the pipeline takes about as long as compression alone
+    double compression_ratio = (double)data_size / (double)pipeline.compressed_size;
+    double pipeline_bandwidth = data_size / (1e6*(pipeline_time_taken));
+    printf("%s,%d,%d,%" PRIu32 ",%" PRIu32 ",%lf,%lf,%lf,%lf,%lf,%zu,%lf\n",
+        data_path, number_threads, ecc_selection, slab_count, queue_depth, error_bound,
+        pipeline_time_taken, pipeline.compress_time_taken, pipeline.write_time_taken,
+        compression_ratio, pipeline.encoded_size, pipeline_bandwidth);
+
+    // Free options, library, and data
+    pressio_options_free(sz_options);
+    pressio_compressor_release(compressor);
+    pressio_release(library);
+    arc_close();
+    free(data);
+    return 0;
+}
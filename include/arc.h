@@ -9,12 +9,24 @@
 #include <getopt.h>
 #include <inttypes.h>
 #include <omp.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 
 // Information Variables
 extern int PRINT;
 extern int AVAIL_THREADS;
 extern int NUM_CONFIGURATIONS;
+extern int SCHEDULE_CHUNK_SIZE;
+extern int ARC_ASYNC_THREADS;
 // User Control Variables
 extern double ARC_ANY_THREADS;
 extern double ARC_ANY_SIZE;
@@ -28,6 +40,92 @@ extern int ARC_RS;
 extern int ARC_DET_SPARSE;
 extern int ARC_COR_SPARSE;
 extern int ARC_COR_BURST;
+// Layout Control Variables
+extern int ARC_SPLIT_LAYOUT;
+// Header Control Variables
+extern int ARC_FORMAT_VERSION;
+extern int ARC_PAYLOAD_CHECKSUM;
+extern uint32_t ARC_HEADER_LENGTH;
+// Online Learning Control Variables
+extern double ARC_UPDATE_WEIGHT;
+extern double ARC_NEIGHBOR_WEIGHT;
+extern double ARC_CONFIDENCE_Z;
+// Exploration Control Variables
+extern int ARC_EXPLORE_NONE;
+extern int ARC_EXPLORE_EPSILON;
+extern int ARC_EXPLORE_UCB;
+extern int ARC_EXPLORE;
+extern double ARC_EXPLORE_RATE;
+extern double ARC_EXPLORE_MARGIN;
+extern double ARC_EXPLORE_UCB_WEIGHT;
+// Roofline Control Variables
+extern double ARC_ROOFLINE_BOUND;
+// Tracing Control Variables
+extern int ARC_TRACE;
+// Block Status Values
+extern int ARC_BLOCK_CLEAN;
+extern int ARC_BLOCK_CORRECTABLE;
+extern int ARC_BLOCK_UNCORRECTABLE;
+
+// Asynchronous Types
+struct arc_ticket;
+typedef void (*arc_callback)(int err, uint8_t* result_data, uint32_t result_data_size, void* user_data);
+// Pipeline Types
+typedef int (*arc_pipeline_compress_fn)(uint32_t slab, void* user_data, uint8_t** compressed_data, uint32_t* compressed_data_size);
+typedef int (*arc_pipeline_write_fn)(uint32_t slab, uint8_t* encoded_data, uint32_t encoded_data_size, void* user_data);
+
+// Scrubber Types
+struct arc_scrubber;
+typedef void (*arc_scrub_callback)(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t correctable_blocks, uint32_t uncorrectable_blocks, void* user_data);
+
+// Reporting Types
+// Describes a single arc_encode_reported call
+struct arc_encode_report {
+    int ecc_algorithm;
+    uint32_t ecc_parameter_a;
+    uint32_t ecc_parameter_b;
+    uint32_t num_threads;
+    double predicted_throughput;    // MB/s the configuration table predicted (-1 if unknown)
+    double measured_throughput;     // MB/s achieved by the encoding
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    double optimize_seconds;
+    double encode_seconds;
+    double update_seconds;
+    double total_seconds;
+    double roofline_fraction;       // encode memory traffic over the probed copy bandwidth (-1 if unknown)
+};
+// Library-wide counters returned by arc_get_stats (per method times are indexed by ECC method identifier)
+struct arc_stats {
+    uint64_t encode_calls;
+    uint64_t decode_calls;
+    uint64_t bytes_protected;
+    uint64_t bytes_decoded;
+    uint64_t blocks_corrected;
+    uint64_t blocks_uncorrectable;
+    double encode_seconds[5];
+    double decode_seconds[5];
+    uint64_t explorations;          // optimizer choices the exploration policy replaced with another candidate
+};
+// A single encode call logged by arc_capture_start and read back by arc_capture_read. arc_encode, arc_encode_reported,
+// arc_encodev, arc_encode_batch, and arc_encode_parts are all logged, including calls that fail. Vectored and batch
+// calls are logged as one call over all of their data
+struct arc_capture_record {
+    double timestamp;               // seconds since the capture started
+    uint32_t data_size;
+    double memory_constraint;
+    double throughput_constraint;
+    int resiliency_count;           // at most 8 entries are kept
+    int resiliency_constraint[8];
+    int ecc_algorithm;              // 0 if no configuration met the constraints
+    uint32_t ecc_parameter_a;
+    uint32_t ecc_parameter_b;
+    uint32_t num_threads;
+    uint32_t encoded_data_size;     // 0 if the call failed
+    double optimize_seconds;
+    double encode_seconds;
+    double total_seconds;
+};
 
 // Functions 
 void arc_help();
@@ -35,22 +133,63 @@ int arc_init(uint32_t max_threads);
 int arc_save();
 int arc_close();
 int arc_encode(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_encode_reported(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size, struct arc_encode_report* report);
+int arc_encodev(const struct iovec* data_parts, int part_count, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_encode_batch(uint8_t** data, uint32_t* data_sizes, uint32_t batch_count, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_offsets, uint32_t* encoded_data_size);
+int arc_encode_parts(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, struct iovec* encoded_parts, uint8_t** check_data);
 int arc_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** decoded_data, uint32_t* decoded_data_size);
-int arc_check(uint8_t* encoded_data, uint32_t encoded_data_size);
+int arc_decode_zero_copy(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** decoded_data, uint32_t* decoded_data_size, int* decoded_data_owned);
+struct arc_ticket* arc_encode_async(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, arc_callback callback, void* user_data);
+struct arc_ticket* arc_decode_async(uint8_t* encoded_data, uint32_t encoded_data_size, arc_callback callback, void* user_data);
+int arc_poll(struct arc_ticket* ticket);
+int arc_wait(struct arc_ticket* ticket, uint8_t** result_data, uint32_t* result_data_size);
+int arc_pipeline(uint32_t slab_count, uint32_t queue_depth, arc_pipeline_compress_fn compress, arc_pipeline_write_fn write, void* user_data, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count);
+int arc_decode_range(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t offset, uint32_t length, uint8_t* decoded_data);
+int arc_decode_salvage(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** decoded_data, uint32_t* decoded_data_size, uint8_t** error_bitmap, uint32_t* block_count, uint32_t* error_blocks, int stop_early);
+int arc_block_range(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t block, uint32_t* offset, uint32_t* length);
+int arc_check(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t* clean_blocks, uint32_t* correctable_blocks, uint32_t* uncorrectable_blocks);
+int arc_repair(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t* repaired_blocks, uint32_t* uncorrectable_blocks);
+int arc_update_range(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t offset, const uint8_t* new_data, uint32_t length);
+struct arc_scrubber* arc_scrubber_create(double bytes_per_second, double pass_interval, int repair, arc_scrub_callback callback, void* user_data);
+int arc_scrubber_register(struct arc_scrubber* scrubber, uint8_t* encoded_data, uint32_t encoded_data_size);
+int arc_scrubber_unregister(struct arc_scrubber* scrubber, uint8_t* encoded_data);
+int arc_scrubber_destroy(struct arc_scrubber* scrubber);
+int arc_get_stats(struct arc_stats* stats);
+void arc_reset_stats();
+int arc_trace_start(const char* path);
+int arc_trace_dump(const char* path);
+int arc_trace_stop();
+int arc_capture_start(const char* path);
+int arc_capture_stop();
+FILE* arc_capture_open(const char* path);
+int arc_capture_read(FILE* fp, struct arc_capture_record* record);
+int arc_configuration_estimate(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t num_threads, double* throughput_overhead, double* throughput_variance, uint32_t* sample_count);
+double arc_roofline_bandwidth(uint32_t threads);
+double arc_roofline_fraction(uint64_t bytes_in, uint64_t bytes_out, double seconds, uint32_t threads);
 int arc_memory_optimizer(double memory_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* memory_choice_parameter_a, uint32_t* memory_choice_parameter_b);
 int arc_throughput_optimizer(double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* throughput_choice_parameter_a, uint32_t* throughput_choice_parameter_b, uint32_t* num_threads);
 int arc_joint_optimizer(double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* optimizer_parameter_a, uint32_t* optimizer_parameter_b, uint32_t* num_threads);
 uint8_t arc_calculate_parity_uint64 (uint64_t byte);
 uint8_t arc_calculate_parity_uint8 (uint8_t byte);
 int arc_parity_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_parity_encodev(const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
 int arc_parity_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t* data_size);
 uint8_t arc_calculate_hamming_uint64 (uint64_t byte);
 uint8_t arc_calculate_hamming_uint8 (uint8_t byte);
 int arc_hamming_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_hamming_encodev(const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
 int arc_hamming_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t* data_size);
 uint8_t arc_calculate_secded_uint64 (uint64_t byte);
 uint8_t arc_calculate_secded_uint8 (uint8_t byte);
 int arc_secded_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_secded_encodev(const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
 int arc_secded_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t* data_size);
 int arc_reed_solomon_encode(uint8_t* data, uint32_t data_size, uint32_t data_devices, uint32_t code_devices, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
-int arc_reed_solomon_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t *data_size);
\ No newline at end of file
+int arc_reed_solomon_encodev(const struct iovec* data_parts, int part_count, uint32_t data_devices, uint32_t code_devices, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_reed_solomon_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t *data_size);
+int arc_packed_encode(int ecc_method, uint8_t* data, uint32_t data_size, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
+int arc_packed_encodev(int ecc_method, const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,173 @@
+// ARC libpressio meta-compressor plugin
+// Registers an "arc" compressor that runs any child compressor and protects its output with ARC.
+// Compressed bytes are handed straight to arc_encode and ARC's output buffer is moved into the
+// pressio_data result. On decompression a clean split layout stream (ARC_SPLIT_LAYOUT) is handed to
+// the child compressor in place, and only a stream that needs correcting is copied by ARC.
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <time.h>
+#include <omp.h>
+
+// Libpressio Libraries
+#include "libpressio_ext/cpp/compressor.h"
+#include "libpressio_ext/cpp/data.h"
+#include "libpressio_ext/cpp/options.h"
+#include "libpressio_ext/cpp/pressio.h"
+#include "pressio_compressor.h"
+#include "std_compat/memory.h"
+
+// ARC Libraries
+#include "arc.h"
+
+class arc_meta_compressor_plugin: public libpressio_compressor_plugin {
+public:
+  struct pressio_options get_options_impl() const override {
+    struct pressio_options options;
+    set_meta(options, "arc:compressor", compressor_id, compressor);
+    set(options, "arc:memory_constraint", memory_constraint);
+    set(options, "arc:throughput_constraint", throughput_constraint);
+    set(options, "arc:resiliency_constraint", pressio_data(resiliency_constraint.begin(), resiliency_constraint.end()));
+    set(options, "arc:threads", threads);
+    return options;
+  }
+
+  struct pressio_options get_configuration_impl() const override {
+    struct pressio_options options;
+    // ARC keeps its trained configuration table in global state
+    set(options, "pressio:thread_safe", static_cast<int32_t>(pressio_thread_safety_single));
+    set(options, "pressio:stability", "experimental");
+    return options;
+  }
+
+  struct pressio_options get_documentation_impl() const override {
+    struct pressio_options options;
+    set_meta_docs(options, "arc:compressor", "compressor whose output ARC protects", compressor);
+    set(options, "pressio:description", "protects the output of another compressor with ARC's automatically selected error-correcting codes");
+    set(options, "arc:memory_constraint", "maximum memory overhead ARC may introduce, or ARC_ANY_SIZE (-1) for no limit");
+    set(options, "arc:throughput_constraint", "minimum encoding bandwidth in MB/s ARC must keep, or ARC_ANY_BW (-1) for no limit");
+    set(options, "arc:resiliency_constraint", "list of ECC methods to choose from / number of errors predicted to occur per MB of data");
+    set(options, "arc:threads", "maximum number of threads ARC is initialized with (0 uses omp_get_max_threads)");
+    set(options, "arc:encoded_size", "size in bytes of the last ARC encoded stream");
+    set(options, "arc:encode_time", "seconds spent in arc_encode during the last compression");
+    set(options, "arc:decode_time", "seconds spent in arc_decode during the last decompression");
+    return options;
+  }
+
+  int set_options_impl(struct pressio_options const& options) override {
+    get_meta(options, "arc:compressor", compressor_plugins(), compressor_id, compressor);
+    get(options, "arc:memory_constraint", &memory_constraint);
+    get(options, "arc:throughput_constraint", &throughput_constraint);
+    pressio_data tmp;
+    if (get(options, "arc:resiliency_constraint", &tmp) == pressio_options_key_set) {
+      resiliency_constraint = tmp.to_vector<int32_t>();
+    }
+    get(options, "arc:threads", &threads);
+    return 0;
+  }
+
+  int compress_impl(const pressio_data* input, struct pressio_data* output) override {
+    if (init() == 0) {
+      return set_error(1, "unable to initialize ARC");
+    }
+    // Compress with the child compressor
+    pressio_data compressed = pressio_data::empty(pressio_byte_dtype, {});
+    if (compressor->compress(input, &compressed)) {
+      return set_error(compressor->error_code(), compressor->error_msg());
+    }
+
+    // ARC streams are addressed with 32 bit sizes
+    if (compressed.size_in_bytes() > UINT32_MAX) {
+      return set_error(4, "compressed data is larger than ARC's limit of UINT32_MAX bytes");
+    }
+
+    // Protect the compressed bytes in place and move ARC's buffer into the output
+    uint8_t* encoded_data;
+    uint32_t encoded_data_size;
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int err = arc_encode(static_cast<uint8_t*>(compressed.data()), static_cast<uint32_t>(compressed.size_in_bytes()), memory_constraint,
+        throughput_constraint, resiliency_constraint.data(), static_cast<int>(resiliency_constraint.size()), &encoded_data, &encoded_data_size);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    if (err == 0) {
+      return set_error(2, "ARC was unable to encode the compressed data");
+    }
+    encode_time = (double)(stop.tv_nsec - start.tv_nsec) / 1000000000 + (double)(stop.tv_sec - start.tv_sec);
+    encoded_size = encoded_data_size;
+    *output = pressio_data::move(pressio_byte_dtype, encoded_data, {static_cast<size_t>(encoded_data_size)}, pressio_data_libc_free_fn, nullptr);
+    return 0;
+  }
+
+  int decompress_impl(const pressio_data* input, struct pressio_data* output) override {
+    if (init() == 0) {
+      return set_error(1, "unable to initialize ARC");
+    }
+    if (input->size_in_bytes() > UINT32_MAX) {
+      return set_error(4, "protected data is larger than ARC's limit of UINT32_MAX bytes");
+    }
+
+    // Decode (and correct) the protected stream, viewing the payload in place when no copy was needed
+    uint8_t* decoded_data;
+    uint32_t decoded_data_size;
+    int decoded_data_owned;
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int err = arc_decode_zero_copy(static_cast<uint8_t*>(input->data()), static_cast<uint32_t>(input->size_in_bytes()), &decoded_data, &decoded_data_size,
+        &decoded_data_owned);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    if (err == 0) {
+      return set_error(3, "ARC was unable to decode the protected data");
+    }
+    decode_time = (double)(stop.tv_nsec - start.tv_nsec) / 1000000000 + (double)(stop.tv_sec - start.tv_sec);
+    pressio_data decoded = decoded_data_owned
+        ? pressio_data::move(pressio_byte_dtype, decoded_data, {static_cast<size_t>(decoded_data_size)}, pressio_data_libc_free_fn, nullptr)
+        : pressio_data::nonowning(pressio_byte_dtype, decoded_data, {static_cast<size_t>(decoded_data_size)});
+
+    // Decompress with the child compressor
+    if (compressor->decompress(&decoded, output)) {
+      return set_error(compressor->error_code(), compressor->error_msg());
+    }
+    return 0;
+  }
+
+  pressio_options get_metrics_results_impl() const override {
+    pressio_options results = compressor->get_metrics_results();
+    set(results, "arc:encoded_size", encoded_size);
+    set(results, "arc:encode_time", encode_time);
+    set(results, "arc:decode_time", decode_time);
+    return results;
+  }
+
+  int major_version() const override { return 0; }
+  int minor_version() const override { return 1; }
+  int patch_version() const override { return 0; }
+  const char* version() const override { return "0.1.0"; }
+  const char* prefix() const override { return "arc"; }
+
+  void set_name_impl(std::string const& new_name) override {
+    compressor->set_name(new_name + "/" + compressor->prefix());
+  }
+
+  std::shared_ptr<libpressio_compressor_plugin> clone() override {
+    return compat::make_unique<arc_meta_compressor_plugin>(*this);
+  }
+
+private:
+  // arc_init returns immediately once ARC is initialized
+  int init() {
+    uint32_t max_threads = (threads > 0) ? threads : static_cast<uint32_t>(omp_get_max_threads());
+    return arc_init(max_threads);
+  }
+
+  std::string compressor_id = "noop";
+  pressio_compressor compressor = compressor_plugins().build("noop");
+  double memory_constraint = ARC_ANY_SIZE;
+  double throughput_constraint = ARC_ANY_BW;
+  std::vector<int32_t> resiliency_constraint{ARC_ANY_ECC};
+  uint32_t threads = 0;
+  uint32_t encoded_size = 0;
+  double encode_time = 0.0;
+  double decode_time = 0.0;
+};
+
+static pressio_register compressor_arc_plugin(compressor_plugins(), "arc", [](){ return compat::make_unique<arc_meta_compressor_plugin>(); });
@@ -2,8 +2,19 @@
 #include "arc.h"
 #include "jerasure.h"
 #include "reed_sol.h"
+#include "galois.h"
 // Type Malloc Macro
 #define talloc(type, num) (type *) malloc(sizeof(type)*(num))
+// Tracing Macros
+// Phases are bare identifiers so they can double as USDT probe names (arc:<phase>__begin / arc:<phase>__end)
+#ifdef ARC_USDT
+#include <sys/sdt.h>
+#define ARC_PROBE(phase, edge) DTRACE_PROBE(arc, phase##__##edge)
+#else
+#define ARC_PROBE(phase, edge)
+#endif
+#define ARC_TRACE_BEGIN(phase) do { ARC_PROBE(phase, begin); if (__builtin_expect(ARC_TRACE, 0)) arc_trace_record(#phase, 'B'); } while (0)
+#define ARC_TRACE_END(phase) do { ARC_PROBE(phase, end); if (__builtin_expect(ARC_TRACE, 0)) arc_trace_record(#phase, 'E'); } while (0)
 
 // GLOBAL Variables Section
 // ############################
@@ -37,6 +48,12 @@ int ARC_DET_SPARSE = -5;
 int ARC_COR_SPARSE = -6;
 // Identifier to use ECC capable of correcting burst errors
 int ARC_COR_BURST = -7;
+// Store payloads contiguously followed by a check byte trailer instead of interleaving check bytes
+int ARC_SPLIT_LAYOUT = 0;
+// Version of the header written by encoders (1 writes the legacy header understood by older releases)
+int ARC_FORMAT_VERSION = 2;
+// Store a CRC32C of the original data in the header so clean data streams can skip per block checks
+int ARC_PAYLOAD_CHECKSUM = 0;
 
 // ECC Method Identifier Variables Section
 // ########################################
@@ -45,6 +62,33 @@ int PARITY_ID = 1;
 int HAMMING_ID = 2;
 int SECDED_ID = 3;
 int RS_ID = 4;
+// Set in the method identifier byte of data streams using the split layout
+int SPLIT_LAYOUT_FLAG = 0x10;
+// Set in the method identifier byte of data streams whose check bits are packed into a dense trailer
+int PACKED_LAYOUT_FLAG = 0x20;
+
+// Header Identifier Variables Section
+// ####################################
+// First 4 bytes of every versioned header ("ARCE", never a legacy method identifier byte)
+uint32_t HEADER_MAGIC = 0x41524345;
+// Newest header version this release can read
+int HEADER_VERSION = 2;
+// Size of a versioned header in bytes
+uint32_t ARC_HEADER_LENGTH = 56;
+// Set in the header flags byte when the header holds a CRC32C of the original data
+int HEADER_PAYLOAD_CHECKSUM_FLAG = 0x01;
+// CRC32C (Castagnoli) lookup table used when the processor lacks a crc32 instruction
+uint32_t CRC32C_Table[256];
+pthread_once_t crc32c_table_once = PTHREAD_ONCE_INIT;
+
+// Block Status Identifier Variables Section
+// ##########################################
+// Block passed its check
+int ARC_BLOCK_CLEAN = 0;
+// Block failed its check but can be corrected
+int ARC_BLOCK_CORRECTABLE = 1;
+// Block failed its check and cannot be corrected
+int ARC_BLOCK_UNCORRECTABLE = 2;
 
 // Resource Variables Section
 // ###########################
@@ -72,9 +116,106 @@ struct configuration_information {
     uint32_t num_threads;
     double memory_overhead;
     double throughput_overhead;
+    double throughput_variance;
+    // Number of measurements behind the estimate (0 for configurations interpolated during training)
+    uint32_t sample_count;
 };
 // ARC Configuration Information Decision Array
 struct configuration_information *arc_configurations;
+// Untimed encodes run before each configuration is measured (faults in the output and ramps up the clocks)
+int ARC_TRAIN_WARMUPS = 2;
+// Timed encodes per configuration during training
+int ARC_TRAIN_TRIALS = 7;
+// Trials further than this many standard deviations (estimated by MAD) from the median are discarded
+double ARC_OUTLIER_CUTOFF = 3.0;
+// Weight a new arc_encode measurement carries when folded into its configuration (configurations with fewer than
+// 1 / ARC_UPDATE_WEIGHT samples weigh each one equally instead so they converge quickly)
+double ARC_UPDATE_WEIGHT = 0.125;
+// Share of a measured configuration's relative change passed on to its neighbouring configurations
+double ARC_NEIGHBOR_WEIGHT = 0.5;
+// Standard errors below its mean a configuration's bandwidth must stay above a throughput constraint
+double ARC_CONFIDENCE_Z = 1.0;
+// Exploration Policy Identifier Values
+int ARC_EXPLORE_NONE = 0;
+int ARC_EXPLORE_EPSILON = 1;
+int ARC_EXPLORE_UCB = 2;
+// Exploration policy used by arc_optimize (ARC_EXPLORE_NONE always takes the optimizer's choice)
+int ARC_EXPLORE = 0;
+// Probability the epsilon-greedy policy tries a random candidate instead of the optimizer's choice
+double ARC_EXPLORE_RATE = 0.05;
+// Candidates must have a memory overhead within this fraction of the optimizer's choice
+double ARC_EXPLORE_MARGIN = 0.1;
+// Weight of the upper confidence bound bonus in standard deviations
+double ARC_EXPLORE_UCB_WEIGHT = 1.0;
+// State of the exploration random number generator (advanced under the configuration lock)
+uint64_t arc_explore_state = 0x9E3779B97F4A7C15ULL;
+// Candidate indices gathered by arc_explore (NUM_CONFIGURATIONS entries, allocated by arc_init and guarded by the configuration lock)
+int* arc_explore_candidates = NULL;
+
+// ARC Scheduler Variables Section
+// ################################
+// Set scheduler information cache string
+char *scheduler_resource_file = "scheduler_information_cache.csv";
+// Maximum number of blocks a decoding thread claims at once (tuned during arc_init)
+int SCHEDULE_CHUNK_SIZE = 1024;
+// Candidate chunk sizes evaluated during scheduler training
+uint32_t schedule_chunk_candidates[] = {16, 64, 256, 1024, 4096};
+int num_schedule_chunk_candidates = 5;
+
+// ARC Roofline Variables Section
+// ###############################
+// Set roofline information cache string
+char *roofline_resource_file = "roofline_information_cache.csv";
+// Bytes in each array streamed by the bandwidth probe (large enough to spill out of the last level cache)
+uint64_t ARC_ROOFLINE_BYTES = 64 << 20;
+// Fraction of copy bandwidth at which a configuration is treated as memory-bound (0 disables thread capping)
+double ARC_ROOFLINE_BOUND = 0.8;
+// Read and copy bandwidth in MB/s indexed by thread count (entry 0 unused, NULL until probed)
+double* arc_roofline_read = NULL;
+double* arc_roofline_copy = NULL;
+// Receives the probe checksums so the compiler cannot discard the streamed reads
+volatile uint64_t arc_roofline_sink = 0;
+
+// ARC Asynchronous Variables Section
+// ###################################
+// Number of worker threads servicing asynchronous requests
+int ARC_ASYNC_THREADS = 2;
+// Guards configuration updates made by concurrent encoders
+pthread_mutex_t configuration_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// ARC Tracing Variables Section
+// ##############################
+// Records phase begin/end events when set (enabled by the ARC_TRACE environment variable or arc_trace_start)
+int ARC_TRACE = 0;
+// ARC Trace Event Struct
+// A single begin or end event stored in the trace ring buffer
+struct arc_trace_event {
+    const char* name;
+    double timestamp;
+    uint32_t thread;
+    char phase;
+    // Index + 1 of the event held by this slot, published last so readers can skip slots still being written
+    uint64_t sequence;
+};
+// Ring buffer of the most recent trace events (older events are overwritten once it is full)
+struct arc_trace_event* arc_trace_events = NULL;
+uint32_t ARC_TRACE_CAPACITY = 65536;
+uint64_t arc_trace_head = 0;
+double arc_trace_origin = 0;
+// File the trace is written to by arc_trace_stop (NULL writes arc_trace.json)
+char* arc_trace_path = NULL;
+// Kernel thread id of the calling thread, looked up on its first event
+__thread uint32_t arc_trace_thread = 0;
+
+// ARC Capture Variables Section
+// ##############################
+// File arc_encode calls are logged to while a capture is running (NULL when not capturing)
+FILE* arc_capture_file = NULL;
+double arc_capture_origin = 0;
+// Serializes record writes from concurrent encoders
+pthread_mutex_t capture_lock = PTHREAD_MUTEX_INITIALIZER;
+// Identifies capture files and their record layout
+const char ARC_CAPTURE_MAGIC[8] = {'A', 'R', 'C', 'C', 'A', 'P', 'T', '1'};
 
 // Utility Functions Section
 // ############################
@@ -122,361 +263,3917 @@ int starts_with(const char *a, const char *b) {
    return 0;
 }
 
+// arc_monotonic_seconds:
+// Reads the monotonic clock
+// return:
+// seconds      -   seconds since an arbitrary fixed point
+double arc_monotonic_seconds(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1E9);
+}
 
+// arc_trace_record:
+// Appends a begin or end event to the trace ring buffer without taking any locks
+// params:
+// name     -   name of the phase
+// phase    -   'B' for begin or 'E' for end
+void arc_trace_record(const char* name, char phase){
+    struct arc_trace_event* events = __atomic_load_n(&arc_trace_events, __ATOMIC_ACQUIRE);
+    if (events == NULL){
+        return;
+    }
+    if (arc_trace_thread == 0){
+        arc_trace_thread = (uint32_t)syscall(SYS_gettid);
+    }
+    uint64_t index = __atomic_fetch_add(&arc_trace_head, 1, __ATOMIC_RELAXED);
+    struct arc_trace_event* event = &events[index % ARC_TRACE_CAPACITY];
+    __atomic_store_n(&event->sequence, 0, __ATOMIC_RELAXED);
+    event->name = name;
+    event->timestamp = arc_monotonic_seconds();
+    event->thread = arc_trace_thread;
+    event->phase = phase;
+    __atomic_store_n(&event->sequence, index + 1, __ATOMIC_RELEASE);
+}
 
-// ARC Utility Section
-// ###################
-// arc_help:
-// Prints usage information out for the user
-void arc_help(){
-    printf("ARC Help not supported at this time...\n");
-    return;
+// arc_trace_start:
+// Starts recording phase events into the trace ring buffer
+// params:
+// path     -   file arc_trace_stop writes the trace to (NULL writes arc_trace.json)
+// return:
+// err      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_trace_start(const char* path){
+    if (arc_trace_events == NULL){
+        struct arc_trace_event* events = (struct arc_trace_event*)calloc(ARC_TRACE_CAPACITY, sizeof(struct arc_trace_event));
+        if (events == NULL){
+            printf("TRACE ERROR: Unable to allocate the trace buffer. . .\n");
+            return 0;
+        }
+        arc_trace_head = 0;
+        arc_trace_origin = arc_monotonic_seconds();
+        __atomic_store_n(&arc_trace_events, events, __ATOMIC_RELEASE);
+    }
+    free(arc_trace_path);
+    arc_trace_path = (path != NULL) ? strdup(path) : NULL;
+    ARC_TRACE = 1;
+    return 1;
 }
 
-// arc_resource_init:
-// Loads required resource files for encoding
+// arc_trace_dump:
+// Writes the events currently held in the trace ring buffer as Chrome trace JSON (viewable in chrome://tracing or Perfetto)
+// params:
+// path     -   file to write the trace to (NULL uses the path given to arc_trace_start)
 // return:
-// x        -   Success=1, Failure=0
-int arc_resource_init(){
-    FILE *fp;
-    int i;
-    char * resource_file = "Hamming_SECDED_1_Parity_Matrix";
-    // Setup H_S_1_Parity_Matrix with resources file
-    char * file_location = concat(resource_location, resource_file);
-    fp = fopen(file_location, "r");
-    if(fp == NULL){
-        printf("Error opening res/Hamming_SECDED_1_Parity_Matrix\n");
+// err      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_trace_dump(const char* path){
+    struct arc_trace_event* events = __atomic_load_n(&arc_trace_events, __ATOMIC_ACQUIRE);
+    if (events == NULL){
+        printf("TRACE ERROR: Tracing has not been started. . .\n");
         return 0;
     }
-    uint8_t Parity_1;
-    for (i = 0; i < 4; i++){
-        fscanf(fp, "%hhX", &Parity_1);
-        H_S_1_Parity_Matrix[i] = Parity_1;
+    if (path == NULL){
+        path = (arc_trace_path != NULL) ? arc_trace_path : "arc_trace.json";
     }
-    fclose(fp);
-    free(file_location);
-
-    // Setup H_1_Syndrome_Table with resources file
-    resource_file = "Hamming_1_Syndrome_Table";
-    file_location = concat(resource_location, resource_file);
-    fp = fopen(file_location, "r");
-    if(fp == NULL){
-        printf("Error opening res/Hamming_1_Syndrome_Table\n");
+    FILE* fp = fopen(path, "w");
+    if (fp == NULL){
+        printf("TRACE ERROR: Unable to open %s. . .\n", path);
         return 0;
     }
-    uint8_t Snydrome_1;
-    for (i = 0; i < 16; i++){
-        fscanf(fp, "%hhX", &Snydrome_1);
-        H_1_Syndrome_Table[i] = Snydrome_1;
+
+    // Walk the ring from its oldest surviving event to its newest
+    uint64_t head = __atomic_load_n(&arc_trace_head, __ATOMIC_ACQUIRE);
+    uint64_t first = (head > ARC_TRACE_CAPACITY) ? head - ARC_TRACE_CAPACITY : 0;
+    uint64_t index;
+    int written = 0;
+    int pid = (int)getpid();
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (index = first; index < head; index++){
+        struct arc_trace_event* slot = &events[index % ARC_TRACE_CAPACITY];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != index + 1){
+            continue;
+        }
+        struct arc_trace_event event = *slot;
+        // Skip slots overwritten while they were being copied
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != index + 1){
+            continue;
+        }
+        fprintf(fp, "%s{\"name\":\"%s\",\"cat\":\"arc\",\"ph\":\"%c\",\"ts\":%.3lf,\"pid\":%d,\"tid\":%" PRIu32 "}",
+            (written > 0) ? ",\n" : "", event.name, event.phase, (event.timestamp - arc_trace_origin) * 1E6, pid, event.thread);
+        written++;
     }
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ns\"}\n");
     fclose(fp);
-    free(file_location);
+    return 1;
+}
 
-    // Setup S_1_Syndrome_Table with resources file
-    resource_file = "SECDED_1_Syndrome_Table";
-    file_location = concat(resource_location, resource_file);
-    fp = fopen(file_location, "r");
-    if(fp == NULL){
-        printf("Error opening res/SECDED_1_Syndrome_Table\n");
-        return 0;
-    }
-    for (i = 0; i < 16; i++){
-        fscanf(fp, "%hhX", &Snydrome_1);
-        S_1_Syndrome_Table[i] = Snydrome_1;
+// arc_trace_stop:
+// Stops tracing, writes the trace to the path given to arc_trace_start, and frees the trace buffer
+// return:
+// err      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// No other ARC calls may be in flight when tracing is stopped
+int arc_trace_stop(){
+    if (arc_trace_events == NULL){
+        return 1;
     }
-    fclose(fp);
-    free(file_location);
+    ARC_TRACE = 0;
+    int err = arc_trace_dump(NULL);
+    struct arc_trace_event* events = arc_trace_events;
+    __atomic_store_n(&arc_trace_events, NULL, __ATOMIC_RELEASE);
+    free(events);
+    free(arc_trace_path);
+    arc_trace_path = NULL;
+    return err;
+}
 
-    // Setup H_S_8_Parity_Matrix with resources file
-    resource_file = "Hamming_SECDED_8_Parity_Matrix";
-    file_location = concat(resource_location, resource_file);
-    fp = fopen(file_location, "r");
-    if(fp == NULL){
-        printf("Error opening res/Hamming_SECDED_8_Parity_Matrix\n");
+// arc_capture_start:
+// Starts logging every arc_encode call (size, constraints, chosen plan, and timing) to a compact binary capture file
+// params:
+// path     -   file to write the capture to (replaced if it exists)
+// return:
+// err      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_capture_start(const char* path){
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL){
+        printf("CAPTURE ERROR: Unable to open %s. . .\n", path);
         return 0;
     }
-    uint64_t Parity_8;
-    for (i = 0; i < 7; i++){
-        fscanf(fp, "%"PRIx64, &Parity_8);
-        H_S_8_Parity_Matrix[i] = Parity_8;
+    uint32_t version = 1;
+    fwrite(ARC_CAPTURE_MAGIC, 1, sizeof(ARC_CAPTURE_MAGIC), fp);
+    fwrite(&version, sizeof(version), 1, fp);
+    pthread_mutex_lock(&capture_lock);
+    if (arc_capture_file != NULL){
+        fclose(arc_capture_file);
     }
-    fclose(fp);
-    free(file_location);
+    arc_capture_origin = arc_monotonic_seconds();
+    arc_capture_file = fp;
+    pthread_mutex_unlock(&capture_lock);
+    return 1;
+}
 
-    // Setup H_8_Syndrome_Table with resources file
-    resource_file = "Hamming_8_Syndrome_Table";
-    file_location = concat(resource_location, resource_file);
-    fp = fopen(file_location, "r");
-    if(fp == NULL){
-        printf("Error opening res/Hamming_8_Syndrome_Table\n");
-        return 0;
+// arc_capture_stop:
+// Stops logging arc_encode calls and closes the capture file
+// return:
+// err      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_capture_stop(){
+    pthread_mutex_lock(&capture_lock);
+    int err = 1;
+    if (arc_capture_file != NULL){
+        err = (fclose(arc_capture_file) == 0);
+        arc_capture_file = NULL;
     }
-    uint8_t Snydrome_8;
-    for (i = 0; i < 72; i++){
-        fscanf(fp, "%hhX", &Snydrome_8);
-        H_8_Syndrome_Table[i] = Snydrome_8;
+    pthread_mutex_unlock(&capture_lock);
+    return err;
+}
+
+// arc_capture_write:
+// Appends a single call to the capture file
+// params:
+// record   -   call to log (its timestamp is filled in here)
+// note:
+// Each record is a fixed 76 byte block followed by resiliency_count 4 byte constraint values, all in host byte order
+void arc_capture_write(struct arc_capture_record* record){
+    pthread_mutex_lock(&capture_lock);
+    if (arc_capture_file != NULL){
+        uint8_t fixed[76];
+        uint8_t resiliency_count = (uint8_t)record->resiliency_count;
+        int32_t ecc_algorithm = record->ecc_algorithm;
+        int32_t resiliency_constraint[8];
+        int i;
+        record->timestamp = arc_monotonic_seconds() - arc_capture_origin;
+        memcpy(&fixed[0], &record->timestamp, 8);
+        memcpy(&fixed[8], &record->memory_constraint, 8);
+        memcpy(&fixed[16], &record->throughput_constraint, 8);
+        memcpy(&fixed[24], &record->optimize_seconds, 8);
+        memcpy(&fixed[32], &record->encode_seconds, 8);
+        memcpy(&fixed[40], &record->total_seconds, 8);
+        memcpy(&fixed[48], &record->data_size, 4);
+        memcpy(&fixed[52], &record->encoded_data_size, 4);
+        memcpy(&fixed[56], &ecc_algorithm, 4);
+        memcpy(&fixed[60], &record->ecc_parameter_a, 4);
+        memcpy(&fixed[64], &record->ecc_parameter_b, 4);
+        memcpy(&fixed[68], &record->num_threads, 4);
+        fixed[72] = resiliency_count;
+        fixed[73] = 0;
+        fixed[74] = 0;
+        fixed[75] = 0;
+        for (i = 0; i < resiliency_count; i++){
+            resiliency_constraint[i] = record->resiliency_constraint[i];
+        }
+        fwrite(fixed, 1, sizeof(fixed), arc_capture_file);
+        fwrite(resiliency_constraint, sizeof(int32_t), resiliency_count, arc_capture_file);
     }
-    fclose(fp);
-    free(file_location);
+    pthread_mutex_unlock(&capture_lock);
+}
 
-    // Setup S_8_Syndrome_Table with resources file
-    resource_file = "SECDED_8_Syndrome_Table";
-    file_location = concat(resource_location, resource_file);
-    fp = fopen(file_location, "r");
-    if(fp == NULL){
-        printf("Error opening res/SECDED_8_Syndrome_Table\n");
-        return 0;
+// arc_capture_encode:
+// Logs a single encode call (arc_encode, arc_encodev, arc_encode_batch, or arc_encode_parts) when a capture is running
+// params:
+// data_size                -   size of data stream
+// memory_constraint        -   memory constraint the call was made with
+// throughput_constraint    -   throughput constraint the call was made with
+// resiliency_constraint    -   resiliency constraint list the call was made with (only the first 8 entries are kept)
+// resiliency_count         -   Number of values set in resiliency constraint list
+// ecc_algorithm            -   ECC method chosen (0 if no configuration met the constraints)
+// ecc_parameter_a          -   first ecc method parameter chosen
+// ecc_parameter_b          -   second ecc method parameter chosen
+// num_threads              -   number of threads chosen
+// encoded_data_size        -   size of arc encoded data stream (0 if the call failed)
+// optimize_seconds         -   seconds spent choosing the configuration
+// encode_seconds           -   seconds spent encoding
+// total_seconds            -   seconds spent in the whole call
+void arc_capture_encode(uint32_t data_size, double memory_constraint, double throughput_constraint, int* resiliency_constraint, int resiliency_count, int ecc_algorithm,
+    uint32_t ecc_parameter_a, uint32_t ecc_parameter_b, uint32_t num_threads, uint32_t encoded_data_size, double optimize_seconds, double encode_seconds, double total_seconds){
+    if (__builtin_expect(arc_capture_file == NULL, 1)){
+        return;
     }
-    for (i = 0; i < 72; i++){
-        fscanf(fp, "%hhX", &Snydrome_8);
-        S_8_Syndrome_Table[i] = Snydrome_8;
+    struct arc_capture_record record;
+    int i;
+    memset(&record, 0, sizeof(record));
+    record.data_size = data_size;
+    record.memory_constraint = memory_constraint;
+    record.throughput_constraint = throughput_constraint;
+    record.resiliency_count = (resiliency_count < 8) ? resiliency_count : 8;
+    for (i = 0; i < record.resiliency_count; i++){
+        record.resiliency_constraint[i] = resiliency_constraint[i];
     }
-    fclose(fp);
-    free(file_location);
+    record.ecc_algorithm = ecc_algorithm;
+    record.ecc_parameter_a = ecc_parameter_a;
+    record.ecc_parameter_b = ecc_parameter_b;
+    record.num_threads = num_threads;
+    record.encoded_data_size = encoded_data_size;
+    record.optimize_seconds = optimize_seconds;
+    record.encode_seconds = encode_seconds;
+    record.total_seconds = total_seconds;
+    arc_capture_write(&record);
+}
 
-    // Set INIT to True
-    if(PRINT)
-        printf("ARC Resource Files Initialized\n");
-    INIT = 1;
-    return 1;
+// arc_capture_open:
+// Opens a capture file for reading and checks its header
+// params:
+// path     -   capture file written by arc_capture_start
+// return:
+// fp       -   file positioned at the first record, or NULL if it is not a capture file
+FILE* arc_capture_open(const char* path){
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL){
+        printf("CAPTURE ERROR: Unable to open %s. . .\n", path);
+        return NULL;
+    }
+    char magic[8];
+    uint32_t version;
+    if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic) || memcmp(magic, ARC_CAPTURE_MAGIC, sizeof(magic)) != 0 ||
+        fread(&version, sizeof(version), 1, fp) != 1 || version != 1){
+        printf("CAPTURE ERROR: %s is not an ARC capture file. . .\n", path);
+        fclose(fp);
+        return NULL;
+    }
+    return fp;
 }
 
-// arc_init:
-// Loads resource files and training data. If training data is not available, run training tests
+// arc_capture_read:
+// Reads the next call from a capture file opened with arc_capture_open
 // params:
-// max_threads  -   Maximum number of threads ARC should use
+// fp       -   capture file
+// record   -   address of record to fill
 // return:
-// x            -   Success=1, Failure=0
-int arc_init(uint32_t max_threads){
-    // Load all the required resources files needed for encoding and decoding
-    if(PRINT)
-        printf("Initializing ARC Resource Files\n");
-    int err = arc_resource_init();
-    if(err == 0){
+// err      -   error code to determine if sucessful (1=record read,0=end of file or truncated record)
+int arc_capture_read(FILE* fp, struct arc_capture_record* record){
+    uint8_t fixed[76];
+    int32_t ecc_algorithm;
+    int32_t resiliency_constraint[8];
+    int i;
+    if (fread(fixed, 1, sizeof(fixed), fp) != sizeof(fixed) || fixed[72] > 8){
+        return 0;
+    }
+    memset(record, 0, sizeof(struct arc_capture_record));
+    memcpy(&record->timestamp, &fixed[0], 8);
+    memcpy(&record->memory_constraint, &fixed[8], 8);
+    memcpy(&record->throughput_constraint, &fixed[16], 8);
+    memcpy(&record->optimize_seconds, &fixed[24], 8);
+    memcpy(&record->encode_seconds, &fixed[32], 8);
+    memcpy(&record->total_seconds, &fixed[40], 8);
+    memcpy(&record->data_size, &fixed[48], 4);
+    memcpy(&record->encoded_data_size, &fixed[52], 4);
+    memcpy(&ecc_algorithm, &fixed[56], 4);
+    memcpy(&record->ecc_parameter_a, &fixed[60], 4);
+    memcpy(&record->ecc_parameter_b, &fixed[64], 4);
+    memcpy(&record->num_threads, &fixed[68], 4);
+    record->ecc_algorithm = ecc_algorithm;
+    record->resiliency_count = fixed[72];
+    if (fread(resiliency_constraint, sizeof(int32_t), record->resiliency_count, fp) != (size_t)record->resiliency_count){
         return 0;
     }
+    for (i = 0; i < record->resiliency_count; i++){
+        record->resiliency_constraint[i] = resiliency_constraint[i];
+    }
+    return 1;
+}
 
-    // Turn off print outs
-    PRINT = 0;
+// ARC Statistics Counters Struct
+// Library-wide counters updated with relaxed atomics (times are kept in nanoseconds so they can be added atomically)
+struct arc_stats_counters {
+    uint64_t encode_calls;
+    uint64_t decode_calls;
+    uint64_t bytes_protected;
+    uint64_t bytes_decoded;
+    uint64_t blocks_corrected;
+    uint64_t blocks_uncorrectable;
+    uint64_t encode_nanoseconds[5];
+    uint64_t decode_nanoseconds[5];
+    uint64_t explorations;
+};
+struct arc_stats_counters arc_stats_counters;
 
-    // Initialize Resources for Later Use
-    FILE *fp;
-    uint32_t i, j, k;
-    // Set up training variables
-    struct timeval total_start, total_stop;
-    struct timeval method_start, method_stop;
-    struct timeval start, stop;
-    uint8_t *encoded;
-    uint32_t encoded_size;
-    double encode_time_taken;
-    double memory_overhead;
-    double throughput_overhead;
-    // Set up simulated data set to train with
-    uint32_t data_size = 100000;
-    uint8_t *data = malloc(sizeof(uint8_t)*data_size);
-    srand(0);
-    for (i = 0; i < data_size; i++){
-        data[i] = (uint8_t)(rand() % 255);
+// arc_stats_record_encode:
+// Adds a finished encoding to the library-wide statistics
+// params:
+// ecc_algorithm    -   identifier of the ecc method used
+// data_size        -   number of data bytes protected
+// seconds          -   time spent encoding
+void arc_stats_record_encode(int ecc_algorithm, uint64_t data_size, double seconds){
+    __atomic_fetch_add(&arc_stats_counters.encode_calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&arc_stats_counters.bytes_protected, data_size, __ATOMIC_RELAXED);
+    if (ecc_algorithm >= 1 && ecc_algorithm <= 4 && seconds > 0){
+        __atomic_fetch_add(&arc_stats_counters.encode_nanoseconds[ecc_algorithm], (uint64_t)(seconds * 1E9), __ATOMIC_RELAXED);
     }
+}
 
-    // Check for valid max_threads
-    if (max_threads == ARC_ANY_THREADS || max_threads >= omp_get_max_threads()){
-        AVAIL_THREADS = omp_get_max_threads();
-    } else if (max_threads <= 0 && max_threads != ARC_ANY_THREADS){
-        AVAIL_THREADS = 1;
-    } else {
-        AVAIL_THREADS = max_threads;
+// arc_stats_record_decode:
+// Adds a finished decoding to the library-wide statistics
+// params:
+// ecc_algorithm    -   identifier of the ecc method used
+// data_size        -   number of data bytes decoded
+// seconds          -   time spent decoding
+void arc_stats_record_decode(int ecc_algorithm, uint64_t data_size, double seconds){
+    __atomic_fetch_add(&arc_stats_counters.decode_calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&arc_stats_counters.bytes_decoded, data_size, __ATOMIC_RELAXED);
+    if (ecc_algorithm >= 1 && ecc_algorithm <= 4 && seconds > 0){
+        __atomic_fetch_add(&arc_stats_counters.decode_nanoseconds[ecc_algorithm], (uint64_t)(seconds * 1E9), __ATOMIC_RELAXED);
     }
+}
 
-    // Calculate number of configurations per num_threads
-    int elements_per_num_threads = 2 + 2 + 128 + 128; // 2 SECDED, 2 Hamming, 128 RS, & 128 Parity Configs
-    NUM_CONFIGURATIONS = AVAIL_THREADS * elements_per_num_threads;
-    // Initialize arc_configurations array with enough space for each configuration
-    arc_configurations = malloc(NUM_CONFIGURATIONS * sizeof(*arc_configurations));
-    int current_config_array_index = 0;
+// arc_stats_record_block:
+// Counts a block that needed correcting or could not be corrected
+// params:
+// status           -   ARC_BLOCK_CORRECTABLE or ARC_BLOCK_UNCORRECTABLE (clean blocks are ignored)
+void arc_stats_record_block(int status){
+    if (status == ARC_BLOCK_CORRECTABLE){
+        __atomic_fetch_add(&arc_stats_counters.blocks_corrected, 1, __ATOMIC_RELAXED);
+    } else if (status == ARC_BLOCK_UNCORRECTABLE){
+        __atomic_fetch_add(&arc_stats_counters.blocks_uncorrectable, 1, __ATOMIC_RELAXED);
+    }
+}
 
-    // For threads 1 to max_threads, check to see if we have the training data for these already
-    if(PRINT)
-        printf("ARC Training and Loading Process Started\n");
-    gettimeofday(&total_start, NULL);
-    for(i = 1; i <= AVAIL_THREADS; i++){
-        // Check resource folder for corresponding num_threads information cache
-        char num_thread_string[8];
-        sprintf(num_thread_string, "%d", i);
-        char * thread_file_name = concat(num_thread_string, thread_resource_file);
-        char * thread_file_location = concat(cache_resource_location, thread_file_name);
-        fp = fopen(thread_file_location, "r");
+// arc_get_stats:
+// Reads the library-wide statistics collected since ARC was loaded (or since arc_reset_stats)
+// params:
+// stats        -   address of statistics to fill
+// return:
+// err          -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_get_stats(struct arc_stats* stats){
+    int i;
+    if (stats == NULL){
+        printf("INVALID STATISTICS: Please provide somewhere to store the statistics. . .\n");
+        return 0;
+    }
+    stats->encode_calls = __atomic_load_n(&arc_stats_counters.encode_calls, __ATOMIC_RELAXED);
+    stats->decode_calls = __atomic_load_n(&arc_stats_counters.decode_calls, __ATOMIC_RELAXED);
+    stats->bytes_protected = __atomic_load_n(&arc_stats_counters.bytes_protected, __ATOMIC_RELAXED);
+    stats->bytes_decoded = __atomic_load_n(&arc_stats_counters.bytes_decoded, __ATOMIC_RELAXED);
+    stats->blocks_corrected = __atomic_load_n(&arc_stats_counters.blocks_corrected, __ATOMIC_RELAXED);
+    stats->blocks_uncorrectable = __atomic_load_n(&arc_stats_counters.blocks_uncorrectable, __ATOMIC_RELAXED);
+    for (i = 0; i < 5; i++){
+        stats->encode_seconds[i] = (double)__atomic_load_n(&arc_stats_counters.encode_nanoseconds[i], __ATOMIC_RELAXED) / 1E9;
+        stats->decode_seconds[i] = (double)__atomic_load_n(&arc_stats_counters.decode_nanoseconds[i], __ATOMIC_RELAXED) / 1E9;
+    }
+    stats->explorations = __atomic_load_n(&arc_stats_counters.explorations, __ATOMIC_RELAXED);
+    return 1;
+}
 
-        if(PRINT)
-            printf("\n%d Thread(s) Training and Loading Started...\n", i);
-        // If the file does not exist,
-        if(fp == NULL){
+// arc_reset_stats:
+// Sets every library-wide statistic back to zero
+void arc_reset_stats(){
+    int i;
+    __atomic_store_n(&arc_stats_counters.encode_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&arc_stats_counters.decode_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&arc_stats_counters.bytes_protected, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&arc_stats_counters.bytes_decoded, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&arc_stats_counters.blocks_corrected, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&arc_stats_counters.blocks_uncorrectable, 0, __ATOMIC_RELAXED);
+    for (i = 0; i < 5; i++){
+        __atomic_store_n(&arc_stats_counters.encode_nanoseconds[i], 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&arc_stats_counters.decode_nanoseconds[i], 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&arc_stats_counters.explorations, 0, __ATOMIC_RELAXED);
+}
 
-            // Open a write pointer
-            fp = fopen(thread_file_location, "w");
-            fprintf(fp, "ecc_algorithm,ecc_parameter_a,ecc_parameter_b,num_threads,memory_overhead,throughput_overhead\n");
+// arc_schedule_chunk:
+// Determines how many blocks a thread claims at once from the shared decode work queue
+// params:
+// block_count  -   total number of blocks to be processed
+// threads      -   number of OpenMP threads splitting the work
+// return:
+// chunk_size   -   number of blocks per dynamically scheduled chunk
+int arc_schedule_chunk(uint32_t block_count, uint32_t threads){
+    if (threads < 1){
+        threads = 1;
+    }
+    // Keep several chunks per thread so threads hitting repair heavy regions can be balanced out
+    uint32_t balanced_chunk = block_count / (threads * 4);
+    if (balanced_chunk < 1){
+        balanced_chunk = 1;
+    }
+    if (SCHEDULE_CHUNK_SIZE > 0 && balanced_chunk > (uint32_t)SCHEDULE_CHUNK_SIZE){
+        return SCHEDULE_CHUNK_SIZE;
+    }
+    return (int)balanced_chunk;
+}
 
-            // Run training tests to populate both the arc_configurations array and file
-            for(j = 1; j <= NUM_METHODS; j++){
-                // Parity Training
-                if(j == PARITY_ID){
-                    // Start Training
-                    if(PRINT)
-                        printf("Parity Training Started...\n");
-                    gettimeofday(&method_start, NULL);
 
-                    // Train 1 parity bits over 1 byte to 128 bytes of data
-                    for(k = 1; k <= 128; k++){
-                        // Time the encoding process
-                        gettimeofday(&start, NULL);
-                        err = arc_parity_encode(data, data_size, k, i, &encoded, &encoded_size);
-                        gettimeofday(&stop, NULL);
-                        encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-                        // Calculate Overhead Factors
-                        memory_overhead = ((double)encoded_size / (double)data_size) - 1;
-                        throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-                        // Add this information to configuration_information struct array
-                        arc_configurations[current_config_array_index].ecc_algorithm = j;
-                        arc_configurations[current_config_array_index].ecc_parameter_a = (uint32_t)k;
-                        arc_configurations[current_config_array_index].ecc_parameter_b = (uint32_t)0;
-                        arc_configurations[current_config_array_index].num_threads = (uint32_t)i;
-                        arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                        arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                        // Write these results out to corresponding thread training file
-                        fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, k, 0, i, memory_overhead, throughput_overhead);
-                        fflush(fp);
-                        // Increment current config array index
-                        current_config_array_index++;
-                        // Free encoded data
-                        free(encoded);
-                    }
 
-                    // End Training
-                    gettimeofday(&method_stop, NULL);
-                    double method_time_taken = (double)(method_stop.tv_usec - method_start.tv_usec) / 1000000 + (double)(method_stop.tv_sec - method_start.tv_sec);
-                    if(PRINT)
-                        printf("Parity Training Completed in %lf Seconds!\n", method_time_taken);
-                // Hamming Training 
-                } else if(j == HAMMING_ID){  
-                    // Start Training
-                    if(PRINT)
-                        printf("Hamming Training Started...\n");
-                    gettimeofday(&method_start, NULL);
-
-                    // Train hamming over 1 byte of data
-                    uint32_t hamming_block_size = 1;
-                    gettimeofday(&start, NULL);
-                    err = arc_hamming_encode(data, data_size, hamming_block_size, i, &encoded, &encoded_size);
-                    gettimeofday(&stop, NULL);
-                    encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-                    // Calculate Overhead Factors
-                    memory_overhead = ((double)encoded_size / (double)data_size) - 1;
-                    throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-                    // Add this information to configuration_information struct array
-                    arc_configurations[current_config_array_index].ecc_algorithm = j;
-                    arc_configurations[current_config_array_index].ecc_parameter_a = hamming_block_size;
-                    arc_configurations[current_config_array_index].ecc_parameter_b = 0;
-                    arc_configurations[current_config_array_index].num_threads = i;
-                    arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                    arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                    // Write these results out to corresponding thread training file
-                    fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, hamming_block_size, 0, i, memory_overhead, throughput_overhead);
-                    fflush(fp);
-                    // Increment current config array index
-                    current_config_array_index++;
-                    // Free encoded data
-                    free(encoded);
-
-                    // Train hamming over 8 bytes of data
-                    hamming_block_size = 8;
-                    gettimeofday(&start, NULL);
-                    err = arc_hamming_encode(data, data_size, hamming_block_size, i, &encoded, &encoded_size);
-                    gettimeofday(&stop, NULL);
-                    encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-                    // Calculate Overhead Factors
-                    memory_overhead = ((double)encoded_size / (double)data_size) - 1;
-                    throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-                    // Add this information to configuration_information struct array
-                    arc_configurations[current_config_array_index].ecc_algorithm = j;
-                    arc_configurations[current_config_array_index].ecc_parameter_a = hamming_block_size;
-                    arc_configurations[current_config_array_index].ecc_parameter_b = 0;
-                    arc_configurations[current_config_array_index].num_threads = i;
-                    arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                    arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                    // Write these results out to corresponding thread training file
-                    fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, hamming_block_size, 0, i, memory_overhead, throughput_overhead);
-                    fflush(fp);
-                    // Increment current config array index
-                    current_config_array_index++;
-                    // Free encoded data
-                    free(encoded);
+// ARC Layout Section
+// ###################
+// ARC Encoded Layout Struct
+// Describes where each protected block of an encoded data stream lives
+struct arc_layout {
+    int ecc_algorithm;
+    uint32_t ecc_parameter_a;
+    uint32_t ecc_parameter_b;
+    uint32_t threads;
+    uint32_t data_size;
+    uint32_t encoded_size;
+    uint32_t metadata_length;
+    // Number of full sized blocks (Hamming/SECDED) or total blocks (Parity/RS)
+    uint32_t block_count;
+    // Size of the final partial block (Parity), number of single byte blocks (Hamming/SECDED),
+    // or number of data devices in the final block (RS)
+    uint32_t remainder;
+    // Number of bytes held in the final data long (RS only)
+    uint32_t remainder_long_in_data;
+    // Total number of blocks that must be processed
+    uint32_t total_blocks;
+    // Whether the payload is stored contiguously followed by a check byte trailer
+    int split;
+    // Whether the payload is held outside of the encoded buffer (split layout only)
+    int external_payload;
+    // Offset of the check byte trailer (split layout only)
+    uint32_t trailer_index;
+    // Whether each block's check bits are packed back to back into the trailer (implies split)
+    int packed;
+    // Number of check bits stored per block (8 unless packed)
+    uint32_t check_bits;
+    // Header version (1 for the legacy header)
+    int version;
+    // Whether the header holds a CRC32C of the original data (versioned header only)
+    int payload_checksum_present;
+    // CRC32C of the original data
+    uint32_t payload_checksum;
+};
 
-                    // End Training 
-                    gettimeofday(&method_stop, NULL);
-                    double method_time_taken = (double)(method_stop.tv_usec - method_start.tv_usec) / 1000000 + (double)(method_stop.tv_sec - method_start.tv_sec);
-                    if(PRINT)
-                        printf("Hamming Training Completed in %lf Seconds!\n", method_time_taken);
+// arc_write_uint32:
+// Stores a 32 bit value in 4 big-endian bytes
+// params:
+// location     -   address of the first byte to write
+// value        -   value to store
+void arc_write_uint32(uint8_t* location, uint32_t value){
+    location[0] = (uint8_t)((value & 0xFF000000) >> 24);
+    location[1] = (uint8_t)((value & 0x00FF0000) >> 16);
+    location[2] = (uint8_t)((value & 0x0000FF00) >> 8);
+    location[3] = (uint8_t)((value & 0x000000FF));
+}
 
-                // SECDED Training
-                } else if(j == SECDED_ID){
+// arc_read_uint32:
+// Loads a 32 bit value from 4 big-endian bytes
+// params:
+// location     -   address of the first byte to read
+// return:
+// value        -   loaded value
+uint32_t arc_read_uint32(const uint8_t* location){
+    return (((uint32_t)location[0] & 0x000000FF) << 24) | (((uint32_t)location[1] & 0x000000FF) << 16) | \
+    (((uint32_t)location[2] & 0x000000FF) << 8) | (((uint32_t)location[3] & 0x000000FF));
+}
+
+// arc_load_uint64:
+// Loads 8 bytes of data as a big-endian 64 bit value
+// params:
+// location     -   address of the first byte to read
+// return:
+// value        -   loaded value
+uint64_t arc_load_uint64(const uint8_t* location){
+    uint64_t value;
+    memcpy(&value, location, 8);
+    return __builtin_bswap64(value);
+}
+
+// arc_store_uint64:
+// Stores a 64 bit value as 8 big-endian bytes
+// params:
+// location     -   address of the first byte to write
+// value        -   value to store
+void arc_store_uint64(uint8_t* location, uint64_t value){
+    value = __builtin_bswap64(value);
+    memcpy(location, &value, 8);
+}
+
+// arc_crc32c_table_create:
+// Fills the CRC32C lookup table for the reflected Castagnoli polynomial
+void arc_crc32c_table_create(){
+    uint32_t i, j;
+    for (i = 0; i < 256; i++){
+        uint32_t crc = i;
+        for (j = 0; j < 8; j++){
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+        }
+        CRC32C_Table[i] = crc;
+    }
+}
+
+#if defined(__x86_64__)
+// arc_crc32c_sse42:
+// Continues a CRC32C over a run of bytes with the SSE4.2 crc32 instruction
+// params:
+// crc          -   running CRC32C state
+// data         -   address of the first byte
+// length       -   number of bytes to cover
+// return:
+// crc          -   updated CRC32C state
+__attribute__((target("sse4.2")))
+uint32_t arc_crc32c_sse42(uint32_t crc, const uint8_t* data, size_t length){
+    uint64_t crc64 = crc;
+    uint64_t word;
+    for (; length >= 8; length -= 8, data += 8){
+        memcpy(&word, data, 8);
+        crc64 = __builtin_ia32_crc32di(crc64, word);
+    }
+    crc = (uint32_t)crc64;
+    for (; length > 0; length--, data++){
+        crc = __builtin_ia32_crc32qi(crc, *data);
+    }
+    return crc;
+}
+#endif
+
+// arc_crc32c_update:
+// Continues a CRC32C over a run of bytes, using the crc32 instruction whenever the processor has one
+// params:
+// crc          -   running CRC32C state (0xFFFFFFFF to start)
+// data         -   address of the first byte
+// length       -   number of bytes to cover
+// return:
+// crc          -   updated CRC32C state (invert once every byte has been covered)
+uint32_t arc_crc32c_update(uint32_t crc, const uint8_t* data, size_t length){
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("sse4.2")){
+        return arc_crc32c_sse42(crc, data, length);
+    }
+#endif
+    pthread_once(&crc32c_table_once, arc_crc32c_table_create);
+    for (; length > 0; length--, data++){
+        crc = CRC32C_Table[(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+// arc_crc32c:
+// Calculates the CRC32C of a run of bytes
+// params:
+// data         -   address of the first byte
+// length       -   number of bytes to cover
+// return:
+// crc          -   CRC32C of the bytes
+uint32_t arc_crc32c(const uint8_t* data, size_t length){
+    return ~arc_crc32c_update(0xFFFFFFFF, data, length);
+}
+
+// arc_gf2_matrix_times:
+// Multiplies a 32x32 GF(2) matrix by a 32 bit vector
+// params:
+// matrix       -   matrix columns
+// vector       -   vector to multiply
+// return:
+// product      -   matrix times vector
+uint32_t arc_gf2_matrix_times(const uint32_t* matrix, uint32_t vector){
+    uint32_t product = 0;
+    for (; vector != 0; vector >>= 1, matrix++){
+        if (vector & 1){
+            product ^= *matrix;
+        }
+    }
+    return product;
+}
+
+// arc_gf2_matrix_square:
+// Squares a 32x32 GF(2) matrix
+// params:
+// square       -   address to store the 32 columns of the squared matrix
+// matrix       -   matrix columns
+void arc_gf2_matrix_square(uint32_t* square, const uint32_t* matrix){
+    int n;
+    for (n = 0; n < 32; n++){
+        square[n] = arc_gf2_matrix_times(matrix, matrix[n]);
+    }
+}
+
+// arc_crc32c_shift:
+// Advances a CRC32C state as if length zero bytes followed, in O(log length) time
+// params:
+// crc          -   CRC32C state
+// length       -   number of zero bytes to append
+// return:
+// crc          -   advanced CRC32C state
+// note:
+// Since the CRC is linear, changing bytes of a message changes its CRC by the CRC (started from 0) of the
+// changed bits shifted past the bytes that follow them, which lets checksums be patched without a full pass
+uint32_t arc_crc32c_shift(uint32_t crc, uint64_t length){
+    uint32_t even[32];
+    uint32_t odd[32];
+    uint32_t row = 1;
+    int n;
+    if (length == 0){
+        return crc;
+    }
+    // Operator for a single zero bit
+    odd[0] = 0x82F63B78;
+    for (n = 1; n < 32; n++){
+        odd[n] = row;
+        row <<= 1;
+    }
+    // Operators for two and then four zero bits
+    arc_gf2_matrix_square(even, odd);
+    arc_gf2_matrix_square(odd, even);
+    // Apply the operator for each set bit of length, starting from one zero byte
+    do {
+        arc_gf2_matrix_square(even, odd);
+        if (length & 1){
+            crc = arc_gf2_matrix_times(even, crc);
+        }
+        length >>= 1;
+        if (length == 0){
+            break;
+        }
+        arc_gf2_matrix_square(odd, even);
+        if (length & 1){
+            crc = arc_gf2_matrix_times(odd, crc);
+        }
+        length >>= 1;
+    } while (length != 0);
+    return crc;
+}
+
+// arc_fast_parity:
+// Calculates the single parity bit over any number of bytes using 8 byte words
+// params:
+// data         -   address of the first byte
+// length       -   number of bytes to cover
+// return:
+// parity       -   parity bit over all bytes
+uint8_t arc_fast_parity(const uint8_t* data, uint32_t length){
+    uint64_t folded = 0;
+    uint64_t word;
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8){
+        memcpy(&word, data + i, 8);
+        folded ^= word;
+    }
+    for (; i < length; i++){
+        folded ^= data[i];
+    }
+    return (uint8_t)__builtin_parityll(folded);
+}
+
+// arc_fast_hamming_uint64:
+// Calculates the 7 hamming parity bits over 8 bytes of data
+// params:
+// block        -   uint64_t 8 bytes to calculate hamming on
+// return:
+// parity_bits  -   parity bits for 8 bytes of data
+uint8_t arc_fast_hamming_uint64(uint64_t block){
+    uint8_t parity_result = 0;
+    int i;
+    for (i = 0; i < 7; i++){
+        parity_result |= (uint8_t)(__builtin_parityll(H_S_8_Parity_Matrix[i] & block) << i);
+    }
+    return parity_result;
+}
+
+// arc_fast_hamming_uint8:
+// Calculates the 4 hamming parity bits over 1 byte of data
+// params:
+// block        -   uint8_t byte to calculate hamming on
+// return:
+// parity_bits  -   parity bits for byte of data
+uint8_t arc_fast_hamming_uint8(uint8_t block){
+    uint8_t parity_result = 0;
+    int i;
+    for (i = 0; i < 4; i++){
+        parity_result |= (uint8_t)(__builtin_parity(H_S_1_Parity_Matrix[i] & block) << i);
+    }
+    return parity_result;
+}
+
+// arc_fast_secded_uint64:
+// Calculates the 8 secded parity bits over 8 bytes of data
+// params:
+// block        -   uint64_t 8 bytes to calculate secded on
+// return:
+// parity_bits  -   parity bits for 8 bytes of data
+uint8_t arc_fast_secded_uint64(uint64_t block){
+    uint8_t parity_result = arc_fast_hamming_uint64(block);
+    if (__builtin_parity(parity_result) != __builtin_parityll(block)){
+        parity_result |= (1 << 7);
+    }
+    return parity_result;
+}
+
+// arc_fast_secded_uint8:
+// Calculates the 5 secded parity bits over 1 byte of data
+// params:
+// block        -   uint8_t byte to calculate secded on
+// return:
+// parity_bits  -   parity bits for byte of data
+uint8_t arc_fast_secded_uint8(uint8_t block){
+    uint8_t parity_result = arc_fast_hamming_uint8(block);
+    if (__builtin_parity(parity_result) != __builtin_parity(block)){
+        parity_result |= (1 << 4);
+    }
+    return parity_result;
+}
+
+// arc_packed_check_bits:
+// Determines how many check bits each block of a packed layout keeps
+// params:
+// ecc_algorithm    -   identifier of the ecc method
+// return:
+// check_bits       -   1 for Parity, 4 for Hamming-1, 5 for SECDED-1 (0 if the method cannot be packed)
+uint32_t arc_packed_check_bits(int ecc_algorithm){
+    if (ecc_algorithm == PARITY_ID){
+        return 1;
+    } else if (ecc_algorithm == HAMMING_ID){
+        return 4;
+    } else if (ecc_algorithm == SECDED_ID){
+        return 5;
+    }
+    return 0;
+}
+
+// arc_layout_set_split:
+// Chooses between the interleaved layout ([check][block][check][block]...) and the split layout
+// ([payload][check trailer]) and updates the encoded size to match
+// params:
+// layout           -   layout of the encoded data stream
+// split            -   1 to store the payload contiguously followed by a check byte trailer, 0 to interleave
+// external_payload -   1 if the payload is held outside of the encoded buffer (split layout only)
+// note:
+// Packed layouts are always split
+void arc_layout_set_split(struct arc_layout* layout, int split, int external_payload){
+    split = (split != 0 || layout->packed);
+    layout->split = split;
+    layout->external_payload = (split && external_payload != 0);
+    if (layout->ecc_algorithm == RS_ID){
+        uint32_t data_devices = layout->ecc_parameter_a;
+        uint32_t code_devices = layout->ecc_parameter_b;
+        uint32_t total_data_devices = (data_devices * layout->block_count);
+        if (layout->remainder != 0){
+            total_data_devices = total_data_devices - (data_devices - layout->remainder);
+        }
+        if (layout->split){
+            // Every data device keeps a parity byte in the trailer, code devices are stored whole
+            layout->trailer_index = layout->metadata_length + (layout->external_payload ? 0 : layout->data_size);
+            layout->encoded_size = layout->trailer_index + total_data_devices + (code_devices * 9 * layout->block_count);
+        } else {
+            // Every device holds 8 bytes plus a parity byte
+            layout->trailer_index = 0;
+            layout->encoded_size = layout->metadata_length + ((total_data_devices + (code_devices * layout->block_count)) * 9);
+        }
+    } else {
+        // One check byte per block in either layout, or check_bits per block when packed
+        uint32_t check_bytes = layout->total_blocks;
+        if (layout->packed){
+            check_bytes = (uint32_t)((((uint64_t)layout->total_blocks * layout->check_bits) + 7) / 8);
+        }
+        layout->trailer_index = layout->split ? layout->metadata_length + (layout->external_payload ? 0 : layout->data_size) : 0;
+        layout->encoded_size = layout->metadata_length + (layout->external_payload ? 0 : layout->data_size) + check_bytes;
+    }
+}
+
+// arc_layout_create:
+// Determines the encoded layout for a data stream of the given size and ECC configuration
+// params:
+// ecc_algorithm    -   identifier of the ecc method to use
+// data_size        -   size of data stream
+// parameter_a      -   block size, or number of data devices for RS
+// parameter_b      -   number of code devices for RS, 1 to pack the check bits of Parity and 1 byte
+//                      Hamming/SECDED blocks, 0 otherwise
+// threads          -   number of OpenMP threads stored in the metadata
+// layout           -   address of layout to fill
+// return:
+// err              -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// The layout is split (see arc_layout_set_split) whenever ARC_SPLIT_LAYOUT is set or the check bits are packed
+int arc_layout_create(int ecc_algorithm, uint32_t data_size, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, struct arc_layout* layout){
+    layout->ecc_algorithm = ecc_algorithm;
+    layout->ecc_parameter_a = parameter_a;
+    layout->ecc_parameter_b = parameter_b;
+    layout->threads = threads;
+    layout->data_size = data_size;
+    layout->remainder_long_in_data = 0;
+    layout->packed = 0;
+    layout->check_bits = 8;
+    layout->version = (ARC_FORMAT_VERSION == 1) ? 1 : HEADER_VERSION;
+    layout->payload_checksum_present = 0;
+    layout->payload_checksum = 0;
+
+    if (ecc_algorithm == PARITY_ID){
+        if (parameter_a == 0){
+            printf("INVALID BLOCK SIZE: Please select a supported block size. . .\n");
+            return 0;
+        }
+        layout->metadata_length = 17;
+        layout->block_count = (data_size / parameter_a) + (data_size % parameter_a != 0);
+        layout->remainder = data_size % parameter_a;
+        layout->total_blocks = layout->block_count;
+    } else if (ecc_algorithm == HAMMING_ID || ecc_algorithm == SECDED_ID){
+        if (parameter_a != 1 && parameter_a != 8){
+            printf("INVALID BLOCK SIZE: Please select a supported block size. . .\n");
+            return 0;
+        }
+        layout->metadata_length = 17;
+        layout->block_count = data_size / parameter_a;
+        layout->remainder = data_size % parameter_a;
+        layout->total_blocks = layout->block_count + layout->remainder;
+    } else if (ecc_algorithm == RS_ID){
+        // Ensure k+m <= 2^w
+        if (parameter_a == 0 || parameter_b == 0 || parameter_a + parameter_b > ((long)1 << 8)){
+            printf("INVALID PARAMETER SIZES: Please select inputs where data devices + code devices <= 2^8. . .\n");
+            return 0;
+        }
+        uint32_t longs_per_data = (data_size / 8) + (data_size % 8 != 0);
+        layout->metadata_length = 25;
+        layout->remainder_long_in_data = data_size % 8;
+        layout->block_count = (longs_per_data / parameter_a) + (longs_per_data % parameter_a != 0);
+        layout->remainder = longs_per_data % parameter_a;
+        layout->total_blocks = layout->block_count;
+    } else {
+        printf("INVALID ENCODING METHOD: No valid encoding method found. . .\n");
+        return 0;
+    }
+    // Pack the check bits of Parity and 1 byte Hamming/SECDED blocks into a dense trailer
+    if (ecc_algorithm != RS_ID && parameter_b != 0){
+        if (parameter_b != 1 || (ecc_algorithm != PARITY_ID && parameter_a != 1)){
+            printf("INVALID PACKING: Check bits can only be packed for Parity and 1 byte Hamming/SECDED blocks. . .\n");
+            return 0;
+        }
+        layout->packed = 1;
+        layout->check_bits = arc_packed_check_bits(ecc_algorithm);
+    }
+    // The versioned header is the same size for every method
+    if (layout->version != 1){
+        layout->metadata_length = ARC_HEADER_LENGTH;
+    }
+    arc_layout_set_split(layout, ARC_SPLIT_LAYOUT, 0);
+    return 1;
+}
+
+// arc_layout_write_header:
+// Writes the versioned header of a layout, sealing it with a CRC32C of the header bytes
+// params:
+// layout       -   layout of the encoded data stream
+// encoded_data -   uint8_t encoded data stream
+// note:
+// Header fields (all big-endian): [0-3] magic, [4] version, [5] method identifier, [6] flags, [7] reserved,
+// [8-15] data size, [16-23] encoded size, [24-27] parameter a, [28-31] parameter b, [32-35] block count,
+// [36-39] remainder, [40-43] bytes in the final RS data long, [44-47] threads, [48-51] payload CRC32C,
+// [52-55] CRC32C of bytes 0-51
+void arc_layout_write_header(struct arc_layout* layout, uint8_t* encoded_data){
+    // The payload of an external payload layout is written between the header and trailer
+    uint64_t stream_size = (uint64_t)layout->encoded_size + (layout->external_payload ? layout->data_size : 0);
+    arc_write_uint32(&encoded_data[0], HEADER_MAGIC);
+    encoded_data[4] = (uint8_t)layout->version;
+    encoded_data[5] = (uint8_t)(layout->ecc_algorithm | (layout->split ? SPLIT_LAYOUT_FLAG : 0) | (layout->packed ? PACKED_LAYOUT_FLAG : 0));
+    encoded_data[6] = (uint8_t)(layout->payload_checksum_present ? HEADER_PAYLOAD_CHECKSUM_FLAG : 0);
+    encoded_data[7] = 0;
+    arc_store_uint64(&encoded_data[8], layout->data_size);
+    arc_store_uint64(&encoded_data[16], stream_size);
+    arc_write_uint32(&encoded_data[24], layout->ecc_parameter_a);
+    arc_write_uint32(&encoded_data[28], layout->ecc_parameter_b);
+    arc_write_uint32(&encoded_data[32], layout->block_count);
+    arc_write_uint32(&encoded_data[36], layout->remainder);
+    arc_write_uint32(&encoded_data[40], layout->remainder_long_in_data);
+    arc_write_uint32(&encoded_data[44], layout->threads);
+    arc_write_uint32(&encoded_data[48], layout->payload_checksum);
+    arc_write_uint32(&encoded_data[52], arc_crc32c(encoded_data, 52));
+}
+
+// arc_layout_write_metadata:
+// Writes the metadata describing a layout to the front of an encoded data stream
+// params:
+// layout       -   layout of the encoded data stream
+// data         -   uint8_t original data stream, used for the payload checksum when ARC_PAYLOAD_CHECKSUM is set
+//                  (may be NULL to leave it out)
+// encoded_data -   uint8_t encoded data stream
+void arc_layout_write_metadata(struct arc_layout* layout, const uint8_t* data, uint8_t* encoded_data){
+    if (layout->version != 1){
+        layout->payload_checksum_present = (ARC_PAYLOAD_CHECKSUM && data != NULL);
+        layout->payload_checksum = layout->payload_checksum_present ? arc_crc32c(data, layout->data_size) : 0;
+        arc_layout_write_header(layout, encoded_data);
+        return;
+    }
+    // Store Approach Identifier
+    encoded_data[0] = (uint8_t)(layout->ecc_algorithm | (layout->split ? SPLIT_LAYOUT_FLAG : 0) | (layout->packed ? PACKED_LAYOUT_FLAG : 0));
+    if (layout->ecc_algorithm == RS_ID){
+        arc_write_uint32(&encoded_data[1], layout->ecc_parameter_a);
+        arc_write_uint32(&encoded_data[5], layout->ecc_parameter_b);
+        arc_write_uint32(&encoded_data[9], layout->block_count);
+        arc_write_uint32(&encoded_data[13], layout->remainder);
+        arc_write_uint32(&encoded_data[17], layout->remainder_long_in_data);
+        arc_write_uint32(&encoded_data[21], layout->threads);
+    } else {
+        arc_write_uint32(&encoded_data[1], layout->block_count);
+        arc_write_uint32(&encoded_data[5], layout->ecc_parameter_a);
+        arc_write_uint32(&encoded_data[9], layout->remainder);
+        arc_write_uint32(&encoded_data[13], layout->threads);
+    }
+}
+
+// arc_layout_block:
+// Locates a single protected block within both the data stream and the encoded data stream
+// params:
+// layout           -   layout of the encoded data stream
+// block            -   index of the block to locate
+// data_index       -   address to store offset of the block within the data stream
+// data_length      -   address to store number of data bytes held by the block
+// encoded_index    -   address to store offset of the block's first check byte within the encoded data stream
+//                      (for packed layouts, the trailer byte holding the block's first check bit)
+void arc_layout_block(struct arc_layout* layout, uint32_t block, uint32_t* data_index, uint32_t* data_length, uint32_t* encoded_index){
+    uint32_t block_size = layout->ecc_parameter_a;
+    if (layout->ecc_algorithm == PARITY_ID){
+        *data_index = block * block_size;
+        *encoded_index = layout->split ? layout->trailer_index + block : layout->metadata_length + (block * (block_size + 1));
+        // Remainder Block
+        if (block == layout->block_count - 1 && layout->remainder != 0){
+            *data_length = layout->remainder;
+        // Full Block
+        } else {
+            *data_length = block_size;
+        }
+    } else if (layout->ecc_algorithm == RS_ID){
+        uint32_t total_devices = layout->ecc_parameter_a + layout->ecc_parameter_b;
+        *data_index = layout->ecc_parameter_a * 8 * block;
+        if (layout->split){
+            *encoded_index = layout->trailer_index + ((layout->ecc_parameter_a + (layout->ecc_parameter_b * 9)) * block);
+        } else {
+            *encoded_index = layout->metadata_length + (total_devices * 9 * block);
+        }
+        if (layout->data_size - *data_index < layout->ecc_parameter_a * 8){
+            *data_length = layout->data_size - *data_index;
+        } else {
+            *data_length = layout->ecc_parameter_a * 8;
+        }
+    } else {
+        // Full Blocks
+        if (block < layout->block_count){
+            *data_index = block * block_size;
+            *encoded_index = layout->metadata_length + (block * (block_size + 1));
+            *data_length = block_size;
+        // Remainder Blocks
+        } else {
+            *data_index = (layout->block_count * block_size) + (block - layout->block_count);
+            *encoded_index = layout->metadata_length + (layout->block_count * (block_size + 1)) + ((block - layout->block_count) * 2);
+            *data_length = 1;
+        }
+        if (layout->split){
+            *encoded_index = layout->trailer_index + block;
+        }
+    }
+    if (layout->packed){
+        *encoded_index = layout->trailer_index + (uint32_t)(((uint64_t)block * layout->check_bits) >> 3);
+    }
+}
+
+// arc_layout_payload:
+// Locates the data bytes of a block within the encoded data stream
+// params:
+// layout           -   layout of the encoded data stream
+// encoded_data     -   uint8_t encoded data stream
+// data_index       -   offset of the block within the data stream
+// encoded_index    -   offset of the block's first check byte within the encoded data stream
+// return:
+// payload          -   address of the block's data bytes (NULL when the payload is held outside the encoded buffer)
+// note:
+// Interleaved RS blocks do not hold their data contiguously, use arc_layout_rs_device instead
+uint8_t* arc_layout_payload(struct arc_layout* layout, uint8_t* encoded_data, uint32_t data_index, uint32_t encoded_index){
+    if (!layout->split){
+        return encoded_data + encoded_index + 1;
+    }
+    if (layout->external_payload){
+        return NULL;
+    }
+    return encoded_data + layout->metadata_length + data_index;
+}
+
+// arc_layout_rs_device:
+// Locates the parity byte and bytes of a single device of a RS block
+// params:
+// layout           -   layout of the encoded data stream
+// block_check      -   address of the block's first check byte
+// payload          -   address of the block's data bytes (split layout only, may be NULL)
+// data_length      -   number of data bytes held by the block
+// device           -   device index in jerasure order (data devices first, then code devices)
+// check            -   address to store location of the device's parity byte
+// bytes            -   address to store location of the device's bytes (NULL if not stored)
+// length           -   address to store number of bytes stored for the device
+void arc_layout_rs_device(struct arc_layout* layout, uint8_t* block_check, uint8_t* payload, uint32_t data_length, uint32_t device, uint8_t** check, uint8_t** bytes, uint32_t* length){
+    uint32_t current_block_data_devices = (data_length + 7) / 8;
+    uint32_t code_devices = layout->ecc_parameter_b;
+    if (device < current_block_data_devices){
+        if (layout->split){
+            // Data devices live in the payload with their parity bytes at the front of the block's trailer
+            *check = block_check + device;
+            *bytes = (payload == NULL) ? NULL : payload + (device * 8);
+            *length = (data_length - (device * 8) < 8) ? data_length - (device * 8) : 8;
+        } else {
+            // Data devices follow the code devices
+            *check = block_check + (code_devices * 9) + (device * 9);
+            *bytes = *check + 1;
+            *length = 8;
+        }
+    } else {
+        uint8_t* code_start = layout->split ? block_check + current_block_data_devices : block_check;
+        *check = code_start + ((device - current_block_data_devices) * 9);
+        *bytes = *check + 1;
+        *length = 8;
+    }
+}
+
+// arc_layout_check_value:
+// Loads the check bits stored for a single block
+// params:
+// layout           -   layout of the encoded data stream
+// encoded_data     -   uint8_t encoded data stream
+// block            -   index of the block
+// encoded_index    -   offset of the block's first check byte (see arc_layout_block)
+// return:
+// check            -   the block's check byte, or its check_bits wide field for packed layouts
+uint8_t arc_layout_check_value(struct arc_layout* layout, const uint8_t* encoded_data, uint32_t block, uint32_t encoded_index){
+    if (!layout->packed){
+        return encoded_data[encoded_index];
+    }
+    uint32_t shift = (uint32_t)(((uint64_t)block * layout->check_bits) & 7);
+    uint32_t field = encoded_data[encoded_index];
+    // Fields may straddle two trailer bytes
+    if (shift + layout->check_bits > 8){
+        field |= (uint32_t)encoded_data[encoded_index + 1] << 8;
+    }
+    return (uint8_t)((field >> shift) & ((1u << layout->check_bits) - 1));
+}
+
+// arc_layout_store_check:
+// Stores the check bits of a single block
+// params:
+// layout           -   layout of the encoded data stream
+// encoded_data     -   uint8_t encoded data stream
+// block            -   index of the block
+// encoded_index    -   offset of the block's first check byte (see arc_layout_block)
+// check            -   the block's check byte, or its check_bits wide field for packed layouts
+// note:
+// Packed blocks share trailer bytes with their neighbours, so blocks within the same group of 8
+// must not be stored concurrently (use arc_packed_store_group for bulk encoding)
+void arc_layout_store_check(struct arc_layout* layout, uint8_t* encoded_data, uint32_t block, uint32_t encoded_index, uint8_t check){
+    if (!layout->packed){
+        encoded_data[encoded_index] = check;
+        return;
+    }
+    uint32_t shift = (uint32_t)(((uint64_t)block * layout->check_bits) & 7);
+    uint32_t mask = ((1u << layout->check_bits) - 1) << shift;
+    uint32_t field = ((uint32_t)check << shift) & mask;
+    encoded_data[encoded_index] = (uint8_t)((encoded_data[encoded_index] & ~mask) | field);
+    if (shift + layout->check_bits > 8){
+        encoded_data[encoded_index + 1] = (uint8_t)((encoded_data[encoded_index + 1] & ~(mask >> 8)) | (field >> 8));
+    }
+}
+
+// arc_packed_group_blocks:
+// Determines how many blocks belong to a group of a packed layout
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// return:
+// blocks       -   number of blocks in the group (8 for every group but possibly the last)
+uint32_t arc_packed_group_blocks(struct arc_layout* layout, uint32_t group){
+    uint32_t first_block = group * 8;
+    return (layout->total_blocks - first_block < 8) ? layout->total_blocks - first_block : 8;
+}
+
+// arc_packed_group_range:
+// Locates the data bytes covered by a group of a packed layout
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// data_index   -   address to store offset of the group's first byte within the data stream
+// data_length  -   address to store number of data bytes held by the group
+void arc_packed_group_range(struct arc_layout* layout, uint32_t group, uint32_t* data_index, uint32_t* data_length){
+    uint32_t last_index, last_length, encoded_index;
+    arc_layout_block(layout, group * 8, data_index, &last_length, &encoded_index);
+    arc_layout_block(layout, (group * 8) + arc_packed_group_blocks(layout, group) - 1, &last_index, &last_length, &encoded_index);
+    *data_length = (last_index + last_length) - *data_index;
+}
+
+// arc_packed_compute_group_at:
+// Calculates the check fields of a group of up to 8 consecutive blocks of a packed layout at once
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// group_data   -   address of the group's first data byte
+// return:
+// fields       -   check fields of the group, block 8*group+i held in bits [i*check_bits, (i+1)*check_bits)
+uint64_t arc_packed_compute_group_at(struct arc_layout* layout, uint32_t group, const uint8_t* group_data){
+    uint32_t first_block = group * 8;
+    uint32_t blocks = arc_packed_group_blocks(layout, group);
+    uint64_t fields = 0;
+    uint32_t i;
+    if (layout->ecc_algorithm == PARITY_ID && layout->ecc_parameter_a == 1 && blocks == 8){
+        // Fold every byte down to its parity bit at once, then gather the 8 bits into a single byte
+        uint64_t word;
+        memcpy(&word, group_data, 8);
+        word ^= word >> 4;
+        word ^= word >> 2;
+        word ^= word >> 1;
+        word &= 0x0101010101010101ULL;
+        return (word * 0x0102040810204080ULL) >> 56;
+    }
+    uint32_t group_index, data_index, data_length, encoded_index;
+    arc_layout_block(layout, first_block, &group_index, &data_length, &encoded_index);
+    for (i = 0; i < blocks; i++){
+        uint64_t check;
+        arc_layout_block(layout, first_block + i, &data_index, &data_length, &encoded_index);
+        const uint8_t* block_data = group_data + (data_index - group_index);
+        if (layout->ecc_algorithm == PARITY_ID){
+            check = arc_fast_parity(block_data, data_length);
+        } else if (layout->ecc_algorithm == HAMMING_ID){
+            check = arc_fast_hamming_uint8(block_data[0]);
+        } else {
+            check = arc_fast_secded_uint8(block_data[0]);
+        }
+        fields |= check << (i * layout->check_bits);
+    }
+    return fields;
+}
+
+// arc_packed_compute_group:
+// Calculates the check fields of a group of a packed layout from the full data stream
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// data         -   uint8_t data stream (or payload) holding the blocks
+// return:
+// fields       -   check fields of the group (see arc_packed_compute_group_at)
+uint64_t arc_packed_compute_group(struct arc_layout* layout, uint32_t group, const uint8_t* data){
+    uint32_t data_index, data_length, encoded_index;
+    arc_layout_block(layout, group * 8, &data_index, &data_length, &encoded_index);
+    return arc_packed_compute_group_at(layout, group, data + data_index);
+}
+
+// arc_packed_load_group:
+// Loads the stored check fields of a group of a packed layout
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// encoded_data -   uint8_t encoded data stream
+// return:
+// fields       -   check fields of the group in the same order as arc_packed_compute_group
+uint64_t arc_packed_load_group(struct arc_layout* layout, uint32_t group, const uint8_t* encoded_data){
+    // A full group of 8 fields occupies exactly check_bits trailer bytes
+    uint32_t bits = arc_packed_group_blocks(layout, group) * layout->check_bits;
+    const uint8_t* location = encoded_data + layout->trailer_index + (group * layout->check_bits);
+    uint64_t fields = 0;
+    uint32_t i;
+    for (i = 0; i < (bits + 7) / 8; i++){
+        fields |= (uint64_t)location[i] << (8 * i);
+    }
+    return fields & ((bits == 64) ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1));
+}
+
+// arc_packed_store_group:
+// Stores the check fields of a group of a packed layout (unused bits of the final byte are zeroed)
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// encoded_data -   uint8_t encoded data stream
+// fields       -   check fields of the group in the same order as arc_packed_compute_group
+void arc_packed_store_group(struct arc_layout* layout, uint32_t group, uint8_t* encoded_data, uint64_t fields){
+    uint32_t bits = arc_packed_group_blocks(layout, group) * layout->check_bits;
+    uint8_t* location = encoded_data + layout->trailer_index + (group * layout->check_bits);
+    uint32_t i;
+    for (i = 0; i < (bits + 7) / 8; i++){
+        location[i] = (uint8_t)(fields >> (8 * i));
+    }
+}
+
+// arc_rs_matrix_cache_create:
+// Builds the Vandermonde coding matrices needed to encode or decode every block of a RS layout
+// params:
+// layout       -   layout of the encoded data stream
+// matrices     -   array of 257 matrix pointers indexed by number of data devices
+void arc_rs_matrix_cache_create(struct arc_layout* layout, int** matrices){
+    if (matrices[layout->ecc_parameter_a] == NULL){
+        matrices[layout->ecc_parameter_a] = reed_sol_vandermonde_coding_matrix(layout->ecc_parameter_a, layout->ecc_parameter_b, 8);
+    }
+    if (layout->remainder != 0 && matrices[layout->remainder] == NULL){
+        matrices[layout->remainder] = reed_sol_vandermonde_coding_matrix(layout->remainder, layout->ecc_parameter_b, 8);
+    }
+    // Build the Galois field tables before any threads need them
+    galois_create_mult_tables(8);
+}
+
+// arc_rs_matrix_cache_free:
+// Frees every matrix held in a RS matrix cache
+// params:
+// matrices     -   array of 257 matrix pointers indexed by number of data devices
+void arc_rs_matrix_cache_free(int** matrices){
+    int i;
+    for (i = 0; i <= 256; i++){
+        if (matrices[i] != NULL){
+            free(matrices[i]);
+            matrices[i] = NULL;
+        }
+    }
+}
+
+// arc_write_block:
+// Writes the data bytes of a single protected block and its check bits into the encoded data stream
+// params:
+// layout       -   layout of the encoded data stream
+// block        -   index of the block to write
+// source       -   address of the block's data bytes
+// encoded_data -   uint8_t encoded data stream
+// matrices     -   RS matrix cache (unused by other methods)
+void arc_write_block(struct arc_layout* layout, uint32_t block, uint8_t* source, uint8_t* encoded_data, int** matrices){
+    uint32_t data_index, data_length, encoded_index;
+    arc_layout_block(layout, block, &data_index, &data_length, &encoded_index);
+    uint8_t* check = encoded_data + encoded_index;
+    uint8_t* payload = arc_layout_payload(layout, encoded_data, data_index, encoded_index);
+
+    if (layout->ecc_algorithm == PARITY_ID){
+        arc_layout_store_check(layout, encoded_data, block, encoded_index, arc_fast_parity(source, data_length));
+    } else if (layout->ecc_algorithm == HAMMING_ID || layout->ecc_algorithm == SECDED_ID){
+        uint8_t check_value;
+        if (data_length == 8){
+            uint64_t block_8 = arc_load_uint64(source);
+            check_value = (layout->ecc_algorithm == HAMMING_ID) ? arc_fast_hamming_uint64(block_8) : arc_fast_secded_uint64(block_8);
+        } else {
+            check_value = (layout->ecc_algorithm == HAMMING_ID) ? arc_fast_hamming_uint8(source[0]) : arc_fast_secded_uint8(source[0]);
+        }
+        arc_layout_store_check(layout, encoded_data, block, encoded_index, check_value);
+    } else if (layout->ecc_algorithm == RS_ID){
+        uint32_t i;
+        uint32_t code_devices = layout->ecc_parameter_b;
+        uint32_t current_block_data_devices = (data_length + 7) / 8;
+        // Inflate data into aligned devices (zero padding the final long)
+        uint64_t storage[256];
+        char* rs_data[256];
+        char* rs_code[256];
+        memset(storage, 0, current_block_data_devices * 8);
+        memcpy(storage, source, data_length);
+        for (i = 0; i < current_block_data_devices; i++){
+            rs_data[i] = (char*)&storage[i];
+        }
+        for (i = 0; i < code_devices; i++){
+            rs_code[i] = (char*)&storage[current_block_data_devices + i];
+        }
+
+        // Encode with classic Reed-Solomon Encoding
+        jerasure_matrix_encode(current_block_data_devices, code_devices, 8, matrices[current_block_data_devices], rs_data, rs_code, 8);
+
+        // Write every device behind its own parity byte (zero padding does not change parity)
+        for (i = 0; i < current_block_data_devices + code_devices; i++){
+            uint8_t* device_check;
+            uint8_t* device_bytes;
+            uint32_t device_length;
+            arc_layout_rs_device(layout, check, payload, data_length, i, &device_check, &device_bytes, &device_length);
+            device_check[0] = arc_fast_parity((uint8_t*)&storage[i], 8);
+            if (device_bytes != NULL){
+                memcpy(device_bytes, &storage[i], device_length);
+            }
+        }
+        return;
+    }
+    if (payload != NULL){
+        memcpy(payload, source, data_length);
+    }
+}
+
+// arc_encode_block:
+// Encodes a single protected block of a layout into the encoded data stream
+// params:
+// layout       -   layout of the encoded data stream
+// block        -   index of the block to encode
+// data         -   uint8_t data stream
+// encoded_data -   uint8_t encoded data stream
+// matrices     -   RS matrix cache (unused by other methods)
+void arc_encode_block(struct arc_layout* layout, uint32_t block, uint8_t* data, uint8_t* encoded_data, int** matrices){
+    uint32_t data_index, data_length, encoded_index;
+    arc_layout_block(layout, block, &data_index, &data_length, &encoded_index);
+    arc_write_block(layout, block, data + data_index, encoded_data, matrices);
+}
+
+// arc_encode_group:
+// Encodes a group of up to 8 consecutive blocks of a packed layout, writing whole trailer bytes so
+// groups can be encoded concurrently
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// data         -   uint8_t data stream
+// encoded_data -   uint8_t encoded data stream
+void arc_encode_group(struct arc_layout* layout, uint32_t group, uint8_t* data, uint8_t* encoded_data){
+    arc_packed_store_group(layout, group, encoded_data, arc_packed_compute_group(layout, group, data));
+    if (!layout->external_payload){
+        uint32_t data_index, data_length;
+        arc_packed_group_range(layout, group, &data_index, &data_length);
+        memcpy(encoded_data + layout->metadata_length + data_index, data + data_index, data_length);
+    }
+}
+
+// arc_encode_blocks:
+// Encodes every block of a layout in parallel
+// params:
+// layout       -   layout of the encoded data stream
+// data         -   uint8_t data stream
+// encoded_data -   uint8_t encoded data stream (metadata must already be written)
+// threads      -   number of OpenMP threads to split work across
+void arc_encode_blocks(struct arc_layout* layout, uint8_t* data, uint8_t* encoded_data, uint32_t threads){
+    int* matrices[257] = {NULL};
+    if (layout->ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(layout, matrices);
+    }
+
+    // Setup Loop Variables
+    uint32_t blocks_processed;
+    uint32_t total_blocks = layout->total_blocks;
+    // Determine number of threads per block
+    int n_per_thread;
+    if (threads < 1){
+        threads = 1;
+    }
+    // Packed layouts are encoded a group of 8 blocks (check_bits whole trailer bytes) at a time
+    if (layout->packed){
+        uint32_t groups_processed;
+        uint32_t total_groups = (total_blocks + 7) / 8;
+        omp_set_num_threads(threads);
+        #pragma omp parallel
+        {
+            ARC_TRACE_BEGIN(encode_kernel);
+            #pragma omp for schedule(static) nowait
+            for (groups_processed = 0; groups_processed < total_groups; groups_processed++){
+                arc_encode_group(layout, groups_processed, data, encoded_data);
+            }
+            ARC_TRACE_END(encode_kernel);
+        }
+        return;
+    }
+    if (total_blocks < threads){
+        n_per_thread = 1;
+    } else {
+        n_per_thread = total_blocks / threads;
+    }
+    // Set number of threads
+    omp_set_num_threads(threads);
+
+    // Calculate ECC for each block of data
+    #pragma omp parallel
+    {
+        ARC_TRACE_BEGIN(encode_kernel);
+        #pragma omp for schedule(static, n_per_thread) nowait
+        for (blocks_processed = 0; blocks_processed < total_blocks; blocks_processed++){
+            arc_encode_block(layout, blocks_processed, data, encoded_data, matrices);
+        }
+        ARC_TRACE_END(encode_kernel);
+    }
+
+    arc_rs_matrix_cache_free(matrices);
+}
+
+// arc_configuration_encode:
+// Encodes a data stream with any ECC configuration found in the configuration table
+// params:
+// ecc_algorithm        -   identifier of the ecc method to use
+// parameter_a          -   first ecc method parameter
+// parameter_b          -   second ecc method parameter
+// threads              -   number of OpenMP threads to split work across
+// data                 -   uint8_t data stream
+// data_size            -   size of data stream
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_configuration_encode(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, uint8_t* data, uint32_t data_size, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    struct arc_layout layout;
+    if (arc_layout_create(ecc_algorithm, data_size, parameter_a, parameter_b, threads, &layout) == 0){
+        return 0;
+    }
+    *encoded_data_size = layout.encoded_size;
+    ARC_TRACE_BEGIN(allocate);
+    *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
+    arc_layout_write_metadata(&layout, data, *encoded_data);
+    arc_encode_blocks(&layout, data, *encoded_data, threads);
+    return 1;
+}
+
+// ARC Fragmented Data Struct
+// Presents a list of iovec fragments as a single logical data stream
+struct arc_fragments {
+    const struct iovec* parts;
+    int count;
+    // Offset of each fragment within the logical data stream, with the final entry holding its size
+    uint64_t* offsets;
+};
+
+// arc_fragments_create:
+// Indexes a list of iovec fragments so any byte of the logical data stream can be found in O(log count)
+// params:
+// parts        -   array of fragments in data stream order
+// count        -   number of fragments
+// fragments    -   address of fragmented data to fill
+// return:
+// err          -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_fragments_create(const struct iovec* parts, int count, struct arc_fragments* fragments){
+    int i;
+    if (parts == NULL || count < 1){
+        printf("INVALID FRAGMENTS: Please provide at least one data fragment. . .\n");
+        return 0;
+    }
+    fragments->parts = parts;
+    fragments->count = count;
+    fragments->offsets = talloc(uint64_t, count + 1);
+    fragments->offsets[0] = 0;
+    for (i = 0; i < count; i++){
+        if (parts[i].iov_base == NULL && parts[i].iov_len != 0){
+            printf("INVALID FRAGMENTS: Fragment %d has no data. . .\n", i);
+            free(fragments->offsets);
+            return 0;
+        }
+        fragments->offsets[i + 1] = fragments->offsets[i] + parts[i].iov_len;
+    }
+    if (fragments->offsets[count] > UINT32_MAX){
+        printf("INVALID FRAGMENTS: Combined data size exceeds 4 GB. . .\n");
+        free(fragments->offsets);
+        return 0;
+    }
+    return 1;
+}
+
+// arc_fragments_free:
+// Frees the index of a list of fragments (the fragments themselves are untouched)
+// params:
+// fragments    -   fragmented data
+void arc_fragments_free(struct arc_fragments* fragments){
+    free(fragments->offsets);
+    fragments->offsets = NULL;
+}
+
+// arc_fragments_span:
+// Locates a run of bytes of the logical data stream, gathering it only when it crosses fragment boundaries
+// params:
+// fragments    -   fragmented data
+// index        -   offset of the first byte within the logical data stream
+// length       -   number of bytes (at least 1)
+// scratch      -   buffer of at least length bytes used when the run crosses fragments
+// return:
+// location     -   address of the run, inside a fragment whenever possible and in scratch otherwise
+const uint8_t* arc_fragments_span(struct arc_fragments* fragments, uint32_t index, uint32_t length, uint8_t* scratch){
+    // Find the last fragment starting at or before index (skipping empty fragments)
+    int low = 0;
+    int high = fragments->count - 1;
+    while (low < high){
+        int middle = (low + high + 1) / 2;
+        if (fragments->offsets[middle] <= index){
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    while (fragments->offsets[low + 1] <= index){
+        low++;
+    }
+    uint64_t fragment_offset = index - fragments->offsets[low];
+    if (index + (uint64_t)length <= fragments->offsets[low + 1]){
+        return (const uint8_t*)fragments->parts[low].iov_base + fragment_offset;
+    }
+    // Gather the pieces of a run crossing fragment boundaries
+    uint32_t gathered = 0;
+    while (gathered < length){
+        uint64_t available = fragments->parts[low].iov_len - fragment_offset;
+        uint32_t piece = (available < length - gathered) ? (uint32_t)available : length - gathered;
+        memcpy(scratch + gathered, (const uint8_t*)fragments->parts[low].iov_base + fragment_offset, piece);
+        gathered = gathered + piece;
+        fragment_offset = 0;
+        low++;
+    }
+    return scratch;
+}
+
+// arc_fragments_checksum:
+// Calculates the CRC32C of the logical data stream held by a list of fragments
+// params:
+// fragments    -   fragmented data
+// return:
+// crc          -   CRC32C of the logical data stream
+uint32_t arc_fragments_checksum(struct arc_fragments* fragments){
+    uint32_t crc = 0xFFFFFFFF;
+    int i;
+    for (i = 0; i < fragments->count; i++){
+        crc = arc_crc32c_update(crc, (const uint8_t*)fragments->parts[i].iov_base, fragments->parts[i].iov_len);
+    }
+    return ~crc;
+}
+
+// arc_encode_fragments:
+// Encodes every block of a layout in parallel, reading the data directly from a list of fragments
+// params:
+// layout       -   layout of the encoded data stream
+// fragments    -   fragmented data holding the data stream
+// encoded_data -   uint8_t encoded data stream (metadata must already be written)
+// threads      -   number of OpenMP threads to split work across
+// note:
+// Blocks inside a single fragment are encoded in place, only blocks crossing a fragment boundary
+// are gathered into a per-thread scratch block
+void arc_encode_fragments(struct arc_layout* layout, struct arc_fragments* fragments, uint8_t* encoded_data, uint32_t threads){
+    int* matrices[257] = {NULL};
+    if (layout->ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(layout, matrices);
+    }
+    // Largest run of bytes a single task reads
+    uint32_t scratch_size = (layout->ecc_algorithm == RS_ID) ? layout->ecc_parameter_a * 8 : layout->ecc_parameter_a;
+    if (layout->packed){
+        scratch_size = scratch_size * 8;
+    }
+    if (threads < 1){
+        threads = 1;
+    }
+    omp_set_num_threads(threads);
+
+    #pragma omp parallel
+    {
+        ARC_TRACE_BEGIN(encode_kernel);
+        uint8_t* scratch = talloc(uint8_t, scratch_size);
+        uint32_t data_index, data_length, encoded_index;
+        if (layout->packed){
+            // Packed layouts are encoded a group of 8 blocks (check_bits whole trailer bytes) at a time
+            uint32_t groups_processed;
+            uint32_t total_groups = (layout->total_blocks + 7) / 8;
+            #pragma omp for schedule(static) nowait
+            for (groups_processed = 0; groups_processed < total_groups; groups_processed++){
+                arc_packed_group_range(layout, groups_processed, &data_index, &data_length);
+                const uint8_t* source = arc_fragments_span(fragments, data_index, data_length, scratch);
+                arc_packed_store_group(layout, groups_processed, encoded_data, arc_packed_compute_group_at(layout, groups_processed, source));
+                if (!layout->external_payload){
+                    memcpy(encoded_data + layout->metadata_length + data_index, source, data_length);
+                }
+            }
+        } else {
+            uint32_t blocks_processed;
+            #pragma omp for schedule(static) nowait
+            for (blocks_processed = 0; blocks_processed < layout->total_blocks; blocks_processed++){
+                arc_layout_block(layout, blocks_processed, &data_index, &data_length, &encoded_index);
+                const uint8_t* source = arc_fragments_span(fragments, data_index, data_length, scratch);
+                arc_write_block(layout, blocks_processed, (uint8_t*)source, encoded_data, matrices);
+            }
+        }
+        free(scratch);
+        ARC_TRACE_END(encode_kernel);
+    }
+    arc_rs_matrix_cache_free(matrices);
+}
+
+// arc_configuration_encodev:
+// Encodes a data stream held in a list of fragments with any ECC configuration, without gathering it first
+// params:
+// ecc_algorithm        -   identifier of the ecc method to use
+// parameter_a          -   first ecc method parameter
+// parameter_b          -   second ecc method parameter
+// threads              -   number of OpenMP threads to split work across
+// data_parts           -   array of fragments forming the data stream in order
+// part_count           -   number of fragments
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// The result is identical to encoding the concatenated fragments
+int arc_configuration_encodev(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, const struct iovec* data_parts, int part_count, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    struct arc_fragments fragments;
+    if (arc_fragments_create(data_parts, part_count, &fragments) == 0){
+        return 0;
+    }
+    struct arc_layout layout;
+    if (arc_layout_create(ecc_algorithm, (uint32_t)fragments.offsets[part_count], parameter_a, parameter_b, threads, &layout) == 0){
+        arc_fragments_free(&fragments);
+        return 0;
+    }
+    *encoded_data_size = layout.encoded_size;
+    ARC_TRACE_BEGIN(allocate);
+    *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
+    arc_layout_write_metadata(&layout, NULL, *encoded_data);
+    if (ARC_PAYLOAD_CHECKSUM && layout.version != 1){
+        layout.payload_checksum_present = 1;
+        layout.payload_checksum = arc_fragments_checksum(&fragments);
+        arc_layout_write_header(&layout, *encoded_data);
+    }
+    arc_encode_fragments(&layout, &fragments, *encoded_data, threads);
+    arc_fragments_free(&fragments);
+    return 1;
+}
+
+// arc_header_present:
+// Determines whether an encoded data stream starts with a versioned header rather than the legacy one
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// return:
+// present              -   1 if the stream starts with the header magic, 0 otherwise
+int arc_header_present(const uint8_t* encoded_data, uint32_t encoded_data_size){
+    return (encoded_data_size >= 4 && arc_read_uint32(encoded_data) == HEADER_MAGIC);
+}
+
+// arc_layout_read_header:
+// Rebuilds the layout of an encoded data stream from its versioned header
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// layout               -   address of layout to fill
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// The header CRC32C is verified before any field is trusted, so a corrupt header is rejected
+// without touching the rest of the stream
+int arc_layout_read_header(const uint8_t* encoded_data, uint32_t encoded_data_size, struct arc_layout* layout){
+    if (encoded_data_size < ARC_HEADER_LENGTH){
+        printf("INVALID ENCODED DATA: Encoded data stream is too small to hold ARC metadata. . .\n");
+        return 0;
+    }
+    if (arc_crc32c(encoded_data, 52) != arc_read_uint32(&encoded_data[52])){
+        printf("INVALID ENCODED DATA: Header checksum mismatch, the ARC metadata is corrupt. . .\n");
+        return 0;
+    }
+    if (encoded_data[4] < 2 || encoded_data[4] > HEADER_VERSION){
+        printf("INVALID ENCODED DATA: Unsupported header version %d. . .\n", encoded_data[4]);
+        return 0;
+    }
+    int ecc_algorithm = encoded_data[5] & ~(SPLIT_LAYOUT_FLAG | PACKED_LAYOUT_FLAG);
+    int split = (encoded_data[5] & SPLIT_LAYOUT_FLAG) != 0;
+    int packed = (encoded_data[5] & PACKED_LAYOUT_FLAG) != 0;
+    uint64_t data_size = arc_load_uint64(&encoded_data[8]);
+    uint64_t stream_size = arc_load_uint64(&encoded_data[16]);
+    uint32_t parameter_a = arc_read_uint32(&encoded_data[24]);
+    uint32_t parameter_b = arc_read_uint32(&encoded_data[28]);
+    uint32_t block_count = arc_read_uint32(&encoded_data[32]);
+    uint32_t remainder = arc_read_uint32(&encoded_data[36]);
+    uint32_t remainder_long_in_data = arc_read_uint32(&encoded_data[40]);
+    uint32_t threads = arc_read_uint32(&encoded_data[44]);
+    if (stream_size != encoded_data_size || data_size >= stream_size){
+        printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+        return 0;
+    }
+    if (ecc_algorithm < PARITY_ID || ecc_algorithm > RS_ID){
+        printf("INVALID ENCODING METHOD: No valid encoding method found to decode this data. . .\n");
+        return 0;
+    }
+    // Only Parity, Hamming, and SECDED keep the packing choice in parameter b
+    if ((ecc_algorithm == RS_ID) ? packed : (parameter_b != (uint32_t)packed)){
+        printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+        return 0;
+    }
+
+    // Rebuild the layout and make sure it describes exactly this stream
+    if (arc_layout_create(ecc_algorithm, (uint32_t)data_size, parameter_a, parameter_b, threads, layout) == 0){
+        return 0;
+    }
+    layout->version = encoded_data[4];
+    layout->metadata_length = ARC_HEADER_LENGTH;
+    layout->payload_checksum_present = (encoded_data[6] & HEADER_PAYLOAD_CHECKSUM_FLAG) != 0;
+    layout->payload_checksum = arc_read_uint32(&encoded_data[48]);
+    arc_layout_set_split(layout, split, 0);
+    if (layout->block_count != block_count || layout->remainder != remainder || layout->remainder_long_in_data != remainder_long_in_data 
+        || layout->encoded_size != encoded_data_size){
+        printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+        return 0;
+    }
+    return 1;
+}
+
+// arc_layout_read:
+// Rebuilds the layout of an encoded data stream from its metadata and ensures it matches the stream size
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// layout               -   address of layout to fill
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_layout_read(const uint8_t* encoded_data, uint32_t encoded_data_size, struct arc_layout* layout){
+    if (arc_header_present(encoded_data, encoded_data_size)){
+        return arc_layout_read_header(encoded_data, encoded_data_size, layout);
+    }
+    if (encoded_data_size < 17){
+        printf("INVALID ENCODED DATA: Encoded data stream is too small to hold ARC metadata. . .\n");
+        return 0;
+    }
+    int ecc_algorithm = encoded_data[0] & ~(SPLIT_LAYOUT_FLAG | PACKED_LAYOUT_FLAG);
+    int split = (encoded_data[0] & SPLIT_LAYOUT_FLAG) != 0;
+    int packed = (encoded_data[0] & PACKED_LAYOUT_FLAG) != 0;
+    uint32_t data_size;
+    uint32_t parameter_a, parameter_b, threads;
+    uint32_t block_count, remainder, remainder_long_in_data = 0;
+    if (ecc_algorithm == PARITY_ID || ecc_algorithm == HAMMING_ID || ecc_algorithm == SECDED_ID){
+        block_count = arc_read_uint32(&encoded_data[1]);
+        parameter_a = arc_read_uint32(&encoded_data[5]);
+        remainder = arc_read_uint32(&encoded_data[9]);
+        threads = arc_read_uint32(&encoded_data[13]);
+        parameter_b = packed;
+        uint64_t check_bytes = (uint64_t)block_count + ((ecc_algorithm == PARITY_ID) ? 0 : remainder);
+        if (packed){
+            check_bytes = ((check_bytes * arc_packed_check_bits(ecc_algorithm)) + 7) / 8;
+        }
+        check_bytes = check_bytes + 17;
+        if (check_bytes > encoded_data_size){
+            printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+            return 0;
+        }
+        data_size = encoded_data_size - (uint32_t)check_bytes;
+    } else if (ecc_algorithm == RS_ID && !packed){
+        if (encoded_data_size < 25){
+            printf("INVALID ENCODED DATA: Encoded data stream is too small to hold ARC metadata. . .\n");
+            return 0;
+        }
+        parameter_a = arc_read_uint32(&encoded_data[1]);
+        parameter_b = arc_read_uint32(&encoded_data[5]);
+        block_count = arc_read_uint32(&encoded_data[9]);
+        remainder = arc_read_uint32(&encoded_data[13]);
+        remainder_long_in_data = arc_read_uint32(&encoded_data[17]);
+        threads = arc_read_uint32(&encoded_data[21]);
+        if (block_count == 0 || parameter_a == 0 || parameter_a > 256 || remainder >= parameter_a || remainder_long_in_data >= 8){
+            printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+            return 0;
+        }
+        uint64_t longs = ((uint64_t)parameter_a * (block_count - 1)) + ((remainder == 0) ? parameter_a : remainder);
+        uint64_t full_size = longs * 8 - ((remainder_long_in_data == 0) ? 0 : (8 - remainder_long_in_data));
+        if (full_size > UINT32_MAX){
+            printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+            return 0;
+        }
+        data_size = (uint32_t)full_size;
+    } else {
+        printf("INVALID ENCODING METHOD: No valid encoding method found to decode this data. . .\n");
+        return 0;
+    }
+
+    // Rebuild the layout and make sure it describes exactly this stream
+    if (arc_layout_create(ecc_algorithm, data_size, parameter_a, parameter_b, threads, layout) == 0){
+        return 0;
+    }
+    layout->version = 1;
+    layout->metadata_length = (ecc_algorithm == RS_ID) ? 25 : 17;
+    arc_layout_set_split(layout, split, 0);
+    if (layout->block_count != block_count || layout->remainder != remainder || layout->remainder_long_in_data != remainder_long_in_data 
+        || layout->encoded_size != encoded_data_size){
+        printf("INVALID ENCODED DATA: Metadata does not match encoded data stream size. . .\n");
+        return 0;
+    }
+    return 1;
+}
+
+// arc_check_block:
+// Classifies a single protected block of an encoded data stream without modifying or copying it
+// params:
+// layout       -   layout of the encoded data stream
+// block        -   index of the block to check
+// encoded_data -   uint8_t encoded data stream
+// return:
+// status       -   ARC_BLOCK_CLEAN, ARC_BLOCK_CORRECTABLE, or ARC_BLOCK_UNCORRECTABLE
+int arc_check_block(struct arc_layout* layout, uint32_t block, uint8_t* encoded_data){
+    uint32_t data_index, data_length, encoded_index;
+    arc_layout_block(layout, block, &data_index, &data_length, &encoded_index);
+    uint8_t* check = encoded_data + encoded_index;
+    uint8_t* payload = arc_layout_payload(layout, encoded_data, data_index, encoded_index);
+    uint8_t check_value = (layout->ecc_algorithm == RS_ID) ? 0 : arc_layout_check_value(layout, encoded_data, block, encoded_index);
+    int j;
+
+    if (layout->ecc_algorithm == PARITY_ID){
+        // Single bit parity can only detect errors
+        if (check_value != arc_fast_parity(payload, data_length)){
+            return ARC_BLOCK_UNCORRECTABLE;
+        }
+        return ARC_BLOCK_CLEAN;
+    } else if (layout->ecc_algorithm == HAMMING_ID){
+        uint8_t syndrome;
+        if (data_length == 8){
+            syndrome = check_value ^ arc_fast_hamming_uint64(arc_load_uint64(payload));
+            if (syndrome == 0){
+                return ARC_BLOCK_CLEAN;
+            }
+            for (j = 0; j < 72; j++){
+                if (syndrome == H_8_Syndrome_Table[j]){
+                    return ARC_BLOCK_CORRECTABLE;
+                }
+            }
+        } else {
+            syndrome = check_value ^ arc_fast_hamming_uint8(payload[0]);
+            if (syndrome == 0){
+                return ARC_BLOCK_CLEAN;
+            }
+            for (j = 0; j < 16; j++){
+                if (syndrome == H_1_Syndrome_Table[j]){
+                    return ARC_BLOCK_CORRECTABLE;
+                }
+            }
+        }
+        return ARC_BLOCK_UNCORRECTABLE;
+    } else if (layout->ecc_algorithm == SECDED_ID){
+        uint8_t syndrome;
+        if (data_length == 8){
+            uint64_t block_8 = arc_load_uint64(payload);
+            syndrome = check_value ^ arc_fast_secded_uint64(block_8);
+            if (syndrome == 0){
+                return ARC_BLOCK_CLEAN;
+            }
+            // Double bit errors leave the overall parity unchanged
+            uint8_t overall_parity = (uint8_t)(__builtin_parity(check_value & 0x7F) != __builtin_parityll(block_8));
+            if (((check_value & 0x80) >> 7) == overall_parity){
+                return ARC_BLOCK_UNCORRECTABLE;
+            }
+            for (j = 0; j < 72; j++){
+                if (syndrome == S_8_Syndrome_Table[j]){
+                    return ARC_BLOCK_CORRECTABLE;
+                }
+            }
+        } else {
+            syndrome = check_value ^ arc_fast_secded_uint8(payload[0]);
+            if (syndrome == 0){
+                return ARC_BLOCK_CLEAN;
+            }
+            uint8_t overall_parity = (uint8_t)(__builtin_parity(check_value & 0xEF) != __builtin_parity(payload[0]));
+            if (((check_value & 0x10) >> 4) == overall_parity){
+                return ARC_BLOCK_UNCORRECTABLE;
+            }
+            for (j = 0; j < 16; j++){
+                if (syndrome == S_1_Syndrome_Table[j]){
+                    return ARC_BLOCK_CORRECTABLE;
+                }
+            }
+        }
+        return ARC_BLOCK_UNCORRECTABLE;
+    } else if (layout->ecc_algorithm == RS_ID){
+        // Every device with a failed parity byte becomes an erasure, RS can recover up to code_devices of them
+        uint32_t total_devices = layout->ecc_parameter_b + ((data_length + 7) / 8);
+        uint32_t erasures = 0;
+        uint32_t i;
+        for (i = 0; i < total_devices; i++){
+            uint8_t* device_check;
+            uint8_t* device_bytes;
+            uint32_t device_length;
+            arc_layout_rs_device(layout, check, payload, data_length, i, &device_check, &device_bytes, &device_length);
+            if (device_check[0] != arc_fast_parity(device_bytes, device_length)){
+                erasures++;
+            }
+        }
+        if (erasures == 0){
+            return ARC_BLOCK_CLEAN;
+        } else if (erasures <= layout->ecc_parameter_b){
+            return ARC_BLOCK_CORRECTABLE;
+        }
+        return ARC_BLOCK_UNCORRECTABLE;
+    }
+    return ARC_BLOCK_UNCORRECTABLE;
+}
+
+// arc_layout_find_block:
+// Determines which protected block holds a byte of the data stream
+// params:
+// layout       -   layout of the encoded data stream
+// data_offset  -   offset of the byte within the data stream
+// return:
+// block        -   index of the block holding the byte
+uint32_t arc_layout_find_block(struct arc_layout* layout, uint32_t data_offset){
+    if (layout->ecc_algorithm == RS_ID){
+        return data_offset / (layout->ecc_parameter_a * 8);
+    } else if (layout->ecc_algorithm == PARITY_ID){
+        return data_offset / layout->ecc_parameter_a;
+    }
+    // Hamming & SECDED full blocks are followed by single byte remainder blocks
+    uint32_t full_block_bytes = layout->block_count * layout->ecc_parameter_a;
+    if (data_offset < full_block_bytes){
+        return data_offset / layout->ecc_parameter_a;
+    }
+    return layout->block_count + (data_offset - full_block_bytes);
+}
+
+// arc_decode_block:
+// Checks and, where possible, corrects a single protected block and writes its data out
+// params:
+// layout       -   layout of the encoded data stream
+// block        -   index of the block to decode
+// encoded_data -   uint8_t encoded data stream
+// output       -   address to write the block's data bytes to (uncorrectable blocks are written as stored)
+// matrices     -   RS matrix cache (unused by other methods)
+// return:
+// status       -   ARC_BLOCK_CLEAN, ARC_BLOCK_CORRECTABLE (data was corrected), or ARC_BLOCK_UNCORRECTABLE
+int arc_decode_block(struct arc_layout* layout, uint32_t block, uint8_t* encoded_data, uint8_t* output, int** matrices){
+    uint32_t data_index, data_length, encoded_index;
+    arc_layout_block(layout, block, &data_index, &data_length, &encoded_index);
+    uint8_t* check = encoded_data + encoded_index;
+    uint8_t* payload = arc_layout_payload(layout, encoded_data, data_index, encoded_index);
+    int status = arc_check_block(layout, block, encoded_data);
+    int j;
+
+    if (layout->ecc_algorithm != RS_ID){
+        memcpy(output, payload, data_length);
+        if (status != ARC_BLOCK_CORRECTABLE){
+            if (status == ARC_BLOCK_UNCORRECTABLE){
+                arc_stats_record_block(status);
+            }
+            return status;
+        }
+        // Locate and flip the faulty bit (errors in the check bits leave the data untouched)
+        uint8_t check_value = arc_layout_check_value(layout, encoded_data, block, encoded_index);
+        uint8_t expected;
+        if (data_length == 8){
+            uint64_t block_8 = arc_load_uint64(payload);
+            expected = (layout->ecc_algorithm == HAMMING_ID) ? arc_fast_hamming_uint64(block_8) : arc_fast_secded_uint64(block_8);
+            uint8_t* syndrome_table = (layout->ecc_algorithm == HAMMING_ID) ? H_8_Syndrome_Table : S_8_Syndrome_Table;
+            for (j = 0; j < 64; j++){
+                if ((uint8_t)(check_value ^ expected) == syndrome_table[j]){
+                    arc_store_uint64(output, block_8 ^ ((uint64_t)1 << j));
+                    break;
+                }
+            }
+        } else {
+            expected = (layout->ecc_algorithm == HAMMING_ID) ? arc_fast_hamming_uint8(payload[0]) : arc_fast_secded_uint8(payload[0]);
+            uint8_t* syndrome_table = (layout->ecc_algorithm == HAMMING_ID) ? H_1_Syndrome_Table : S_1_Syndrome_Table;
+            for (j = 0; j < 8; j++){
+                if ((uint8_t)(check_value ^ expected) == syndrome_table[j]){
+                    output[0] = payload[0] ^ (uint8_t)(1 << j);
+                    break;
+                }
+            }
+        }
+        arc_stats_record_block(status);
+        return status;
+    }
+
+    // Reed-Solomon: inflate devices into aligned storage, marking every device with a failed parity byte as erased
+    uint32_t i;
+    uint32_t code_devices = layout->ecc_parameter_b;
+    uint32_t current_block_data_devices = (data_length + 7) / 8;
+    uint64_t storage[256];
+    char* rs_data[256];
+    char* rs_code[256];
+    int erasures[257];
+    int erasure_count = 0;
+    for (i = 0; i < current_block_data_devices + code_devices; i++){
+        uint8_t* device_check;
+        uint8_t* device_bytes;
+        uint32_t device_length;
+        arc_layout_rs_device(layout, check, payload, data_length, i, &device_check, &device_bytes, &device_length);
+        storage[i] = 0;
+        memcpy(&storage[i], device_bytes, device_length);
+        if (status == ARC_BLOCK_CORRECTABLE && device_check[0] != arc_fast_parity(device_bytes, device_length)){
+            erasures[erasure_count++] = i;
+        }
+        if (i < current_block_data_devices){
+            rs_data[i] = (char*)&storage[i];
+        } else {
+            rs_code[i - current_block_data_devices] = (char*)&storage[i];
+        }
+    }
+    erasures[erasure_count] = -1;
+
+    // Rebuild erased devices with jerasure
+    if (status == ARC_BLOCK_CORRECTABLE){
+        if (jerasure_matrix_decode(current_block_data_devices, code_devices, 8, matrices[current_block_data_devices], 1, erasures, rs_data, rs_code, 8) == -1){
+            status = ARC_BLOCK_UNCORRECTABLE;
+        }
+    }
+    memcpy(output, storage, data_length);
+    if (status != ARC_BLOCK_CLEAN){
+        arc_stats_record_block(status);
+    }
+    return status;
+}
+
+// arc_decode_group:
+// Decodes a group of up to 8 consecutive blocks of a packed layout, verifying clean groups with a
+// single comparison of their packed check fields
+// params:
+// layout       -   packed layout of the encoded data stream
+// group        -   index of the group (blocks 8*group to 8*group+7)
+// encoded_data -   uint8_t encoded data stream
+// data         -   uint8_t data stream to write the group's data bytes into
+// error_bitmap -   bitmap of uncorrectable blocks, byte group receives bit i for block 8*group+i (may be NULL)
+// return:
+// status       -   worst status of any block in the group
+int arc_decode_group(struct arc_layout* layout, uint32_t group, uint8_t* encoded_data, uint8_t* data, uint8_t* error_bitmap){
+    uint32_t data_index, data_length;
+    uint8_t* payload = encoded_data + layout->metadata_length;
+    if (arc_packed_compute_group(layout, group, payload) == arc_packed_load_group(layout, group, encoded_data)){
+        arc_packed_group_range(layout, group, &data_index, &data_length);
+        memcpy(data + data_index, payload + data_index, data_length);
+        return ARC_BLOCK_CLEAN;
+    }
+    // Fall back to checking each block of a dirty group
+    int status = ARC_BLOCK_CLEAN;
+    uint32_t block;
+    uint32_t last_block = (group * 8) + arc_packed_group_blocks(layout, group);
+    for (block = group * 8; block < last_block; block++){
+        uint32_t encoded_index;
+        arc_layout_block(layout, block, &data_index, &data_length, &encoded_index);
+        int block_status = arc_decode_block(layout, block, encoded_data, data + data_index, NULL);
+        if (block_status == ARC_BLOCK_UNCORRECTABLE && error_bitmap != NULL){
+            error_bitmap[group] |= (uint8_t)(1 << (block - (group * 8)));
+        }
+        if (block_status > status){
+            status = block_status;
+        }
+    }
+    return status;
+}
+
+// arc_repair_block:
+// Corrects a single protected block in place by rewriting its data bytes and check bits within the encoded data stream
+// params:
+// layout       -   layout of the encoded data stream
+// block        -   index of the block to repair
+// encoded_data -   uint8_t encoded data stream
+// matrices     -   RS matrix cache (unused by other methods)
+// return:
+// status       -   status of the block before repair (ARC_BLOCK_CORRECTABLE blocks are clean afterwards)
+// note:
+// Packed blocks share trailer bytes with their neighbours, so blocks within the same group of 8 must not be repaired concurrently
+int arc_repair_block(struct arc_layout* layout, uint32_t block, uint8_t* encoded_data, int** matrices){
+    int status = arc_check_block(layout, block, encoded_data);
+    if (status != ARC_BLOCK_CORRECTABLE){
+        return status;
+    }
+    // Only Hamming, SECDED (at most 8 bytes) and RS (at most 256 devices) blocks are ever correctable
+    uint64_t corrected[256];
+    if (arc_decode_block(layout, block, encoded_data, (uint8_t*)corrected, matrices) == ARC_BLOCK_UNCORRECTABLE){
+        return ARC_BLOCK_UNCORRECTABLE;
+    }
+    arc_write_block(layout, block, (uint8_t*)corrected, encoded_data, matrices);
+    return ARC_BLOCK_CORRECTABLE;
+}
+
+// arc_update_block:
+// Replaces part of the data held by a single protected block and updates its check bits in place
+// params:
+// layout       -   layout of the encoded data stream
+// block        -   index of the block to update
+// encoded_data -   uint8_t encoded data stream
+// offset       -   offset of the updated range within the data stream
+// new_data     -   uint8_t replacement bytes for the whole updated range
+// length       -   number of bytes in the updated range
+// matrices     -   RS matrix cache (unused by other methods)
+// return:
+// status       -   status of the block before the update (ARC_BLOCK_UNCORRECTABLE blocks are left untouched)
+// note:
+// RS blocks only read and rewrite the changed data devices and the code devices, using the linearity of the code:
+// every code device changes by the coding matrix entry of a data device times that device's change.
+int arc_update_block(struct arc_layout* layout, uint32_t block, uint8_t* encoded_data, uint32_t offset, const uint8_t* new_data, uint32_t length, int** matrices){
+    uint32_t data_index, data_length, encoded_index;
+    arc_layout_block(layout, block, &data_index, &data_length, &encoded_index);
+    uint32_t start = (data_index < offset) ? offset : data_index;
+    uint32_t end = (data_index + data_length > offset + length) ? offset + length : data_index + data_length;
+    uint8_t* check = encoded_data + encoded_index;
+    uint8_t* payload = arc_layout_payload(layout, encoded_data, data_index, encoded_index);
+    uint32_t i, j, p;
+
+    if (layout->ecc_algorithm == RS_ID){
+        uint32_t code_devices = layout->ecc_parameter_b;
+        uint32_t current_block_data_devices = (data_length + 7) / 8;
+        uint32_t first_device = (start - data_index) / 8;
+        uint32_t last_device = (end - 1 - data_index) / 8;
+        int* matrix = matrices[current_block_data_devices];
+        uint8_t* device_check;
+        uint8_t* device_bytes;
+        uint32_t device_length;
+        // Only apply the delta when every device it touches is intact, otherwise correct and re-encode the whole block
+        int intact = 1;
+        for (i = 0; i < current_block_data_devices + code_devices && intact; i++){
+            if (i < first_device || (i > last_device && i < current_block_data_devices)){
+                continue;
+            }
+            arc_layout_rs_device(layout, check, payload, data_length, i, &device_check, &device_bytes, &device_length);
+            intact = (device_check[0] == arc_fast_parity(device_bytes, device_length));
+        }
+        if (intact){
+            for (i = first_device; i <= last_device; i++){
+                uint8_t delta[8] = {0};
+                arc_layout_rs_device(layout, check, payload, data_length, i, &device_check, &device_bytes, &device_length);
+                uint32_t device_start = data_index + (i * 8);
+                for (p = 0; p < device_length; p++){
+                    if (device_start + p >= start && device_start + p < end){
+                        delta[p] = device_bytes[p] ^ new_data[device_start + p - offset];
+                        device_bytes[p] = new_data[device_start + p - offset];
+                    }
+                }
+                device_check[0] = arc_fast_parity(device_bytes, device_length);
+                // Fold the change of this data device into every code device
+                for (j = 0; j < code_devices; j++){
+                    uint8_t* code_check;
+                    uint8_t* code_bytes;
+                    uint32_t code_length;
+                    int coefficient = matrix[(j * current_block_data_devices) + i];
+                    arc_layout_rs_device(layout, check, payload, data_length, current_block_data_devices + j, &code_check, &code_bytes, &code_length);
+                    for (p = 0; p < 8; p++){
+                        if (delta[p] != 0){
+                            code_bytes[p] ^= (uint8_t)galois_single_multiply(delta[p], coefficient, 8);
+                        }
+                    }
+                }
+            }
+            for (j = 0; j < code_devices; j++){
+                arc_layout_rs_device(layout, check, payload, data_length, current_block_data_devices + j, &device_check, &device_bytes, &device_length);
+                device_check[0] = arc_fast_parity(device_bytes, device_length);
+            }
+            return ARC_BLOCK_CLEAN;
+        }
+    }
+
+    // Correct the block, overlay the new bytes, and re-encode it
+    uint64_t storage[256];
+    uint8_t* block_data = (data_length <= sizeof(storage)) ? (uint8_t*)storage : (uint8_t*)malloc(data_length);
+    int status = arc_decode_block(layout, block, encoded_data, block_data, matrices);
+    if (status != ARC_BLOCK_UNCORRECTABLE){
+        memcpy(block_data + (start - data_index), new_data + (start - offset), end - start);
+        arc_write_block(layout, block, block_data, encoded_data, matrices);
+    }
+    if (block_data != (uint8_t*)storage){
+        free(block_data);
+    }
+    return status;
+}
+
+// arc_layout_payload_intact:
+// Determines whether the payload of a split layout still matches the CRC32C stored in its header
+// params:
+// layout       -   layout of the encoded data stream
+// encoded_data -   uint8_t encoded data stream
+// return:
+// intact       -   1 if the payload is stored contiguously and matches its checksum, 0 otherwise
+// note:
+// A single CRC pass runs at memory bandwidth, far faster than checking every block
+int arc_layout_payload_intact(struct arc_layout* layout, uint8_t* encoded_data){
+    if (!layout->payload_checksum_present || !layout->split || layout->external_payload){
+        return 0;
+    }
+    return (arc_crc32c(encoded_data + layout->metadata_length, layout->data_size) == layout->payload_checksum);
+}
+
+// arc_layout_decode:
+// Decodes every block of an encoded data stream using its layout
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// data                 -   address of pointer to decoded uint8_t data stream
+// data_size            -   address of pointer to decoded data stream size
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_layout_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** data, uint32_t* data_size){
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    *data_size = layout.data_size;
+    *data = (uint8_t*)malloc(sizeof(uint8_t) * *data_size);
+    // An intact payload needs no block checks
+    if (arc_layout_payload_intact(&layout, encoded_data)){
+        memcpy(*data, encoded_data + layout.metadata_length, layout.data_size);
+        return 1;
+    }
+    int* matrices[257] = {NULL};
+    if (layout.ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(&layout, matrices);
+    }
+
+    // Setup Loop Variables
+    uint32_t blocks_processed;
+    int decode_success = 1;
+    uint32_t threads = (layout.threads < 1) ? 1 : layout.threads;
+    int chunk_size = arc_schedule_chunk(layout.total_blocks, threads);
+    omp_set_num_threads(threads);
+
+    // Packed layouts are checked a group of 8 blocks at a time
+    if (layout.packed){
+        uint32_t groups_processed;
+        uint32_t total_groups = (layout.total_blocks + 7) / 8;
+        chunk_size = arc_schedule_chunk(total_groups, threads);
+        #pragma omp parallel
+        {
+            ARC_TRACE_BEGIN(decode_kernel);
+            #pragma omp for schedule(dynamic, chunk_size) nowait
+            for (groups_processed = 0; groups_processed < total_groups; groups_processed++){
+                if (arc_decode_group(&layout, groups_processed, encoded_data, *data, NULL) == ARC_BLOCK_UNCORRECTABLE){
+                    #pragma omp atomic write
+                    decode_success = 0;
+                }
+            }
+            ARC_TRACE_END(decode_kernel);
+        }
+    // Check, correct, and write out each block
+    } else {
+        #pragma omp parallel
+        {
+            ARC_TRACE_BEGIN(decode_kernel);
+            #pragma omp for schedule(dynamic, chunk_size) nowait
+            for (blocks_processed = 0; blocks_processed < layout.total_blocks; blocks_processed++){
+                uint32_t data_index, data_length, encoded_index;
+                arc_layout_block(&layout, blocks_processed, &data_index, &data_length, &encoded_index);
+                if (arc_decode_block(&layout, blocks_processed, encoded_data, *data + data_index, matrices) == ARC_BLOCK_UNCORRECTABLE){
+                    #pragma omp atomic write
+                    decode_success = 0;
+                }
+            }
+            ARC_TRACE_END(decode_kernel);
+        }
+    }
+    arc_rs_matrix_cache_free(matrices);
+
+    // Free decoded data and set data_size to 0 if decoding process failed
+    if (decode_success == 0){
+        printf("DATA INTEGRITY ERROR: Uncorrectable Block Found, Decoding Failed...\n");
+        free(*data);
+        *data_size = 0;
+    // Catch errors the blocks' codes missed or miscorrected
+    } else if (layout.payload_checksum_present && arc_crc32c(*data, *data_size) != layout.payload_checksum){
+        printf("DATA INTEGRITY ERROR: Payload Checksum Mismatch, Decoding Failed...\n");
+        free(*data);
+        *data_size = 0;
+        decode_success = 0;
+    }
+    return decode_success;
+}
+
+// arc_check_constraints:
+// Ensures the constraints handed to an encoding function are valid
+// params:
+// memory_constraint        -   maximum amount of memory overhead to introduce
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s
+// resiliency_count         -   Number of values set in resiliency constraint list
+// return:
+// err                      -   error code to determine if valid (1=valid,0=invalid)
+int arc_check_constraints(double memory_constraint, double throughput_constraint, int resiliency_count){
+    if (memory_constraint <= 0 && memory_constraint != ARC_ANY_SIZE){
+        printf("INVALID MEMORY CONSTRAINT: Please ensure memory constraint is ARC_ANY_SIZE or greater than 0. . .\n");
+        return 0;
+    }
+    if (throughput_constraint <= 0 && throughput_constraint != ARC_ANY_BW){
+        printf("INVALID TIME CONSTRAINT: Please ensure timing constraint is ARC_ANY_BW greater than 0. . .\n");
+        return 0;
+    }
+    if (resiliency_count <= 0){
+        printf("INVALID RESILIENCY CONSTRAINT: Please ensure resiliency constraint is at least [ARC_ANY_ECC] and resiliency_count is greater than 0. . .\n");
+        return 0;
+    }
+    return 1;
+}
+
+// ARC Asynchronous Section
+// #########################
+// ARC Asynchronous Ticket Struct
+// Tracks a single encode or decode request handed to the ARC worker pool
+struct arc_ticket {
+    int operation;
+    uint8_t* input;
+    uint32_t input_size;
+    double memory_constraint;
+    double throughput_constraint;
+    int* resiliency_constraint;
+    int resiliency_count;
+    arc_callback callback;
+    void* user_data;
+    uint8_t* result;
+    uint32_t result_size;
+    int err;
+    int complete;
+    struct arc_ticket* next;
+};
+// Asynchronous operation identifiers
+int ASYNC_ENCODE = 1;
+int ASYNC_DECODE = 2;
+// Worker pool state
+pthread_t* async_workers = NULL;
+int async_worker_count = 0;
+int async_shutdown = 0;
+struct arc_ticket* async_queue_head = NULL;
+struct arc_ticket* async_queue_tail = NULL;
+pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t async_queue_ready = PTHREAD_COND_INITIALIZER;
+pthread_cond_t async_ticket_complete = PTHREAD_COND_INITIALIZER;
+
+// arc_async_worker:
+// Worker thread loop that pulls tickets from the queue and completes them in order
+// params:
+// arg          -   unused
+void* arc_async_worker(void* arg){
+    (void)arg;
+    while (1){
+        // Wait for a ticket to work on
+        pthread_mutex_lock(&async_lock);
+        while (async_queue_head == NULL && !async_shutdown){
+            pthread_cond_wait(&async_queue_ready, &async_lock);
+        }
+        if (async_queue_head == NULL){
+            pthread_mutex_unlock(&async_lock);
+            break;
+        }
+        struct arc_ticket* ticket = async_queue_head;
+        async_queue_head = ticket->next;
+        if (async_queue_head == NULL){
+            async_queue_tail = NULL;
+        }
+        pthread_mutex_unlock(&async_lock);
+
+        // Run the requested operation
+        if (ticket->operation == ASYNC_ENCODE){
+            ticket->err = arc_encode(ticket->input, ticket->input_size, ticket->memory_constraint, ticket->throughput_constraint, 
+                ticket->resiliency_constraint, ticket->resiliency_count, &ticket->result, &ticket->result_size);
+        } else {
+            ticket->err = arc_decode(ticket->input, ticket->input_size, &ticket->result, &ticket->result_size);
+        }
+        if (ticket->err == 0){
+            ticket->result = NULL;
+            ticket->result_size = 0;
+        }
+        // Notify the user before marking the ticket complete so the ticket stays valid during the callback
+        if (ticket->callback != NULL){
+            ticket->callback(ticket->err, ticket->result, ticket->result_size, ticket->user_data);
+        }
+
+        // Mark ticket as complete
+        pthread_mutex_lock(&async_lock);
+        ticket->complete = 1;
+        pthread_cond_broadcast(&async_ticket_complete);
+        pthread_mutex_unlock(&async_lock);
+    }
+    return NULL;
+}
+
+// arc_async_submit:
+// Places a ticket on the worker queue, starting the worker pool if needed
+// params:
+// ticket       -   ticket to queue
+// return:
+// err          -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_async_submit(struct arc_ticket* ticket){
+    int i;
+    pthread_mutex_lock(&async_lock);
+    // Start worker pool on first use
+    if (async_worker_count == 0){
+        int worker_count = (ARC_ASYNC_THREADS > 0) ? ARC_ASYNC_THREADS : 1;
+        async_workers = talloc(pthread_t, worker_count);
+        async_shutdown = 0;
+        for (i = 0; i < worker_count; i++){
+            if (pthread_create(&async_workers[i], NULL, arc_async_worker, NULL) != 0){
+                break;
+            }
+            async_worker_count++;
+        }
+        if (async_worker_count == 0){
+            free(async_workers);
+            async_workers = NULL;
+            pthread_mutex_unlock(&async_lock);
+            printf("Asynchronous Error: Unable to start ARC worker threads\n");
+            return 0;
+        }
+    }
+    // Add ticket to the end of the queue
+    ticket->next = NULL;
+    if (async_queue_tail == NULL){
+        async_queue_head = ticket;
+    } else {
+        async_queue_tail->next = ticket;
+    }
+    async_queue_tail = ticket;
+    pthread_cond_signal(&async_queue_ready);
+    pthread_mutex_unlock(&async_lock);
+    return 1;
+}
+
+// arc_async_stop:
+// Completes any queued tickets and joins the worker pool
+void arc_async_stop(){
+    int i;
+    pthread_mutex_lock(&async_lock);
+    if (async_worker_count == 0){
+        pthread_mutex_unlock(&async_lock);
+        return;
+    }
+    async_shutdown = 1;
+    pthread_cond_broadcast(&async_queue_ready);
+    pthread_mutex_unlock(&async_lock);
+    for (i = 0; i < async_worker_count; i++){
+        pthread_join(async_workers[i], NULL);
+    }
+    free(async_workers);
+    async_workers = NULL;
+    async_worker_count = 0;
+}
+
+// arc_encode_async:
+// Queue an arc_encode call on the ARC worker pool and return immediately
+// params:
+// data                     -   uint8_t data stream (must stay valid until the ticket completes)
+// data_size                -   size of data stream
+// memory_constraint        -   maximum amount of memory overhead to introduce (1 - (encoded_size/original_size))
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// callback                 -   optional function called from the worker thread once encoding finishes (NULL for none)
+// user_data                -   pointer handed back to the callback
+// return:
+// ticket                   -   ticket to poll or wait on (NULL if the request could not be queued)
+struct arc_ticket* arc_encode_async(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, arc_callback callback, void* user_data){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return NULL;
+    }
+    if (arc_check_constraints(memory_constraint, throughput_constraint, resiliency_count) == 0){
+        return NULL;
+    }
+    struct arc_ticket* ticket = talloc(struct arc_ticket, 1);
+    memset(ticket, 0, sizeof(struct arc_ticket));
+    ticket->operation = ASYNC_ENCODE;
+    ticket->input = data;
+    ticket->input_size = data_size;
+    ticket->memory_constraint = memory_constraint;
+    ticket->throughput_constraint = throughput_constraint;
+    // Keep a private copy of the resiliency constraint list
+    ticket->resiliency_constraint = talloc(int, resiliency_count);
+    memcpy(ticket->resiliency_constraint, resiliency_constraint, sizeof(int) * resiliency_count);
+    ticket->resiliency_count = resiliency_count;
+    ticket->callback = callback;
+    ticket->user_data = user_data;
+    if (arc_async_submit(ticket) == 0){
+        free(ticket->resiliency_constraint);
+        free(ticket);
+        return NULL;
+    }
+    return ticket;
+}
+
+// arc_decode_async:
+// Queue an arc_decode call on the ARC worker pool and return immediately
+// params:
+// encoded_data         -   uint8_t arc encoded data stream (must stay valid until the ticket completes)
+// encoded_data_size    -   size of arc encoded data stream
+// callback             -   optional function called from the worker thread once decoding finishes (NULL for none)
+// user_data            -   pointer handed back to the callback
+// return:
+// ticket               -   ticket to poll or wait on (NULL if the request could not be queued)
+struct arc_ticket* arc_decode_async(uint8_t* encoded_data, uint32_t encoded_data_size, arc_callback callback, void* user_data){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return NULL;
+    }
+    struct arc_ticket* ticket = talloc(struct arc_ticket, 1);
+    memset(ticket, 0, sizeof(struct arc_ticket));
+    ticket->operation = ASYNC_DECODE;
+    ticket->input = encoded_data;
+    ticket->input_size = encoded_data_size;
+    ticket->callback = callback;
+    ticket->user_data = user_data;
+    if (arc_async_submit(ticket) == 0){
+        free(ticket);
+        return NULL;
+    }
+    return ticket;
+}
+
+// arc_poll:
+// Check whether an asynchronous request has finished without blocking
+// params:
+// ticket       -   ticket returned by arc_encode_async or arc_decode_async
+// return:
+// complete     -   1 if the request has finished (arc_wait will not block), 0 otherwise
+int arc_poll(struct arc_ticket* ticket){
+    int complete;
+    pthread_mutex_lock(&async_lock);
+    complete = ticket->complete;
+    pthread_mutex_unlock(&async_lock);
+    return complete;
+}
+
+// arc_wait:
+// Block until an asynchronous request has finished, hand back its result, and release the ticket
+// params:
+// ticket           -   ticket returned by arc_encode_async or arc_decode_async
+// result_data      -   address of pointer to resulting encoded or decoded data stream (may be NULL to discard the result)
+// result_data_size -   address of resulting data stream size (may be NULL)
+// return:
+// err              -   error code of the underlying arc_encode or arc_decode call (1=sucessful,0=unsucessful)
+// note:
+// Every ticket must be released with exactly one call to arc_wait. The result data stream is owned
+// by the caller and must be freed by the caller once it is no longer needed.
+int arc_wait(struct arc_ticket* ticket, uint8_t** result_data, uint32_t* result_data_size){
+    pthread_mutex_lock(&async_lock);
+    while (!ticket->complete){
+        pthread_cond_wait(&async_ticket_complete, &async_lock);
+    }
+    pthread_mutex_unlock(&async_lock);
+
+    int err = ticket->err;
+    if (result_data != NULL){
+        *result_data = ticket->result;
+    // Nobody takes ownership of the result, so release it here
+    } else {
+        free(ticket->result);
+    }
+    if (result_data_size != NULL){
+        *result_data_size = ticket->result_size;
+    }
+    if (ticket->resiliency_constraint != NULL){
+        free(ticket->resiliency_constraint);
+    }
+    free(ticket);
+    return err;
+}
+
+// ARC Pipeline Section
+// #########################
+// ARC Pipeline Slab Struct
+// A single slab moving between pipeline stages
+struct arc_pipeline_slab {
+    uint32_t slab;
+    uint8_t* data;
+    uint32_t data_size;
+};
+// ARC Pipeline Queue Struct
+// Bounded FIFO queue connecting two pipeline stages
+struct arc_pipeline_queue {
+    struct arc_pipeline_slab* slots;
+    uint32_t depth;
+    uint32_t head;
+    uint32_t count;
+    int closed;
+    int aborted;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+};
+// ARC Pipeline Struct
+// Shared state handed to each pipeline stage
+struct arc_pipeline_state {
+    uint32_t slab_count;
+    arc_pipeline_compress_fn compress;
+    arc_pipeline_write_fn write;
+    void* user_data;
+    double memory_constraint;
+    double throughput_constraint;
+    int* resiliency_constraint;
+    int resiliency_count;
+    struct arc_pipeline_queue compressed;
+    struct arc_pipeline_queue encoded;
+    // Set by any stage that fails, accessed with __atomic builtins since every stage polls it
+    int failed;
+};
+
+// arc_pipeline_queue_init:
+// Sets up an empty bounded queue
+// params:
+// queue        -   queue to set up
+// depth        -   maximum number of slabs held at once
+void arc_pipeline_queue_init(struct arc_pipeline_queue* queue, uint32_t depth){
+    queue->slots = talloc(struct arc_pipeline_slab, depth);
+    queue->depth = depth;
+    queue->head = 0;
+    queue->count = 0;
+    queue->closed = 0;
+    queue->aborted = 0;
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->not_empty, NULL);
+    pthread_cond_init(&queue->not_full, NULL);
+}
+
+// arc_pipeline_queue_free:
+// Frees any slabs left in a queue along with the queue itself
+// params:
+// queue        -   queue to free
+void arc_pipeline_queue_free(struct arc_pipeline_queue* queue){
+    while (queue->count > 0){
+        free(queue->slots[queue->head].data);
+        queue->head = (queue->head + 1) % queue->depth;
+        queue->count--;
+    }
+    free(queue->slots);
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+}
+
+// arc_pipeline_queue_push:
+// Adds a slab to the queue, blocking while the queue is full
+// params:
+// queue        -   queue to add to
+// slab         -   slab to add
+// return:
+// err          -   error code to determine if sucessful (1=sucessful,0=consumer has stopped)
+int arc_pipeline_queue_push(struct arc_pipeline_queue* queue, struct arc_pipeline_slab slab){
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->depth && !queue->aborted){
+        pthread_cond_wait(&queue->not_full, &queue->lock);
+    }
+    if (queue->aborted){
+        pthread_mutex_unlock(&queue->lock);
+        return 0;
+    }
+    queue->slots[(queue->head + queue->count) % queue->depth] = slab;
+    queue->count++;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+    return 1;
+}
+
+// arc_pipeline_queue_pop:
+// Removes the oldest slab from the queue, blocking while the queue is empty
+// params:
+// queue        -   queue to remove from
+// slab         -   address to place removed slab
+// return:
+// err          -   error code to determine if sucessful (1=sucessful,0=queue closed and empty)
+int arc_pipeline_queue_pop(struct arc_pipeline_queue* queue, struct arc_pipeline_slab* slab){
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0 && !queue->closed){
+        pthread_cond_wait(&queue->not_empty, &queue->lock);
+    }
+    if (queue->count == 0){
+        pthread_mutex_unlock(&queue->lock);
+        return 0;
+    }
+    *slab = queue->slots[queue->head];
+    queue->head = (queue->head + 1) % queue->depth;
+    queue->count--;
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+    return 1;
+}
+
+// arc_pipeline_queue_close:
+// Marks that the producer will add no more slabs
+// params:
+// queue        -   queue to close
+void arc_pipeline_queue_close(struct arc_pipeline_queue* queue){
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = 1;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+// arc_pipeline_queue_abort:
+// Marks that the consumer will take no more slabs so the producer stops waiting
+// params:
+// queue        -   queue to abort
+void arc_pipeline_queue_abort(struct arc_pipeline_queue* queue){
+    pthread_mutex_lock(&queue->lock);
+    queue->aborted = 1;
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+// arc_pipeline_compress_stage:
+// Pipeline stage that compresses each slab in order
+// params:
+// arg          -   pipeline state
+void* arc_pipeline_compress_stage(void* arg){
+    struct arc_pipeline_state* state = (struct arc_pipeline_state*)arg;
+    uint32_t i;
+    for (i = 0; i < state->slab_count && !__atomic_load_n(&state->failed, __ATOMIC_ACQUIRE); i++){
+        struct arc_pipeline_slab slab;
+        slab.slab = i;
+        slab.data = NULL;
+        slab.data_size = 0;
+        if (state->compress(i, state->user_data, &slab.data, &slab.data_size) == 0){
+            printf("Pipeline Error: Compression of slab %" PRIu32 " failed\n", i);
+            __atomic_store_n(&state->failed, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        if (arc_pipeline_queue_push(&state->compressed, slab) == 0){
+            free(slab.data);
+            break;
+        }
+    }
+    arc_pipeline_queue_close(&state->compressed);
+    return NULL;
+}
+
+// arc_pipeline_protect_stage:
+// Pipeline stage that ARC encodes each compressed slab
+// params:
+// arg          -   pipeline state
+void* arc_pipeline_protect_stage(void* arg){
+    struct arc_pipeline_state* state = (struct arc_pipeline_state*)arg;
+    struct arc_pipeline_slab slab;
+    while (!__atomic_load_n(&state->failed, __ATOMIC_ACQUIRE) && arc_pipeline_queue_pop(&state->compressed, &slab)){
+        struct arc_pipeline_slab encoded_slab;
+        encoded_slab.slab = slab.slab;
+        int err = arc_encode(slab.data, slab.data_size, state->memory_constraint, state->throughput_constraint, 
+            state->resiliency_constraint, state->resiliency_count, &encoded_slab.data, &encoded_slab.data_size);
+        free(slab.data);
+        if (err == 0){
+            printf("Pipeline Error: Encoding of slab %" PRIu32 " failed\n", slab.slab);
+            __atomic_store_n(&state->failed, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        if (arc_pipeline_queue_push(&state->encoded, encoded_slab) == 0){
+            free(encoded_slab.data);
+            break;
+        }
+    }
+    // Stop the compression stage if this stage ended early
+    arc_pipeline_queue_abort(&state->compressed);
+    arc_pipeline_queue_close(&state->encoded);
+    return NULL;
+}
+
+// arc_pipeline:
+// Compresses, ARC encodes, and writes a series of slabs with all three stages running concurrently.
+// While slab i is being ARC encoded, slab i+1 is being compressed and slab i-1 is being written.
+// params:
+// slab_count               -   number of slabs to process
+// queue_depth              -   maximum number of slabs waiting between two stages
+// compress                 -   function producing the compressed form of a slab in a malloc'd buffer (ARC frees it)
+// write                    -   function handed each ARC encoded slab in slab order (ARC frees the buffer afterwards)
+// user_data                -   pointer handed to compress and write
+// memory_constraint        -   maximum amount of memory overhead to introduce (1 - (encoded_size/original_size))
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// return:
+// err                      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_pipeline(uint32_t slab_count, uint32_t queue_depth, arc_pipeline_compress_fn compress, arc_pipeline_write_fn write, void* user_data, 
+    double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    if (compress == NULL || write == NULL){
+        printf("Pipeline Error: Both a compress and a write function are required\n");
+        return 0;
+    }
+    if (arc_check_constraints(memory_constraint, throughput_constraint, resiliency_count) == 0){
+        return 0;
+    }
+    if (queue_depth < 1){
+        queue_depth = 1;
+    }
+
+    // Set up shared pipeline state
+    struct arc_pipeline_state state;
+    state.slab_count = slab_count;
+    state.compress = compress;
+    state.write = write;
+    state.user_data = user_data;
+    state.memory_constraint = memory_constraint;
+    state.throughput_constraint = throughput_constraint;
+    state.resiliency_constraint = resiliency_constraint;
+    state.resiliency_count = resiliency_count;
+    state.failed = 0;
+    arc_pipeline_queue_init(&state.compressed, queue_depth);
+    arc_pipeline_queue_init(&state.encoded, queue_depth);
+
+    // Start compression and protection stages
+    pthread_t compress_thread, protect_thread;
+    if (pthread_create(&compress_thread, NULL, arc_pipeline_compress_stage, &state) != 0){
+        printf("Pipeline Error: Unable to start compression stage\n");
+        arc_pipeline_queue_free(&state.compressed);
+        arc_pipeline_queue_free(&state.encoded);
+        return 0;
+    }
+    if (pthread_create(&protect_thread, NULL, arc_pipeline_protect_stage, &state) != 0){
+        printf("Pipeline Error: Unable to start protection stage\n");
+        __atomic_store_n(&state.failed, 1, __ATOMIC_RELEASE);
+        arc_pipeline_queue_abort(&state.compressed);
+        pthread_join(compress_thread, NULL);
+        arc_pipeline_queue_free(&state.compressed);
+        arc_pipeline_queue_free(&state.encoded);
+        return 0;
+    }
+
+    // Write stage runs on the calling thread
+    double start = arc_monotonic_seconds();
+    struct arc_pipeline_slab slab;
+    uint32_t written = 0;
+    while (!__atomic_load_n(&state.failed, __ATOMIC_ACQUIRE) && arc_pipeline_queue_pop(&state.encoded, &slab)){
+        int err = write(slab.slab, slab.data, slab.data_size, user_data);
+        free(slab.data);
+        if (err == 0){
+            printf("Pipeline Error: Writing of slab %" PRIu32 " failed\n", slab.slab);
+            __atomic_store_n(&state.failed, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        written++;
+    }
+    // Stop the protection stage if this stage ended early
+    arc_pipeline_queue_abort(&state.encoded);
+    pthread_join(protect_thread, NULL);
+    pthread_join(compress_thread, NULL);
+    double stop = arc_monotonic_seconds();
+    if(PRINT)
+        printf("Pipeline: %" PRIu32 " of %" PRIu32 " slabs written in %lf seconds\n", written, slab_count, stop - start);
+
+    // Free anything left between stages
+    arc_pipeline_queue_free(&state.compressed);
+    arc_pipeline_queue_free(&state.encoded);
+    if (__atomic_load_n(&state.failed, __ATOMIC_ACQUIRE) || written != slab_count){
+        return 0;
+    }
+    return 1;
+}
+
+// ARC Scrubber Section
+// #####################
+// ARC Scrubber Entry Struct
+// A registered encoded data stream and how far the scrubber has walked through it
+struct arc_scrub_entry {
+    uint8_t* encoded_data;
+    uint32_t encoded_data_size;
+    struct arc_layout layout;
+    int** matrices;
+    uint32_t next_block;
+    uint32_t correctable;
+    uint32_t uncorrectable;
+};
+// ARC Scrubber Struct
+// Background thread periodically verifying (and optionally repairing) registered encoded data streams
+struct arc_scrubber {
+    double bytes_per_second;
+    double pass_interval;
+    int repair;
+    arc_scrub_callback callback;
+    void* user_data;
+    struct arc_scrub_entry* entries;
+    uint32_t entry_count;
+    uint32_t entry_capacity;
+    uint32_t cursor;
+    int shutdown;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+};
+// Number of data bytes the scrubber verifies between throttling decisions
+uint32_t SCRUB_SLICE_SIZE = 65536;
+
+// arc_scrubber_sleep:
+// Waits on the scrubber's wake condition until the given monotonic time or until shutdown (lock must be held)
+// params:
+// scrubber     -   scrubber to wait on
+// until        -   monotonic time in seconds to wake up at
+void arc_scrubber_sleep(struct arc_scrubber* scrubber, double until){
+    struct timespec deadline;
+    deadline.tv_sec = (time_t)until;
+    deadline.tv_nsec = (long)((until - (double)deadline.tv_sec) * 1E9);
+    while (!scrubber->shutdown && arc_monotonic_seconds() < until){
+        if (pthread_cond_timedwait(&scrubber->wake, &scrubber->lock, &deadline) != 0){
+            break;
+        }
+    }
+}
+
+// arc_scrubber_thread:
+// Scrubber thread loop that walks every registered data stream a slice at a time within the byte budget
+// params:
+// arg          -   scrubber to run
+void* arc_scrubber_thread(void* arg){
+    struct arc_scrubber* scrubber = (struct arc_scrubber*)arg;
+#ifdef __linux__
+    // Run at the lowest priority so the scrubber only uses otherwise idle cycles
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 19);
+#endif
+    pthread_mutex_lock(&scrubber->lock);
+    double budget_start = arc_monotonic_seconds();
+    double budget_bytes = 0;
+    while (!scrubber->shutdown){
+        // Wait for a data stream to scrub
+        if (scrubber->entry_count == 0){
+            pthread_cond_wait(&scrubber->wake, &scrubber->lock);
+            budget_start = arc_monotonic_seconds();
+            budget_bytes = 0;
+            continue;
+        }
+        if (scrubber->cursor >= scrubber->entry_count){
+            // Every data stream has been scrubbed, rest until the next pass
+            scrubber->cursor = 0;
+            if (scrubber->pass_interval > 0){
+                arc_scrubber_sleep(scrubber, arc_monotonic_seconds() + scrubber->pass_interval);
+            }
+            budget_start = arc_monotonic_seconds();
+            budget_bytes = 0;
+            continue;
+        }
+
+        // Verify the next slice of the current data stream
+        struct arc_scrub_entry* entry = &scrubber->entries[scrubber->cursor];
+        uint32_t slice_bytes = 0;
+        while (entry->next_block < entry->layout.total_blocks && slice_bytes < SCRUB_SLICE_SIZE){
+            uint32_t data_index, data_length, encoded_index;
+            arc_layout_block(&entry->layout, entry->next_block, &data_index, &data_length, &encoded_index);
+            int status;
+            if (scrubber->repair){
+                status = arc_repair_block(&entry->layout, entry->next_block, entry->encoded_data, entry->matrices);
+            } else {
+                status = arc_check_block(&entry->layout, entry->next_block, entry->encoded_data);
+            }
+            if (status == ARC_BLOCK_CORRECTABLE){
+                entry->correctable++;
+            } else if (status == ARC_BLOCK_UNCORRECTABLE){
+                entry->uncorrectable++;
+            }
+            slice_bytes = slice_bytes + data_length;
+            entry->next_block++;
+        }
+        budget_bytes = budget_bytes + slice_bytes;
+
+        // Report any errors found once the whole data stream has been walked
+        if (entry->next_block >= entry->layout.total_blocks){
+            uint8_t* encoded_data = entry->encoded_data;
+            uint32_t encoded_data_size = entry->encoded_data_size;
+            uint32_t correctable = entry->correctable;
+            uint32_t uncorrectable = entry->uncorrectable;
+            entry->next_block = 0;
+            entry->correctable = 0;
+            entry->uncorrectable = 0;
+            scrubber->cursor++;
+            if ((correctable > 0 || uncorrectable > 0) && scrubber->callback != NULL){
+                // The callback may register or unregister data streams
+                pthread_mutex_unlock(&scrubber->lock);
+                scrubber->callback(encoded_data, encoded_data_size, correctable, uncorrectable, scrubber->user_data);
+                pthread_mutex_lock(&scrubber->lock);
+            }
+        }
+
+        // Stay within the byte budget
+        if (scrubber->bytes_per_second > 0){
+            arc_scrubber_sleep(scrubber, budget_start + (budget_bytes / scrubber->bytes_per_second));
+        }
+    }
+    pthread_mutex_unlock(&scrubber->lock);
+    return NULL;
+}
+
+// arc_scrubber_create:
+// Starts a background scrubber that periodically verifies registered encoded data streams on a low priority thread
+// params:
+// bytes_per_second -   maximum number of data bytes verified per second (ARC_ANY_BW for no limit)
+// pass_interval    -   seconds to rest after every registered data stream has been verified (0 to start over at once)
+// repair           -   1 to rewrite correctable blocks in place (see arc_repair), 0 to only verify them
+// callback         -   function called after a pass over a data stream finds errors (may be NULL)
+// user_data        -   pointer handed to the callback
+// return:
+// scrubber         -   scrubber handle (NULL on failure)
+struct arc_scrubber* arc_scrubber_create(double bytes_per_second, double pass_interval, int repair, arc_scrub_callback callback, void* user_data){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return NULL;
+    }
+    if (bytes_per_second <= 0 && bytes_per_second != ARC_ANY_BW){
+        printf("INVALID SCRUB BUDGET: Please ensure the budget is ARC_ANY_BW or greater than 0. . .\n");
+        return NULL;
+    }
+    struct arc_scrubber* scrubber = talloc(struct arc_scrubber, 1);
+    scrubber->bytes_per_second = bytes_per_second;
+    scrubber->pass_interval = pass_interval;
+    scrubber->repair = repair;
+    scrubber->callback = callback;
+    scrubber->user_data = user_data;
+    scrubber->entries = NULL;
+    scrubber->entry_count = 0;
+    scrubber->entry_capacity = 0;
+    scrubber->cursor = 0;
+    scrubber->shutdown = 0;
+    pthread_mutex_init(&scrubber->lock, NULL);
+    // Timed waits are measured against the monotonic clock
+    pthread_condattr_t wake_attributes;
+    pthread_condattr_init(&wake_attributes);
+    pthread_condattr_setclock(&wake_attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&scrubber->wake, &wake_attributes);
+    pthread_condattr_destroy(&wake_attributes);
+    if (pthread_create(&scrubber->thread, NULL, arc_scrubber_thread, scrubber) != 0){
+        printf("Scrubber Error: Unable to start scrubber thread\n");
+        pthread_mutex_destroy(&scrubber->lock);
+        pthread_cond_destroy(&scrubber->wake);
+        free(scrubber);
+        return NULL;
+    }
+    return scrubber;
+}
+
+// arc_scrubber_register:
+// Adds an encoded data stream to the set walked by a scrubber
+// params:
+// scrubber             -   scrubber handle
+// encoded_data         -   uint8_t arc encoded data stream (must stay valid until unregistered)
+// encoded_data_size    -   size of arc encoded data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// The data stream must not be modified by the caller while registered to a repairing scrubber
+int arc_scrubber_register(struct arc_scrubber* scrubber, uint8_t* encoded_data, uint32_t encoded_data_size){
+    struct arc_scrub_entry entry;
+    if (arc_layout_read(encoded_data, encoded_data_size, &entry.layout) == 0){
+        return 0;
+    }
+    entry.encoded_data = encoded_data;
+    entry.encoded_data_size = encoded_data_size;
+    entry.next_block = 0;
+    entry.correctable = 0;
+    entry.uncorrectable = 0;
+    entry.matrices = NULL;
+    if (entry.layout.ecc_algorithm == RS_ID && scrubber->repair){
+        entry.matrices = (int**)calloc(257, sizeof(int*));
+        arc_rs_matrix_cache_create(&entry.layout, entry.matrices);
+    }
+
+    pthread_mutex_lock(&scrubber->lock);
+    if (scrubber->entry_count == scrubber->entry_capacity){
+        scrubber->entry_capacity = (scrubber->entry_capacity == 0) ? 8 : scrubber->entry_capacity * 2;
+        scrubber->entries = (struct arc_scrub_entry*)realloc(scrubber->entries, scrubber->entry_capacity * sizeof(struct arc_scrub_entry));
+    }
+    scrubber->entries[scrubber->entry_count] = entry;
+    scrubber->entry_count++;
+    pthread_cond_broadcast(&scrubber->wake);
+    pthread_mutex_unlock(&scrubber->lock);
+    return 1;
+}
+
+// arc_scrubber_unregister:
+// Removes an encoded data stream from a scrubber, once this returns the scrubber no longer touches it
+// params:
+// scrubber             -   scrubber handle
+// encoded_data         -   uint8_t arc encoded data stream that was registered
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=not registered)
+int arc_scrubber_unregister(struct arc_scrubber* scrubber, uint8_t* encoded_data){
+    uint32_t i;
+    int found = 0;
+    pthread_mutex_lock(&scrubber->lock);
+    for (i = 0; i < scrubber->entry_count; i++){
+        if (scrubber->entries[i].encoded_data == encoded_data){
+            if (scrubber->entries[i].matrices != NULL){
+                arc_rs_matrix_cache_free(scrubber->entries[i].matrices);
+                free(scrubber->entries[i].matrices);
+            }
+            memmove(&scrubber->entries[i], &scrubber->entries[i + 1], (scrubber->entry_count - i - 1) * sizeof(struct arc_scrub_entry));
+            scrubber->entry_count--;
+            // Keep the scrubber on the data stream it was walking
+            if (i < scrubber->cursor){
+                scrubber->cursor--;
+            }
+            found = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&scrubber->lock);
+    return found;
+}
+
+// arc_scrubber_destroy:
+// Stops a scrubber, waiting for the slice it is verifying to finish, and frees it
+// params:
+// scrubber     -   scrubber handle
+// return:
+// x            -   Success=1, Failure=0
+int arc_scrubber_destroy(struct arc_scrubber* scrubber){
+    uint32_t i;
+    pthread_mutex_lock(&scrubber->lock);
+    scrubber->shutdown = 1;
+    pthread_cond_broadcast(&scrubber->wake);
+    pthread_mutex_unlock(&scrubber->lock);
+    pthread_join(scrubber->thread, NULL);
+    for (i = 0; i < scrubber->entry_count; i++){
+        if (scrubber->entries[i].matrices != NULL){
+            arc_rs_matrix_cache_free(scrubber->entries[i].matrices);
+            free(scrubber->entries[i].matrices);
+        }
+    }
+    free(scrubber->entries);
+    pthread_mutex_destroy(&scrubber->lock);
+    pthread_cond_destroy(&scrubber->wake);
+    free(scrubber);
+    return 1;
+}
+
+// ARC Utility Section
+// ###################
+// arc_help:
+// Prints usage information out for the user
+void arc_help(){
+    printf("ARC Help not supported at this time...\n");
+    return;
+}
+
+// arc_resource_init:
+// Loads required resource files for encoding
+// return:
+// x        -   Success=1, Failure=0
+int arc_resource_init(){
+    FILE *fp;
+    int i;
+    char * resource_file = "Hamming_SECDED_1_Parity_Matrix";
+    // Setup H_S_1_Parity_Matrix with resources file
+    char * file_location = concat(resource_location, resource_file);
+    fp = fopen(file_location, "r");
+    if(fp == NULL){
+        printf("Error opening res/Hamming_SECDED_1_Parity_Matrix\n");
+        return 0;
+    }
+    uint8_t Parity_1;
+    for (i = 0; i < 4; i++){
+        fscanf(fp, "%hhX", &Parity_1);
+        H_S_1_Parity_Matrix[i] = Parity_1;
+    }
+    fclose(fp);
+    free(file_location);
+
+    // Setup H_1_Syndrome_Table with resources file
+    resource_file = "Hamming_1_Syndrome_Table";
+    file_location = concat(resource_location, resource_file);
+    fp = fopen(file_location, "r");
+    if(fp == NULL){
+        printf("Error opening res/Hamming_1_Syndrome_Table\n");
+        return 0;
+    }
+    uint8_t Snydrome_1;
+    for (i = 0; i < 16; i++){
+        fscanf(fp, "%hhX", &Snydrome_1);
+        H_1_Syndrome_Table[i] = Snydrome_1;
+    }
+    fclose(fp);
+    free(file_location);
+
+    // Setup S_1_Syndrome_Table with resources file
+    resource_file = "SECDED_1_Syndrome_Table";
+    file_location = concat(resource_location, resource_file);
+    fp = fopen(file_location, "r");
+    if(fp == NULL){
+        printf("Error opening res/SECDED_1_Syndrome_Table\n");
+        return 0;
+    }
+    for (i = 0; i < 16; i++){
+        fscanf(fp, "%hhX", &Snydrome_1);
+        S_1_Syndrome_Table[i] = Snydrome_1;
+    }
+    fclose(fp);
+    free(file_location);
+
+    // Setup H_S_8_Parity_Matrix with resources file
+    resource_file = "Hamming_SECDED_8_Parity_Matrix";
+    file_location = concat(resource_location, resource_file);
+    fp = fopen(file_location, "r");
+    if(fp == NULL){
+        printf("Error opening res/Hamming_SECDED_8_Parity_Matrix\n");
+        return 0;
+    }
+    uint64_t Parity_8;
+    for (i = 0; i < 7; i++){
+        fscanf(fp, "%"PRIx64, &Parity_8);
+        H_S_8_Parity_Matrix[i] = Parity_8;
+    }
+    fclose(fp);
+    free(file_location);
+
+    // Setup H_8_Syndrome_Table with resources file
+    resource_file = "Hamming_8_Syndrome_Table";
+    file_location = concat(resource_location, resource_file);
+    fp = fopen(file_location, "r");
+    if(fp == NULL){
+        printf("Error opening res/Hamming_8_Syndrome_Table\n");
+        return 0;
+    }
+    uint8_t Snydrome_8;
+    for (i = 0; i < 72; i++){
+        fscanf(fp, "%hhX", &Snydrome_8);
+        H_8_Syndrome_Table[i] = Snydrome_8;
+    }
+    fclose(fp);
+    free(file_location);
+
+    // Setup S_8_Syndrome_Table with resources file
+    resource_file = "SECDED_8_Syndrome_Table";
+    file_location = concat(resource_location, resource_file);
+    fp = fopen(file_location, "r");
+    if(fp == NULL){
+        printf("Error opening res/SECDED_8_Syndrome_Table\n");
+        return 0;
+    }
+    for (i = 0; i < 72; i++){
+        fscanf(fp, "%hhX", &Snydrome_8);
+        S_8_Syndrome_Table[i] = Snydrome_8;
+    }
+    fclose(fp);
+    free(file_location);
+
+    // Set INIT to True
+    if(PRINT)
+        printf("ARC Resource Files Initialized\n");
+    INIT = 1;
+    return 1;
+}
+
+// arc_scheduler_init:
+// Loads the decode scheduler chunk size from cache. If it is not available, train it by timing
+// decodes where all correctable errors are clustered within one region of the data
+// params:
+// data         -   simulated data stream to train with
+// data_size    -   size of simulated data stream
+// return:
+// x            -   Success=1, Failure=0
+int arc_scheduler_init(uint8_t* data, uint32_t data_size){
+    FILE *fp;
+    int i, j;
+    char * scheduler_file_location = concat(cache_resource_location, scheduler_resource_file);
+    fp = fopen(scheduler_file_location, "r");
+
+    // If the file exists, pull in the chunk size for the current number of threads
+    if (fp != NULL){
+        int found = 0;
+        uint32_t tmp_th;
+        int tmp_chunk;
+        char *buffer = NULL;
+        size_t len = 0;
+        ssize_t read;
+        while ((read = getline(&buffer, &len, fp)) != -1) {
+            // Skip the first line
+            if(!starts_with(buffer, "num_threads")){
+                sscanf(buffer, "%" SCNu32 ",%d", &tmp_th, &tmp_chunk);
+                if (tmp_th == AVAIL_THREADS && tmp_chunk > 0){
+                    SCHEDULE_CHUNK_SIZE = tmp_chunk;
+                    found = 1;
+                }
+            }
+        }
+        fclose(fp);
+        if (buffer){
+            free(buffer);
+        }
+        if (found){
+            free(scheduler_file_location);
+            return 1;
+        }
+    }
+
+    // Otherwise train the scheduler: encode with SECDED over 8 byte blocks
+    int err;
+    uint8_t *encoded;
+    uint32_t encoded_size;
+    uint8_t *decoded;
+    uint32_t decoded_size;
+    err = arc_secded_encode(data, data_size, 8, AVAIL_THREADS, &encoded, &encoded_size);
+    if (err == 0){
+        free(scheduler_file_location);
+        return 0;
+    }
+    // Flip a single data bit in every block of the first quarter of the stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded, encoded_size, &layout) == 0){
+        free(encoded);
+        free(scheduler_file_location);
+        return 0;
+    }
+    uint32_t corrupted_blocks = layout.block_count / 4;
+    uint32_t k;
+    for (k = 0; k < corrupted_blocks; k++){
+        uint32_t data_index, data_length, encoded_index;
+        arc_layout_block(&layout, k, &data_index, &data_length, &encoded_index);
+        uint8_t* payload = arc_layout_payload(&layout, encoded, data_index, encoded_index);
+        if (payload != NULL){
+            payload[0] ^= 0x01;
+        }
+    }
+
+    // Time each candidate chunk size and keep the fastest
+    double start, stop;
+    double best_time = -1;
+    int best_chunk = SCHEDULE_CHUNK_SIZE;
+    for (i = 0; i < num_schedule_chunk_candidates; i++){
+        SCHEDULE_CHUNK_SIZE = schedule_chunk_candidates[i];
+        for (j = 0; j < 3; j++){
+            start = arc_monotonic_seconds();
+            err = arc_secded_decode(encoded, encoded_size, &decoded, &decoded_size);
+            stop = arc_monotonic_seconds();
+            // A failed decode says nothing about the chunk size, skip it
+            if (err == 0){
+                continue;
+            }
+            free(decoded);
+            double decode_time_taken = stop - start;
+            if (best_time < 0 || decode_time_taken < best_time){
+                best_time = decode_time_taken;
+                best_chunk = SCHEDULE_CHUNK_SIZE;
+            }
+        }
+    }
+    SCHEDULE_CHUNK_SIZE = best_chunk;
+    free(encoded);
+    if (best_time < 0){
+        printf("Error: Unable to train the decode scheduler, keeping a chunk size of %d blocks\n", SCHEDULE_CHUNK_SIZE);
+        free(scheduler_file_location);
+        return 0;
+    }
+    if(PRINT)
+        printf("Scheduler Chunk Size Set to %d Blocks\n", SCHEDULE_CHUNK_SIZE);
+
+    // Append the result to the scheduler cache
+    fp = fopen(scheduler_file_location, "r");
+    if (fp == NULL){
+        fp = fopen(scheduler_file_location, "w");
+        if (fp != NULL){
+            fprintf(fp, "num_threads,chunk_size\n");
+        }
+    } else {
+        fclose(fp);
+        fp = fopen(scheduler_file_location, "a");
+    }
+    if (fp != NULL){
+        fprintf(fp, "%d,%d\n", AVAIL_THREADS, SCHEDULE_CHUNK_SIZE);
+        fclose(fp);
+    }
+    free(scheduler_file_location);
+    return 1;
+}
+
+// arc_configuration_lower_throughput:
+// Conservative bandwidth estimate of a configuration used when checking it against a throughput constraint
+// params:
+// configuration        -   configuration to estimate
+// return:
+// throughput_overhead  -   mean bandwidth less ARC_CONFIDENCE_Z standard errors (a full standard deviation for interpolated configurations)
+double arc_configuration_lower_throughput(struct configuration_information* configuration){
+    double samples = (configuration->sample_count > 0) ? (double)configuration->sample_count : 1;
+    return configuration->throughput_overhead - (ARC_CONFIDENCE_Z * sqrt(configuration->throughput_variance / samples));
+}
+
+// arc_roofline_probe:
+// Measures STREAM-style read (sum) and copy bandwidth on a given number of threads, keeping the best of several passes
+// params:
+// source       -   first probe array
+// destination  -   second probe array
+// count        -   number of uint64_t words in each array
+// threads      -   number of threads to stream with
+// read_bandwidth   -   address to store the read bandwidth in MB/s
+// copy_bandwidth   -   address to store the copy bandwidth in MB/s (bytes read + bytes written, as STREAM counts them)
+void arc_roofline_probe(uint64_t* source, uint64_t* destination, uint64_t count, uint32_t threads, double* read_bandwidth, double* copy_bandwidth){
+    int pass;
+    double best_read = -1, best_copy = -1;
+    uint64_t checksum = 0;
+    for (pass = 0; pass < ARC_TRAIN_WARMUPS + ARC_TRAIN_TRIALS; pass++){
+        int64_t i;
+        uint64_t sum = 0;
+        double start = arc_monotonic_seconds();
+        #pragma omp parallel for num_threads(threads) schedule(static) reduction(+:sum)
+        for (i = 0; i < (int64_t)count; i++){
+            sum += source[i];
+        }
+        double middle = arc_monotonic_seconds();
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (i = 0; i < (int64_t)count; i++){
+            destination[i] = source[i];
+        }
+        double stop = arc_monotonic_seconds();
+        checksum += sum + destination[pass % count];
+        if (pass < ARC_TRAIN_WARMUPS){
+            continue;
+        }
+        if (best_read < 0 || middle - start < best_read){
+            best_read = middle - start;
+        }
+        if (best_copy < 0 || stop - middle < best_copy){
+            best_copy = stop - middle;
+        }
+    }
+    // Keep the reads from being optimized away
+    arc_roofline_sink = checksum;
+    *read_bandwidth = ((double)(count * sizeof(uint64_t)) / best_read) / 1E6;
+    *copy_bandwidth = ((double)(2 * count * sizeof(uint64_t)) / best_copy) / 1E6;
+}
+
+// arc_roofline_init:
+// Loads the memory bandwidth roofline for every thread count from cache, probing and caching any thread counts missing from it
+// return:
+// x            -   Success=1, Failure=0
+int arc_roofline_init(){
+    FILE *fp;
+    uint32_t i;
+    int missing = 0;
+    free(arc_roofline_read);
+    free(arc_roofline_copy);
+    arc_roofline_read = (double*)calloc(AVAIL_THREADS + 1, sizeof(double));
+    arc_roofline_copy = (double*)calloc(AVAIL_THREADS + 1, sizeof(double));
+    if (arc_roofline_read == NULL || arc_roofline_copy == NULL){
+        printf("Roofline Error: Unable to allocate roofline table. . .\n");
+        return 0;
+    }
+    char * roofline_file_location = concat(cache_resource_location, roofline_resource_file);
+
+    // Pull in every cached thread count
+    fp = fopen(roofline_file_location, "r");
+    if (fp != NULL){
+        uint32_t tmp_th;
+        double tmp_read, tmp_copy;
+        char *buffer = NULL;
+        size_t len = 0;
+        ssize_t read;
+        while ((read = getline(&buffer, &len, fp)) != -1) {
+            // Skip the first line
+            if(!starts_with(buffer, "num_threads")){
+                if (sscanf(buffer, "%" SCNu32 ",%lf,%lf", &tmp_th, &tmp_read, &tmp_copy) == 3 && tmp_th >= 1 && tmp_th <= (uint32_t)AVAIL_THREADS && tmp_read > 0 && tmp_copy > 0){
+                    arc_roofline_read[tmp_th] = tmp_read;
+                    arc_roofline_copy[tmp_th] = tmp_copy;
+                }
+            }
+        }
+        fclose(fp);
+        if (buffer){
+            free(buffer);
+        }
+    }
+    for (i = 1; i <= (uint32_t)AVAIL_THREADS; i++){
+        missing += (arc_roofline_copy[i] == 0);
+    }
+    if (missing == 0){
+        free(roofline_file_location);
+        return 1;
+    }
+
+    // Otherwise probe the missing thread counts on first-touched arrays
+    uint64_t count = ARC_ROOFLINE_BYTES / sizeof(uint64_t);
+    uint64_t* source = (uint64_t*)malloc(count * sizeof(uint64_t));
+    uint64_t* destination = (uint64_t*)malloc(count * sizeof(uint64_t));
+    if (source == NULL || destination == NULL){
+        printf("Roofline Error: Unable to allocate probe arrays. . .\n");
+        free(source);
+        free(destination);
+        free(roofline_file_location);
+        return 0;
+    }
+    int64_t k;
+    #pragma omp parallel for num_threads(AVAIL_THREADS) schedule(static)
+    for (k = 0; k < (int64_t)count; k++){
+        source[k] = (uint64_t)k;
+        destination[k] = 0;
+    }
+    fp = fopen(roofline_file_location, "r");
+    if (fp == NULL){
+        fp = fopen(roofline_file_location, "w");
+        if (fp != NULL){
+            fprintf(fp, "num_threads,read_bandwidth,copy_bandwidth\n");
+        }
+    } else {
+        fclose(fp);
+        fp = fopen(roofline_file_location, "a");
+    }
+    for (i = 1; i <= (uint32_t)AVAIL_THREADS; i++){
+        if (arc_roofline_copy[i] == 0){
+            arc_roofline_probe(source, destination, count, i, &arc_roofline_read[i], &arc_roofline_copy[i]);
+            if(PRINT)
+                printf("Roofline on %" PRIu32 " Threads: Read %lf MB/s, Copy %lf MB/s\n", i, arc_roofline_read[i], arc_roofline_copy[i]);
+            if (fp != NULL){
+                fprintf(fp, "%" PRIu32 ",%lf,%lf\n", i, arc_roofline_read[i], arc_roofline_copy[i]);
+            }
+        }
+    }
+    if (fp != NULL){
+        fclose(fp);
+    }
+    free(source);
+    free(destination);
+    free(roofline_file_location);
+    return 1;
+}
+
+// arc_roofline_bandwidth:
+// Looks up the copy bandwidth the roofline probe measured for a thread count
+// params:
+// threads      -   number of threads
+// return:
+// bandwidth    -   copy bandwidth in MB/s (bytes read + bytes written), or -1 if it was not probed
+double arc_roofline_bandwidth(uint32_t threads){
+    if (arc_roofline_copy == NULL || threads < 1 || threads > (uint32_t)AVAIL_THREADS || !(arc_roofline_copy[threads] > 0)){
+        return -1;
+    }
+    return arc_roofline_copy[threads];
+}
+
+// arc_roofline_fraction:
+// Expresses an encode or decode as a fraction of the memory bandwidth roofline for its thread count
+// params:
+// bytes_in     -   bytes read by the operation
+// bytes_out    -   bytes written by the operation
+// seconds      -   time the operation took
+// threads      -   number of threads it ran on
+// return:
+// fraction     -   memory traffic over copy bandwidth (1 = running at the roofline), or -1 if it is unknown
+double arc_roofline_fraction(uint64_t bytes_in, uint64_t bytes_out, double seconds, uint32_t threads){
+    double bandwidth = arc_roofline_bandwidth(threads);
+    if (bandwidth < 0 || !(seconds > 0)){
+        return -1;
+    }
+    return (((double)(bytes_in + bytes_out) / seconds) / 1E6) / bandwidth;
+}
+
+// arc_roofline_threads:
+// Caps the thread count of a chosen configuration at the fewest threads that already reach the memory-bound fraction of
+// the roofline, since more threads cannot make a memory-bound encoder faster
+// params:
+// ecc_algorithm            -   identifier of the ecc method chosen
+// parameter_a              -   first ecc method parameter chosen
+// parameter_b              -   second ecc method parameter chosen
+// num_threads              -   number of threads chosen
+// throughput_constraint    -   minimum bandwidth the capped configuration must still be predicted to reach (ARC_ANY_BW for none)
+// return:
+// num_threads              -   number of threads to encode with
+uint32_t arc_roofline_threads(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t num_threads, double throughput_constraint){
+    int i;
+    uint32_t capped_threads = num_threads;
+    if (arc_roofline_copy == NULL || !(ARC_ROOFLINE_BOUND > 0)){
+        return num_threads;
+    }
+    pthread_mutex_lock(&configuration_lock);
+    for (i = 0; i < NUM_CONFIGURATIONS; i++){
+        struct configuration_information* configuration = &arc_configurations[i];
+        if (configuration->ecc_algorithm == ecc_algorithm && configuration->ecc_parameter_a == parameter_a && configuration->ecc_parameter_b == parameter_b
+            && configuration->num_threads < capped_threads && (throughput_constraint == ARC_ANY_BW || arc_configuration_lower_throughput(configuration) >= throughput_constraint)){
+            // Per MB encoded the data is read once and the encoded data (1 + memory overhead) written once
+            double traffic = configuration->throughput_overhead * (2 + configuration->memory_overhead);
+            double bandwidth = arc_roofline_bandwidth(configuration->num_threads);
+            if (bandwidth > 0 && traffic >= ARC_ROOFLINE_BOUND * bandwidth){
+                capped_threads = configuration->num_threads;
+            }
+        }
+    }
+    pthread_mutex_unlock(&configuration_lock);
+    if (PRINT && capped_threads != num_threads)
+        printf("Configuration is memory-bound on %" PRIu32 " threads, capping from %" PRIu32 " threads\n", capped_threads, num_threads);
+    return capped_threads;
+}
+
+// arc_compare_double:
+// qsort comparator ordering doubles from smallest to largest
+int arc_compare_double(const void* a, const void* b){
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// arc_robust_statistics:
+// Computes the mean and variance of a set of samples after discarding outliers by median absolute deviation
+// params:
+// samples      -   measured samples (sorted in place)
+// count        -   number of samples
+// mean         -   address to store the mean of the samples kept
+// variance     -   address to store the sample variance of the samples kept
+// return:
+// kept         -   number of samples kept
+uint32_t arc_robust_statistics(double* samples, uint32_t count, double* mean, double* variance){
+    uint32_t i;
+    *mean = 0;
+    *variance = 0;
+    if (count == 0){
+        return 0;
+    }
+    // Find the median and the median absolute deviation around it
+    qsort(samples, count, sizeof(double), arc_compare_double);
+    double median = (count % 2) ? samples[count / 2] : (samples[(count / 2) - 1] + samples[count / 2]) / 2;
+    double *deviations = talloc(double, count);
+    for (i = 0; i < count; i++){
+        deviations[i] = fabs(samples[i] - median);
+    }
+    qsort(deviations, count, sizeof(double), arc_compare_double);
+    double mad = (count % 2) ? deviations[count / 2] : (deviations[(count / 2) - 1] + deviations[count / 2]) / 2;
+    free(deviations);
+    // 1.4826 * MAD estimates the standard deviation of normally distributed samples
+    double cutoff = ARC_OUTLIER_CUTOFF * 1.4826 * mad;
+
+    // Welford's running mean and variance over the samples kept
+    uint32_t kept = 0;
+    double m2 = 0;
+    for (i = 0; i < count; i++){
+        if (mad > 0 && fabs(samples[i] - median) > cutoff){
+            continue;
+        }
+        kept++;
+        double delta = samples[i] - *mean;
+        *mean += delta / kept;
+        m2 += delta * (samples[i] - *mean);
+    }
+    if (kept > 1){
+        *variance = m2 / (kept - 1);
+    }
+    return kept;
+}
+
+// arc_measure_configuration:
+// Measures the encoding bandwidth of a configuration over warmup passes and repeated monotonic clock trials
+// params:
+// ecc_algorithm        -   identifier of the ecc method to measure
+// parameter_a          -   first ecc method parameter
+// parameter_b          -   second ecc method parameter
+// threads              -   number of threads to measure with
+// data                 -   data set to encode
+// data_size            -   size of data set
+// memory_overhead      -   address to store the memory overhead ((encoded_size / data_size) - 1)
+// throughput_overhead  -   address to store the mean bandwidth in MB/s of the trials kept
+// throughput_variance  -   address to store the variance in (MB/s)^2 of the trials kept
+// sample_count         -   address to store the number of trials kept
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_measure_configuration(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, uint8_t* data, uint32_t data_size, double* memory_overhead, double* throughput_overhead, double* throughput_variance, uint32_t* sample_count){
+    struct arc_layout layout;
+    int i;
+    if (data_size == 0 || arc_layout_create(ecc_algorithm, data_size, parameter_a, parameter_b, threads, &layout) == 0){
+        return 0;
+    }
+    // Every pass encodes into the same output so only the first one pays for page faults
+    uint8_t *encoded = (uint8_t*)malloc(sizeof(uint8_t) * layout.encoded_size);
+    memset(encoded, 0, layout.encoded_size);
+    for (i = 0; i < ARC_TRAIN_WARMUPS; i++){
+        arc_layout_write_metadata(&layout, data, encoded);
+        arc_encode_blocks(&layout, data, encoded, threads);
+    }
+
+    // Time each trial on the monotonic clock
+    int trials = (ARC_TRAIN_TRIALS > 0) ? ARC_TRAIN_TRIALS : 1;
+    double *samples = talloc(double, trials);
+    for (i = 0; i < trials; i++){
+        double start = arc_monotonic_seconds();
+        arc_layout_write_metadata(&layout, data, encoded);
+        arc_encode_blocks(&layout, data, encoded, threads);
+        double encode_time_taken = arc_monotonic_seconds() - start;
+        if (encode_time_taken <= 0){
+            encode_time_taken = 1E-9;
+        }
+        samples[i] = (data_size / encode_time_taken)/1E6; // MB/s
+    }
+    *sample_count = arc_robust_statistics(samples, trials, throughput_overhead, throughput_variance);
+    *memory_overhead = ((double)layout.encoded_size / (double)data_size) - 1;
+    free(samples);
+    free(encoded);
+    return 1;
+}
+
+// arc_record_configuration:
+// Stores a configuration in the configuration table and training file
+// params:
+// fp                   -   training file of the current number of threads
+// index                -   index of the configuration within arc_configurations
+// ecc_algorithm        -   identifier of the ecc method
+// parameter_a          -   first ecc method parameter
+// parameter_b          -   second ecc method parameter
+// threads              -   number of threads
+// memory_overhead      -   memory overhead of the configuration
+// throughput_overhead  -   mean bandwidth of the configuration in MB/s
+// throughput_variance  -   variance of the bandwidth in (MB/s)^2
+// sample_count         -   number of measurements behind the bandwidth (0 if it was interpolated)
+void arc_record_configuration(FILE* fp, int index, int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, double memory_overhead, double throughput_overhead, double throughput_variance, uint32_t sample_count){
+    // Add this information to configuration_information struct array
+    arc_configurations[index].ecc_algorithm = ecc_algorithm;
+    arc_configurations[index].ecc_parameter_a = parameter_a;
+    arc_configurations[index].ecc_parameter_b = parameter_b;
+    arc_configurations[index].num_threads = threads;
+    arc_configurations[index].memory_overhead  = memory_overhead;
+    arc_configurations[index].throughput_overhead  = throughput_overhead;
+    arc_configurations[index].throughput_variance  = throughput_variance;
+    arc_configurations[index].sample_count = sample_count;
+    // Write these results out to corresponding thread training file
+    fprintf(fp, "%d,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf,%lf,%" PRIu32 "\n", ecc_algorithm, parameter_a, parameter_b, threads, memory_overhead, throughput_overhead, throughput_variance, sample_count);
+    fflush(fp);
+}
+
+// arc_train_configuration:
+// Measures a single encoding configuration and records it in the configuration table and training file
+// params:
+// fp               -   training file of the current number of threads
+// index            -   index of the configuration within arc_configurations
+// ecc_algorithm    -   identifier of the ecc method to train
+// parameter_a      -   first ecc method parameter
+// parameter_b      -   second ecc method parameter
+// threads          -   number of threads to train with
+// data             -   simulated data set to train with
+// data_size        -   size of simulated data set
+// return:
+// err              -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_train_configuration(FILE* fp, int index, int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t threads, uint8_t* data, uint32_t data_size){
+    double memory_overhead;
+    double throughput_overhead;
+    double throughput_variance;
+    uint32_t sample_count;
+    if (arc_measure_configuration(ecc_algorithm, parameter_a, parameter_b, threads, data, data_size, &memory_overhead, &throughput_overhead, &throughput_variance, &sample_count) == 0){
+        return 0;
+    }
+    arc_record_configuration(fp, index, ecc_algorithm, parameter_a, parameter_b, threads, memory_overhead, throughput_overhead, throughput_variance, sample_count);
+    return 1;
+}
+
+// arc_init:
+// Loads resource files and training data. If training data is not available, run training tests
+// params:
+// max_threads  -   Maximum number of threads ARC should use
+// return:
+// x            -   Success=1, Failure=0
+int arc_init(uint32_t max_threads){
+    // Nothing to do if ARC is already initialized (call arc_close first to re-initialize)
+    if (INIT){
+        return 1;
+    }
+    // Load all the required resources files needed for encoding and decoding
+    if(PRINT)
+        printf("Initializing ARC Resource Files\n");
+    int err = arc_resource_init();
+    if(err == 0){
+        return 0;
+    }
+
+    // Turn off print outs
+    PRINT = 0;
+
+    // Initialize Resources for Later Use
+    FILE *fp;
+    uint32_t i, j, k;
+    // Set up training variables
+    double total_start;
+    double method_start;
+    double memory_overhead;
+    double throughput_overhead;
+    double throughput_variance;
+    uint32_t sample_count;
+    // Set up simulated data set to train with
+    uint32_t data_size = 100000;
+    uint8_t *data = malloc(sizeof(uint8_t)*data_size);
+    srand(0);
+    for (i = 0; i < data_size; i++){
+        data[i] = (uint8_t)(rand() % 255);
+    }
+
+    // Check for valid max_threads
+    if (max_threads == ARC_ANY_THREADS || max_threads >= omp_get_max_threads()){
+        AVAIL_THREADS = omp_get_max_threads();
+    } else if (max_threads <= 0 && max_threads != ARC_ANY_THREADS){
+        AVAIL_THREADS = 1;
+    } else {
+        AVAIL_THREADS = max_threads;
+    }
+
+    // Calculate number of configurations per num_threads
+    int elements_per_num_threads = 3 + 3 + 128 + 256; // 3 SECDED, 3 Hamming, 128 RS, & 256 Parity Configs (including packed)
+    NUM_CONFIGURATIONS = AVAIL_THREADS * elements_per_num_threads;
+    // Initialize arc_configurations array with enough space for each configuration
+    arc_configurations = malloc(NUM_CONFIGURATIONS * sizeof(*arc_configurations));
+    arc_explore_candidates = malloc(NUM_CONFIGURATIONS * sizeof(*arc_explore_candidates));
+    int current_config_array_index = 0;
+
+    // For threads 1 to max_threads, check to see if we have the training data for these already
+    if(PRINT)
+        printf("ARC Training and Loading Process Started\n");
+    total_start = arc_monotonic_seconds();
+    for(i = 1; i <= AVAIL_THREADS; i++){
+        // Check resource folder for corresponding num_threads information cache
+        char num_thread_string[8];
+        sprintf(num_thread_string, "%d", i);
+        char * thread_file_name = concat(num_thread_string, thread_resource_file);
+        char * thread_file_location = concat(cache_resource_location, thread_file_name);
+        fp = fopen(thread_file_location, "r");
+
+        if(PRINT)
+            printf("\n%d Thread(s) Training and Loading Started...\n", i);
+        // If the file does exist, pull in information from file
+        if(fp != NULL){
+            int tmp_alg;
+            uint32_t tmp_a;
+            uint32_t tmp_b;
+            uint32_t tmp_th;
+            double tmp_mo;
+            double tmp_to;
+            double tmp_tv;
+            uint32_t tmp_sc;
+            int loaded_configurations = 0;
+            int stale_format = 0;
+            char *buffer = NULL;
+            size_t len = 0;
+            ssize_t read;
+            while ((read = getline(&buffer, &len, fp)) != -1) {
+                // Skip the first line
+                if(!starts_with(buffer, "ecc_algorithm")){
+                    // Never store more configurations than this number of threads has room for
+                    if (loaded_configurations < elements_per_num_threads){
+                        // Scan each line and pull the specific values
+                        // Caches written before throughput variance was recorded only hold 6 values, and caches written
+                        // before sample counts were kept hold 7 (their estimates are kept but treated as a single sample)
+                        int values = sscanf(buffer, "%d,%" SCNu32 ",%" SCNu32 ",%" SCNu32 ",%lf,%lf,%lf,%" SCNu32, &tmp_alg, &tmp_a, &tmp_b, &tmp_th, &tmp_mo, &tmp_to, &tmp_tv, &tmp_sc);
+                        if (values < 7){
+                            stale_format = 1;
+                            tmp_tv = 0;
+                        }
+                        if (values < 8){
+                            tmp_sc = 1;
+                        }
+                        // Store these values in the configurations array
+                        arc_configurations[current_config_array_index].ecc_algorithm = tmp_alg;
+                        arc_configurations[current_config_array_index].ecc_parameter_a = tmp_a;
+                        arc_configurations[current_config_array_index].ecc_parameter_b = tmp_b;
+                        arc_configurations[current_config_array_index].num_threads = tmp_th;
+                        arc_configurations[current_config_array_index].memory_overhead  = tmp_mo;
+                        arc_configurations[current_config_array_index].throughput_overhead  = tmp_to;
+                        arc_configurations[current_config_array_index].throughput_variance  = tmp_tv;
+                        arc_configurations[current_config_array_index].sample_count = tmp_sc;
+                        // Increment current config array index
+                        current_config_array_index++;
+                    }
+                    loaded_configurations++;
+                }
+            }
+            fclose(fp);
+            if (buffer){
+                free(buffer);
+            }
+            // Caches written before the current set of configurations existed are retrained
+            if (loaded_configurations != elements_per_num_threads || stale_format){
+                if(PRINT)
+                    printf("%d Thread(s) Cache Is Out Of Date, Retraining...\n", i);
+                current_config_array_index = current_config_array_index - ((loaded_configurations < elements_per_num_threads) ? loaded_configurations : elements_per_num_threads);
+                fp = NULL;
+            }
+        }
+        // If the file does not exist (or is out of date),
+        if(fp == NULL){
+
+            // Open a write pointer
+            fp = fopen(thread_file_location, "w");
+            fprintf(fp, "ecc_algorithm,ecc_parameter_a,ecc_parameter_b,num_threads,memory_overhead,throughput_overhead,throughput_variance,sample_count\n");
+
+            // Run training tests to populate both the arc_configurations array and file
+            for(j = 1; j <= NUM_METHODS; j++){
+                // Parity Training
+                if(j == PARITY_ID){
+                    // Start Training
+                    if(PRINT)
+                        printf("Parity Training Started...\n");
+                    method_start = arc_monotonic_seconds();
+
+                    // Train 1 parity bits over 1 byte to 128 bytes of data
+                    for(k = 1; k <= 128; k++){
+                        err = arc_train_configuration(fp, current_config_array_index, j, k, 0, i, data, data_size);
+                        current_config_array_index++;
+                    }
+
+                    // Train packed parity bitmaps over 1 byte to 128 bytes of data
+                    for(k = 1; k <= 128; k++){
+                        err = arc_train_configuration(fp, current_config_array_index, j, k, 1, i, data, data_size);
+                        current_config_array_index++;
+                    }
+
+                    // End Training
+                    if(PRINT)
+                        printf("Parity Training Completed in %lf Seconds!\n", arc_monotonic_seconds() - method_start);
+                // Hamming Training 
+                } else if(j == HAMMING_ID){  
+                    // Start Training
+                    if(PRINT)
+                        printf("Hamming Training Started...\n");
+                    method_start = arc_monotonic_seconds();
+
+                    // Train hamming over 1 byte and 8 bytes of data
+                    err = arc_train_configuration(fp, current_config_array_index, j, 1, 0, i, data, data_size);
+                    current_config_array_index++;
+                    err = arc_train_configuration(fp, current_config_array_index, j, 8, 0, i, data, data_size);
+                    current_config_array_index++;
+
+                    // Train hamming over 1 byte of data with packed check bits
+                    err = arc_train_configuration(fp, current_config_array_index, j, 1, 1, i, data, data_size);
+                    current_config_array_index++;
+
+                    // End Training 
+                    if(PRINT)
+                        printf("Hamming Training Completed in %lf Seconds!\n", arc_monotonic_seconds() - method_start);
+
+                // SECDED Training
+                } else if(j == SECDED_ID){
                     // Start Training
                     if(PRINT)
                         printf("SECDED Training Started...\n");
-                    gettimeofday(&method_start, NULL);
-
-                    // Train secded over 1 byte of data
-                    uint32_t secded_block_size = 1;
-                    gettimeofday(&start, NULL);
-                    err = arc_secded_encode(data, data_size, secded_block_size, i, &encoded, &encoded_size);
-                    gettimeofday(&stop, NULL);
-                    encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-                    // Calculate Overhead Factors
-                    memory_overhead = ((double)encoded_size / (double)data_size) - 1;
-                    throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-                    // Add this information to configuration_information struct array
-                    arc_configurations[current_config_array_index].ecc_algorithm = j;
-                    arc_configurations[current_config_array_index].ecc_parameter_a = secded_block_size;
-                    arc_configurations[current_config_array_index].ecc_parameter_b = 0;
-                    arc_configurations[current_config_array_index].num_threads = i;
-                    arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                    arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                    // Write these results out to corresponding thread training file
-                    fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, secded_block_size, 0, i, memory_overhead, throughput_overhead);
-                    fflush(fp);
-                    // Increment current config array index
+                    method_start = arc_monotonic_seconds();
+
+                    // Train secded over 1 byte and 8 bytes of data
+                    err = arc_train_configuration(fp, current_config_array_index, j, 1, 0, i, data, data_size);
+                    current_config_array_index++;
+                    err = arc_train_configuration(fp, current_config_array_index, j, 8, 0, i, data, data_size);
                     current_config_array_index++;
-                    // Free encoded data
-                    free(encoded);
-
-                    // Train secded over 8 bytes of data
-                    secded_block_size = 8;
-                    gettimeofday(&start, NULL);
-                    err = arc_secded_encode(data, data_size, secded_block_size, i, &encoded, &encoded_size);
-                    gettimeofday(&stop, NULL);
-                    encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-                    // Calculate Overhead Factors
-                    memory_overhead = ((double)encoded_size / (double)data_size) - 1;
-                    throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-                    // Add this information to configuration_information struct array
-                    arc_configurations[current_config_array_index].ecc_algorithm = j;
-                    arc_configurations[current_config_array_index].ecc_parameter_a = secded_block_size;
-                    arc_configurations[current_config_array_index].ecc_parameter_b = 0;
-                    arc_configurations[current_config_array_index].num_threads = i;
-                    arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                    arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                    // Write these results out to corresponding thread training file
-                    fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, secded_block_size, 0, i, memory_overhead, throughput_overhead);
-                    fflush(fp);
-                    // Increment current config array index
+
+                    // Train secded over 1 byte of data with packed check bits
+                    err = arc_train_configuration(fp, current_config_array_index, j, 1, 1, i, data, data_size);
                     current_config_array_index++;
-                    // Free encoded data
-                    free(encoded);
 
                     // End Training 
-                    gettimeofday(&method_stop, NULL);
-                    double method_time_taken = (double)(method_stop.tv_usec - method_start.tv_usec) / 1000000 + (double)(method_stop.tv_sec - method_start.tv_sec);
                     if(PRINT)
-                        printf("SECDED Training Completed in %lf Seconds!\n", method_time_taken);
+                        printf("SECDED Training Completed in %lf Seconds!\n", arc_monotonic_seconds() - method_start);
 
                 // RS Training
                 } else if(j == RS_ID){
@@ -485,245 +4182,860 @@ int arc_init(uint32_t max_threads){
                         printf("Reed-Solomon Training Started...\n");
                         printf("(This may take some time)\n");
                     }
-                    gettimeofday(&method_start, NULL);
+                    method_start = arc_monotonic_seconds();
 
                     // Set initial data and code devices
                     uint32_t data_devices = 128;
                     uint32_t code_devices = 128;
 
-                    // Train every 4th configuration and estimate the others
-                    double previous_memory_overhead = 0;
-                    double previous_throughput_overhead = 0;
-                    uint32_t tmp_data_devices;
-                    uint32_t tmp_code_devices;
-                    for (k = 0; k <= 32; k++){
-                        // Time the encoding process
-                        gettimeofday(&start, NULL);
-                        err = arc_reed_solomon_encode(data, data_size, data_devices, code_devices, i, &encoded, &encoded_size);
-                        gettimeofday(&stop, NULL);
-                        encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-                        // Calculate Overhead Factors
-                        memory_overhead = ((double)encoded_size / (double)data_size) - 1;
-                        throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-
-                        // Estimate missing values and save current values for next estimation
-                        if (k == 0){
-                            // Store current calculations for next round of estimations
-                            previous_memory_overhead = memory_overhead;
-                            previous_throughput_overhead = throughput_overhead;
-                            // Add this information to configuration_information struct array
-                            arc_configurations[current_config_array_index].ecc_algorithm = j;
-                            arc_configurations[current_config_array_index].ecc_parameter_a = data_devices;
-                            arc_configurations[current_config_array_index].ecc_parameter_b = code_devices;
-                            arc_configurations[current_config_array_index].num_threads = i;
-                            arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                            arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                            // Write these results out to corresponding thread training file
-                            fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, data_devices, code_devices, i, memory_overhead, throughput_overhead);
-                            fflush(fp);
-                            // Increment current config array index
-                            current_config_array_index++;
-                        } else {
-                            // Estimate the mid point values
-                            double mid_memory_overhead = (previous_memory_overhead + memory_overhead) / (double) 2;
-                            double mid_throughput_overhead = (previous_throughput_overhead + throughput_overhead) / (double) 2;
-                            // Estimate the first quartile point values
-                            double first_quartile_memory_overhead = (previous_memory_overhead + mid_memory_overhead) / (double) 2;
-                            double first_quartile_throughput_overhead = (previous_throughput_overhead + mid_throughput_overhead) / (double) 2;
-                            // Estimate the third quartile point values
-                            double third_quartile_memory_overhead = (memory_overhead + mid_memory_overhead) / (double) 2;
-                            double third_quartile_throughput_overhead = (throughput_overhead + mid_throughput_overhead) / (double) 2;
-
-                            // Store the newly estimated values in the arc configurations table
-                            // First estimated value
-                            tmp_data_devices = data_devices - 3;
-                            tmp_code_devices = code_devices + 3;
-                            arc_configurations[current_config_array_index].ecc_algorithm = j;
-                            arc_configurations[current_config_array_index].ecc_parameter_a = tmp_data_devices;
-                            arc_configurations[current_config_array_index].ecc_parameter_b = tmp_code_devices;
-                            arc_configurations[current_config_array_index].num_threads = i;
-                            arc_configurations[current_config_array_index].memory_overhead  = first_quartile_memory_overhead;
-                            arc_configurations[current_config_array_index].throughput_overhead  = first_quartile_throughput_overhead;
-                            // Write these results out to corresponding thread training file
-                            fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, tmp_data_devices, tmp_code_devices, i, first_quartile_memory_overhead, first_quartile_throughput_overhead);
-                            fflush(fp);
-                            // Increment current config array index
-                            current_config_array_index++;
-
-                            // Dont include the mid point of the final iteration as this is not actually a valid configuration
-                            // i.e: 253.5 data devices is not valid
-                            if (k != 32){
-                                // Second estimated value
-                                tmp_data_devices = data_devices - 2;
-                                tmp_code_devices = code_devices + 2;
-                                arc_configurations[current_config_array_index].ecc_algorithm = j;
-                                arc_configurations[current_config_array_index].ecc_parameter_a = tmp_data_devices;
-                                arc_configurations[current_config_array_index].ecc_parameter_b = tmp_code_devices;
-                                arc_configurations[current_config_array_index].num_threads = i;
-                                arc_configurations[current_config_array_index].memory_overhead  = mid_memory_overhead;
-                                arc_configurations[current_config_array_index].throughput_overhead  = mid_throughput_overhead;
-                                // Write these results out to corresponding thread training file
-                                fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, tmp_data_devices, tmp_code_devices, i, mid_memory_overhead, mid_throughput_overhead);
-                                fflush(fp);
-                                // Increment current config array index
-                                current_config_array_index++;
-                            }
-                            
-                            // Third estimated value
-                            tmp_data_devices = data_devices - 1;
-                            tmp_code_devices = code_devices + 1;
-                            arc_configurations[current_config_array_index].ecc_algorithm = j;
-                            arc_configurations[current_config_array_index].ecc_parameter_a = tmp_data_devices;
-                            arc_configurations[current_config_array_index].ecc_parameter_b = tmp_code_devices;
-                            arc_configurations[current_config_array_index].num_threads = i;
-                            arc_configurations[current_config_array_index].memory_overhead  = third_quartile_memory_overhead;
-                            arc_configurations[current_config_array_index].throughput_overhead  = third_quartile_throughput_overhead;
-                            // Write these results out to corresponding thread training file
-                            fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, tmp_data_devices, tmp_code_devices, i, third_quartile_memory_overhead, third_quartile_throughput_overhead);
-                            fflush(fp);
-                            // Increment current config array index
-                            current_config_array_index++;
-
-                            // Store current calculations for next round of estimations
-                            previous_memory_overhead = memory_overhead;
-                            previous_throughput_overhead = throughput_overhead;
-                            // Add this information to configuration_information struct array
-                            arc_configurations[current_config_array_index].ecc_algorithm = j;
-                            arc_configurations[current_config_array_index].ecc_parameter_a = data_devices;
-                            arc_configurations[current_config_array_index].ecc_parameter_b = code_devices;
-                            arc_configurations[current_config_array_index].num_threads = i;
-                            arc_configurations[current_config_array_index].memory_overhead  = memory_overhead;
-                            arc_configurations[current_config_array_index].throughput_overhead  = throughput_overhead;
-                            // Write these results out to corresponding thread training file
-                            fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", j, data_devices, code_devices, i, memory_overhead, throughput_overhead);
-                            fflush(fp);
-                            // Increment current config array index
-                            current_config_array_index++;
-                        }
+                    // Train every 4th configuration and estimate the others
+                    double previous_memory_overhead = 0;
+                    double previous_throughput_overhead = 0;
+                    double previous_throughput_variance = 0;
+                    uint32_t step;
+                    for (k = 0; k <= 32; k++){
+                        // Measure the encoding process
+                        err = arc_measure_configuration(j, data_devices, code_devices, i, data, data_size, &memory_overhead, &throughput_overhead, &throughput_variance, &sample_count);
+
+                        // Estimate the three configurations between this one and the previous one by linear interpolation
+                        // (Dont include the mid point of the final iteration as this is not actually a valid configuration
+                        // i.e: 253.5 data devices is not valid)
+                        if (k != 0){
+                            for (step = 3; step >= 1; step--){
+                                if (k == 32 && step == 2){
+                                    continue;
+                                }
+                                double weight = (double)(4 - step) / (double) 4;
+                                arc_record_configuration(fp, current_config_array_index, j, data_devices - step, code_devices + step, i,
+                                    previous_memory_overhead + (weight * (memory_overhead - previous_memory_overhead)),
+                                    previous_throughput_overhead + (weight * (throughput_overhead - previous_throughput_overhead)),
+                                    previous_throughput_variance + (weight * (throughput_variance - previous_throughput_variance)), 0);
+                                current_config_array_index++;
+                            }
+                        }
+
+                        // Store current calculations for next round of estimations
+                        previous_memory_overhead = memory_overhead;
+                        previous_throughput_overhead = throughput_overhead;
+                        previous_throughput_variance = throughput_variance;
+                        arc_record_configuration(fp, current_config_array_index, j, data_devices, code_devices, i, memory_overhead, throughput_overhead, throughput_variance, sample_count);
+                        current_config_array_index++;
+
+                        // Change data and code devices for next iteration
+                        if (data_devices == 252){
+                            data_devices = 255;
+                            code_devices = 1;
+                        } else {
+                            data_devices = data_devices + 4;
+                            code_devices = code_devices - 4;
+                        }
+                    }
+
+                    // End Training 
+                    if(PRINT)
+                        printf("Reed-Solomon Training Completed in %lf Seconds!\n", arc_monotonic_seconds() - method_start);
+                }
+            }
+            fclose(fp);
+        }
+        // Free strings
+        free(thread_file_location);
+        free(thread_file_name);
+        if(PRINT)
+            printf("%d Thread(s) Training and Loading Completed!\n", i);
+    }
+    // Return once everything has been loaded
+    double total_time_taken = arc_monotonic_seconds() - total_start;
+    if(PRINT) {
+    printf("ARC Training and Loading Process Finished!\n");
+    printf("Total Training Time Taken: %lf Seconds\n", total_time_taken);
+    }
+
+    // Load or train the chunk size used by the decode scheduler
+    arc_scheduler_init(data, data_size);
+
+    // Load or probe the memory bandwidth roofline for every thread count
+    arc_roofline_init();
+
+    // Free allocated simulated data
+    free(data);
+
+    // Start tracing when requested through the environment (ARC_TRACE=1 or ARC_TRACE=path/to/trace.json)
+    char* trace_setting = getenv("ARC_TRACE");
+    if (trace_setting != NULL && trace_setting[0] != '\0' && strcmp(trace_setting, "0") != 0){
+        arc_trace_start((strcmp(trace_setting, "1") == 0) ? NULL : trace_setting);
+    }
+    // Select an exploration policy when requested through the environment (ARC_EXPLORE=epsilon or ARC_EXPLORE=ucb)
+    char* explore_setting = getenv("ARC_EXPLORE");
+    if (explore_setting != NULL){
+        if (strcmp(explore_setting, "epsilon") == 0){
+            ARC_EXPLORE = ARC_EXPLORE_EPSILON;
+        } else if (strcmp(explore_setting, "ucb") == 0){
+            ARC_EXPLORE = ARC_EXPLORE_UCB;
+        }
+    }
+    // Start capturing arc_encode calls when requested through the environment (ARC_CAPTURE=path/to/workload.cap)
+    char* capture_setting = getenv("ARC_CAPTURE");
+    if (capture_setting != NULL && capture_setting[0] != '\0' && arc_capture_file == NULL){
+        arc_capture_start(capture_setting);
+    }
+
+    return 1;
+}
+
+// arc_save:
+// Saves training data collected during normal use to resource files. This process helps 
+// ARC become smarter over time and should be done before arc_close is called.
+// return:
+// x            -   Success=1, Failure=0
+int arc_save(){
+    // Initialize Resources for Later Use
+    int i, j;
+    FILE *fp;
+
+    // Hold the configuration lock so asynchronous encodes cannot update the table mid-write
+    pthread_mutex_lock(&configuration_lock);
+    // For each number of available threads, write the updated values to the file
+    for(i = 1; i <= AVAIL_THREADS; i++){
+        // Create the pointer to the file
+        char num_thread_string[8];
+        sprintf(num_thread_string, "%d", i);
+        char * thread_file_name = concat(num_thread_string, thread_resource_file);
+        char * thread_file_location = concat(cache_resource_location, thread_file_name);
+        fp = fopen(thread_file_location, "w");
+        fprintf(fp, "ecc_algorithm,ecc_parameter_a,ecc_parameter_b,num_threads,memory_overhead,throughput_overhead,throughput_variance,sample_count\n");
+
+        // Iterate over all configurations and write the corresponding thread configurations to file
+        for (j = 0; j < NUM_CONFIGURATIONS; j++){
+            if (arc_configurations[j].num_threads == i){
+                fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf,%lf,%" PRIu32 "\n", arc_configurations[j].ecc_algorithm, arc_configurations[j].ecc_parameter_a, arc_configurations[j].ecc_parameter_b, arc_configurations[j].num_threads, arc_configurations[j].memory_overhead, arc_configurations[j].throughput_overhead, arc_configurations[j].throughput_variance, arc_configurations[j].sample_count);
+            }
+        }
+
+        // Close file once all configurations have been written
+        fclose(fp);
+    }
+    pthread_mutex_unlock(&configuration_lock);
+
+    return 1;
+}
+
+// arc_close:
+// Frees allocated resources needed for ARC to be used
+// return:
+// x            -   Success=1, Failure=0
+int arc_close(){
+    // Finish outstanding asynchronous requests and stop the worker pool
+    arc_async_stop();
+    // Write out and stop any trace being recorded
+    arc_trace_stop();
+    // Close any capture being recorded
+    arc_capture_stop();
+    // Free arc configurations list, exploration candidates, and roofline table
+    free(arc_configurations);
+    free(arc_explore_candidates);
+    arc_explore_candidates = NULL;
+    free(arc_roofline_read);
+    free(arc_roofline_copy);
+    arc_roofline_read = NULL;
+    arc_roofline_copy = NULL;
+    // Set init back to false 
+    INIT = 0;
+    if(PRINT)
+        printf("ARC successfully closed\n");
+    return 1;
+}
+
+// arc_explore_random:
+// Draws a uniform random number in [0, 1) from the exploration generator (call with the configuration lock held)
+// return:
+// x            -   random number
+double arc_explore_random(){
+    // xorshift64*
+    arc_explore_state ^= arc_explore_state >> 12;
+    arc_explore_state ^= arc_explore_state << 25;
+    arc_explore_state ^= arc_explore_state >> 27;
+    return (double)((arc_explore_state * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+// arc_explore:
+// Applies the exploration policy to the optimizer's choice. Candidates are configurations of the same ECC method whose
+// memory overhead is within ARC_EXPLORE_MARGIN of the choice, that meet the constraints the choice meets, and that use
+// no more threads than it. Epsilon-greedy keeps the optimizer's choice except for a random candidate ARC_EXPLORE_RATE of
+// the time, and UCB takes the candidate with the highest mean plus a bonus that shrinks as its sample count grows
+// params:
+// ecc_algorithm            -   identifier of the ecc method chosen
+// memory_constraint        -   maximum amount of memory overhead to introduce (or ARC_ANY_SIZE)
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (or ARC_ANY_BW)
+// optimizer_parameter_a    -   first ecc method parameter chosen (replaced with the candidate taken)
+// optimizer_parameter_b    -   second ecc method parameter chosen (replaced with the candidate taken)
+// num_threads              -   number of threads chosen (replaced with the candidate taken)
+void arc_explore(int ecc_algorithm, double memory_constraint, double throughput_constraint, uint32_t* optimizer_parameter_a, uint32_t* optimizer_parameter_b, uint32_t* num_threads){
+    int i;
+    int chosen = -1;
+    pthread_mutex_lock(&configuration_lock);
+    for (i = 0; i < NUM_CONFIGURATIONS; i++){
+        if (arc_configurations[i].ecc_algorithm == ecc_algorithm && arc_configurations[i].ecc_parameter_a == *optimizer_parameter_a
+            && arc_configurations[i].ecc_parameter_b == *optimizer_parameter_b && arc_configurations[i].num_threads == *num_threads){
+            chosen = i;
+            break;
+        }
+    }
+    if (chosen == -1){
+        pthread_mutex_unlock(&configuration_lock);
+        return;
+    }
+
+    // Gather the candidates (a fallback choice that misses a constraint only admits candidates no worse than it)
+    struct configuration_information* choice = &arc_configurations[chosen];
+    double memory_limit = (memory_constraint == ARC_ANY_SIZE) ? DBL_MAX : memory_constraint;
+    if (choice->memory_overhead > memory_limit){
+        memory_limit = choice->memory_overhead;
+    }
+    double throughput_limit = (throughput_constraint == ARC_ANY_BW) ? -DBL_MAX : throughput_constraint;
+    if (arc_configuration_lower_throughput(choice) < throughput_limit){
+        throughput_limit = arc_configuration_lower_throughput(choice);
+    }
+    double margin = ARC_EXPLORE_MARGIN * ((choice->memory_overhead > 0.01) ? choice->memory_overhead : 0.01);
+    int* candidates = arc_explore_candidates;
+    int candidate_count = 0;
+    uint64_t total_samples = 0;
+    for (i = 0; i < NUM_CONFIGURATIONS; i++){
+        struct configuration_information* configuration = &arc_configurations[i];
+        if (configuration->ecc_algorithm == ecc_algorithm && configuration->num_threads <= *num_threads
+            && fabs(configuration->memory_overhead - choice->memory_overhead) <= margin && configuration->memory_overhead <= memory_limit
+            && (i == chosen || arc_configuration_lower_throughput(configuration) >= throughput_limit)){
+            candidates[candidate_count++] = i;
+            total_samples += configuration->sample_count;
+        }
+    }
+
+    // Apply the policy (deviating from the optimizer's choice only on a random draw or a higher UCB score)
+    int taken = chosen;
+    if (ARC_EXPLORE == ARC_EXPLORE_EPSILON){
+        if (arc_explore_random() < ARC_EXPLORE_RATE){
+            taken = candidates[(int)(arc_explore_random() * candidate_count)];
+        }
+    } else if (ARC_EXPLORE == ARC_EXPLORE_UCB){
+        double best_score = -DBL_MAX;
+        for (i = 0; i < candidate_count; i++){
+            struct configuration_information* configuration = &arc_configurations[candidates[i]];
+            // Bonus in standard deviations (at least 5% of the mean so a falsely confident estimate is still revisited)
+            double deviation = sqrt(configuration->throughput_variance);
+            if (deviation < configuration->throughput_overhead * 0.05){
+                deviation = configuration->throughput_overhead * 0.05;
+            }
+            double score = configuration->throughput_overhead + (ARC_EXPLORE_UCB_WEIGHT * deviation * sqrt(log((double)total_samples + 1) / ((double)configuration->sample_count + 1)));
+            if (score > best_score){
+                best_score = score;
+                taken = candidates[i];
+            }
+        }
+    }
+    *optimizer_parameter_a = arc_configurations[taken].ecc_parameter_a;
+    *optimizer_parameter_b = arc_configurations[taken].ecc_parameter_b;
+    *num_threads = arc_configurations[taken].num_threads;
+    pthread_mutex_unlock(&configuration_lock);
+    if (taken != chosen){
+        __atomic_fetch_add(&arc_stats_counters.explorations, 1, __ATOMIC_RELAXED);
+        if(PRINT)
+            printf("Exploring configuration %d-%" PRIu32 "-%" PRIu32 " on %" PRIu32 " threads\n", ecc_algorithm, *optimizer_parameter_a, *optimizer_parameter_b, *num_threads);
+    }
+}
+
+// arc_optimize:
+// Given user constraints determine which encoding mode to use
+// params:
+// memory_constraint        -   maximum amount of memory overhead to introduce
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// optimizer_parameter_a    -   first resulting ecc method parameter
+// optimizer_parameter_b    -   second resulting ecc method parameter (if applicable, 0 otherwise)
+// num_threads              -   number of threads to encode with
+// return:
+// identifier               -   identifier to determine which ecc method to use (0 on failure)
+int arc_optimize(double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* optimizer_parameter_a, uint32_t* optimizer_parameter_b, uint32_t* num_threads){
+    *num_threads = AVAIL_THREADS;
+    int optimizer_choice;
+    // The optimizers walk the configuration table, which asynchronous encodes update concurrently
+    pthread_mutex_lock(&configuration_lock);
+    // Doesn't care about either
+    if (memory_constraint == ARC_ANY_SIZE && throughput_constraint == ARC_ANY_BW){
+        // When neither are required, use the method with highest memory overhead (aka most code bits)
+        optimizer_choice = arc_memory_optimizer(1000000, resiliency_constraint, resiliency_count, optimizer_parameter_a, optimizer_parameter_b);
+    // Only cares about storage
+    } else if (memory_constraint != ARC_ANY_SIZE && throughput_constraint == ARC_ANY_BW) {
+        optimizer_choice = arc_memory_optimizer(memory_constraint, resiliency_constraint, resiliency_count, optimizer_parameter_a, optimizer_parameter_b);
+    // Only cares about time
+    } else if (memory_constraint == ARC_ANY_SIZE && throughput_constraint != ARC_ANY_BW) {
+        optimizer_choice = arc_throughput_optimizer(throughput_constraint, resiliency_constraint, resiliency_count, optimizer_parameter_a, optimizer_parameter_b, num_threads);
+    // Cares about both
+    } else {
+        optimizer_choice = arc_joint_optimizer(memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_parameter_a, optimizer_parameter_b, num_threads);
+    }
+    pthread_mutex_unlock(&configuration_lock);
+    // Drop threads that cannot help once the chosen method is memory-bound
+    if (optimizer_choice >= PARITY_ID && optimizer_choice <= RS_ID){
+        *num_threads = arc_roofline_threads(optimizer_choice, *optimizer_parameter_a, *optimizer_parameter_b, *num_threads, throughput_constraint);
+        // Let the exploration policy pick among the near-optimal alternatives
+        if (ARC_EXPLORE != ARC_EXPLORE_NONE){
+            arc_explore(optimizer_choice, memory_constraint, throughput_constraint, optimizer_parameter_a, optimizer_parameter_b, num_threads);
+        }
+    }
+    return optimizer_choice;
+}
+
+// arc_configuration_throughput:
+// Looks up the bandwidth the configuration table predicts for a configuration
+// params:
+// ecc_algorithm        -   identifier of the ecc method
+// parameter_a          -   first ecc method parameter
+// parameter_b          -   second ecc method parameter
+// num_threads          -   number of threads
+// return:
+// throughput_overhead  -   predicted bandwidth in MB/s, or -1 if the configuration is not in the table
+double arc_configuration_throughput(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t num_threads){
+    int i;
+    double throughput_overhead = -1;
+    pthread_mutex_lock(&configuration_lock);
+    for (i = 0; i < NUM_CONFIGURATIONS; i++){
+        if (arc_configurations[i].ecc_algorithm == ecc_algorithm && arc_configurations[i].num_threads == num_threads 
+        && arc_configurations[i].ecc_parameter_a == parameter_a && arc_configurations[i].ecc_parameter_b == parameter_b){
+            throughput_overhead = arc_configurations[i].throughput_overhead;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&configuration_lock);
+    return throughput_overhead;
+}
 
-                        // Change data and code devices for next iteration
-                        if (data_devices == 252){
-                            data_devices = 255;
-                            code_devices = 1;
-                        } else {
-                            data_devices = data_devices + 4;
-                            code_devices = code_devices - 4;
-                        }
-                        // Free encoded data
-                        free(encoded);
-                    }
+// arc_configuration_estimate:
+// Looks up the current bandwidth estimate of a configuration and how much evidence is behind it
+// params:
+// ecc_algorithm        -   identifier of the ecc method
+// parameter_a          -   first ecc method parameter
+// parameter_b          -   second ecc method parameter
+// num_threads          -   number of threads
+// throughput_overhead  -   address to store the estimated mean bandwidth in MB/s
+// throughput_variance  -   address to store the variance of the bandwidth in (MB/s)^2
+// sample_count         -   address to store the number of measurements behind the estimate (0 if it was interpolated)
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=configuration not in the table)
+int arc_configuration_estimate(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t num_threads, double* throughput_overhead, double* throughput_variance, uint32_t* sample_count){
+    int i;
+    int found = 0;
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    pthread_mutex_lock(&configuration_lock);
+    for (i = 0; i < NUM_CONFIGURATIONS; i++){
+        if (arc_configurations[i].ecc_algorithm == ecc_algorithm && arc_configurations[i].num_threads == num_threads 
+        && arc_configurations[i].ecc_parameter_a == parameter_a && arc_configurations[i].ecc_parameter_b == parameter_b){
+            *throughput_overhead = arc_configurations[i].throughput_overhead;
+            *throughput_variance = arc_configurations[i].throughput_variance;
+            *sample_count = arc_configurations[i].sample_count;
+            found = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&configuration_lock);
+    return found;
+}
 
-                    // End Training 
-                    gettimeofday(&method_stop, NULL);
-                    double method_time_taken = (double)(method_stop.tv_usec - method_start.tv_usec) / 1000000 + (double)(method_stop.tv_sec - method_start.tv_sec);
-                    if(PRINT)
-                        printf("Reed-Solomon Training Completed in %lf Seconds!\n", method_time_taken);
-                }
+// arc_update_configuration:
+// Folds a newly measured throughput into the configuration that was used and nudges its neighbouring configurations
+// (the next smaller and larger parameter with the same method and threads, and the same configuration on one thread
+// fewer or more) by a share of the same relative change
+// params:
+// ecc_algorithm        -   identifier of the ecc method used
+// parameter_a          -   first ecc method parameter used
+// parameter_b          -   second ecc method parameter used
+// num_threads          -   number of threads used
+// throughput_overhead  -   measured bandwidth in MB/s
+void arc_update_configuration(int ecc_algorithm, uint32_t parameter_a, uint32_t parameter_b, uint32_t num_threads, double throughput_overhead){
+    int i;
+    int used = -1;
+    int smaller = -1;
+    int larger = -1;
+    int fewer_threads = -1;
+    int more_threads = -1;
+    if (!(throughput_overhead > 0) || isinf(throughput_overhead)){
+        return;
+    }
+    ARC_TRACE_BEGIN(update_configuration);
+    pthread_mutex_lock(&configuration_lock);
+    for (i = 0; i < NUM_CONFIGURATIONS; i++){
+        struct configuration_information* configuration = &arc_configurations[i];
+        if (configuration->ecc_algorithm != ecc_algorithm){
+            continue;
+        }
+        // Packed and unpacked layouts of the same method are not neighbours (Reed-Solomon trades parameter b for a)
+        int same_family = (ecc_algorithm == RS_ID) || (configuration->ecc_parameter_b == parameter_b);
+        if (configuration->num_threads == num_threads && same_family){
+            if (configuration->ecc_parameter_a == parameter_a && configuration->ecc_parameter_b == parameter_b){
+                used = i;
+            } else if (configuration->ecc_parameter_a < parameter_a && (smaller == -1 || configuration->ecc_parameter_a > arc_configurations[smaller].ecc_parameter_a)){
+                smaller = i;
+            } else if (configuration->ecc_parameter_a > parameter_a && (larger == -1 || configuration->ecc_parameter_a < arc_configurations[larger].ecc_parameter_a)){
+                larger = i;
             }
-            // Free strings
-            free(thread_file_location);
-            free(thread_file_name);
-        // If the file does exist, pull in information from file
-        } else {
-            int tmp_alg;
-            uint32_t tmp_a;
-            uint32_t tmp_b;
-            uint32_t tmp_th;
-            double tmp_mo;
-            double tmp_to;
-            char *buffer = NULL;
-            size_t len = 0;
-            ssize_t read;
-            while ((read = getline(&buffer, &len, fp)) != -1) {
-                // Skip the first line
-                if(!starts_with(buffer, "ecc_algorithm")){
-                    // Scan each line and pull the specific values
-                    sscanf(buffer, "%d,%" SCNu32 ",%" SCNu32 ",%" SCNu32 ",%lf,%lf", &tmp_alg, &tmp_a, &tmp_b, &tmp_th, &tmp_mo, &tmp_to);
-                    // Store these values in the configurations array
-                    arc_configurations[current_config_array_index].ecc_algorithm = tmp_alg;
-                    arc_configurations[current_config_array_index].ecc_parameter_a = tmp_a;
-                    arc_configurations[current_config_array_index].ecc_parameter_b = tmp_b;
-                    arc_configurations[current_config_array_index].num_threads = tmp_th;
-                    arc_configurations[current_config_array_index].memory_overhead  = tmp_mo;
-                    arc_configurations[current_config_array_index].throughput_overhead  = tmp_to;
-                    // Increment current config array index
-                    current_config_array_index++;
-                }
+        } else if (configuration->ecc_parameter_a == parameter_a && configuration->ecc_parameter_b == parameter_b){
+            if (configuration->num_threads + 1 == num_threads){
+                fewer_threads = i;
+            } else if (configuration->num_threads == num_threads + 1){
+                more_threads = i;
             }
-            fclose(fp);
-            if (buffer){
-                free(buffer);
+        }
+    }
+    if (used != -1){
+        struct configuration_information* configuration = &arc_configurations[used];
+        double mean = configuration->throughput_overhead;
+        double variance = configuration->throughput_variance;
+        // Weigh every sample equally until there are enough of them for the exponentially weighted average to take over
+        double weight = 1.0 / ((double)configuration->sample_count + 1);
+        if (weight < ARC_UPDATE_WEIGHT){
+            weight = ARC_UPDATE_WEIGHT;
+        }
+        // Clamp the measurement to the outlier cutoff so a single noisy run only moves the estimate a bounded amount
+        // (a spread of at least 1% of the mean is assumed so a real change in throughput is still followed, and
+        // estimates with fewer than two samples behind them take the measurement as is)
+        double sample = throughput_overhead;
+        if (configuration->sample_count >= 2){
+            double deviation = sqrt(variance);
+            if (deviation < mean * 0.01){
+                deviation = mean * 0.01;
+            }
+            if (sample > mean + (ARC_OUTLIER_CUTOFF * deviation)){
+                sample = mean + (ARC_OUTLIER_CUTOFF * deviation);
+            } else if (sample < mean - (ARC_OUTLIER_CUTOFF * deviation)){
+                sample = mean - (ARC_OUTLIER_CUTOFF * deviation);
+            }
+        }
+        // Exponentially weighted mean and variance (identical to the running mean and variance while weight = 1 / (count + 1))
+        double delta = sample - mean;
+        configuration->throughput_overhead = mean + (weight * delta);
+        configuration->throughput_variance = (1 - weight) * (variance + (weight * delta * delta));
+        if (configuration->sample_count < UINT32_MAX){
+            configuration->sample_count++;
+        }
+
+        // Pass the relative change on to the neighbours, weighted by how little evidence each already has
+        int neighbours[4] = {smaller, larger, fewer_threads, more_threads};
+        double change = (mean > 0) ? (configuration->throughput_overhead / mean) - 1 : 0;
+        for (i = 0; i < 4; i++){
+            if (neighbours[i] == -1){
+                continue;
+            }
+            struct configuration_information* neighbour = &arc_configurations[neighbours[i]];
+            double neighbour_weight = 1.0 / ((double)neighbour->sample_count + 1);
+            if (neighbour_weight < ARC_UPDATE_WEIGHT){
+                neighbour_weight = ARC_UPDATE_WEIGHT;
             }
+            neighbour->throughput_overhead = neighbour->throughput_overhead * (1 + (ARC_NEIGHBOR_WEIGHT * neighbour_weight * change));
         }
+    }
+    pthread_mutex_unlock(&configuration_lock);
+    ARC_TRACE_END(update_configuration);
+}
+
+// ARC Main Section
+// ################
+// arc_encode:
+// Encode given data using best ECC approach based on given constraints
+// params:
+// data                     -   uint8_t data stream
+// data_size                -   size of data stream
+// memory_constraint        -   maximum amount of memory overhead to introduce (1 - (encoded_size/original_size))
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// encoded_data             -   address of pointer to uint8_t arc encoded data stream
+// encoded_data_size        -   address of pointer to size of arc encoded data stream
+// return:
+// err                      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_encode(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    return arc_encode_reported(data, data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, encoded_data, encoded_data_size, NULL);
+}
+
+// arc_encode_reported:
+// Encode given data using best ECC approach based on given constraints and report what was chosen and how long each phase took
+// params:
+// data                     -   uint8_t data stream
+// data_size                -   size of data stream
+// memory_constraint        -   maximum amount of memory overhead to introduce (1 - (encoded_size/original_size))
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// encoded_data             -   address of pointer to uint8_t arc encoded data stream
+// encoded_data_size        -   address of pointer to size of arc encoded data stream
+// report                   -   address of report to fill (may be NULL)
+// return:
+// err                      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_encode_reported(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size, struct arc_encode_report* report){
+    // Ensure initialization was called first
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    // Check that all constraints are valid
+    if (arc_check_constraints(memory_constraint, throughput_constraint, resiliency_count) == 0){
+        return 0;
+    }
+    // printf("ARC Encoding Started\n");
+    double call_start = arc_monotonic_seconds();
+
+    // Given user constraints determine which encoding mode to use
+    int err;
+    uint32_t optimizer_parameter_a;
+    uint32_t optimizer_parameter_b;
+    uint32_t num_threads;
+    ARC_TRACE_BEGIN(optimize);
+    int optimizer_choice = arc_optimize(memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b, &num_threads);
+    ARC_TRACE_END(optimize);
+    double optimize_stop = arc_monotonic_seconds();
+
+    // Given the optimizer choice, encode with the correct scheme
+    double start, stop;
+    ARC_TRACE_BEGIN(encode);
+    if (optimizer_choice >= PARITY_ID && optimizer_choice <= SECDED_ID && optimizer_parameter_b == 1){
         if(PRINT)
-            printf("%d Thread(s) Training and Loading Completed!\n", i);
+            printf("Utilizing Packed ECC method %d-%" PRIu32 " on %" PRIu32 " threads\n", optimizer_choice, optimizer_parameter_a, num_threads);
+        start = arc_monotonic_seconds();
+        err = arc_configuration_encode(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, data, data_size, encoded_data, encoded_data_size);
+        stop = arc_monotonic_seconds();
+    } else if (optimizer_choice == PARITY_ID){
+        if(PRINT)
+            printf("Utilizing Parity-%" PRIu32 " on %" PRIu32 " threads\n", optimizer_parameter_a, num_threads);
+        start = arc_monotonic_seconds();
+        err = arc_parity_encode(data, data_size, optimizer_parameter_a, num_threads, encoded_data, encoded_data_size);
+        stop = arc_monotonic_seconds();
+    } else if (optimizer_choice == HAMMING_ID){
+        if(PRINT)
+            printf("Utilizing Hamming-%" PRIu32 " on %" PRIu32 " threads\n", optimizer_parameter_a, num_threads);
+        start = arc_monotonic_seconds();
+        err = arc_hamming_encode(data, data_size, optimizer_parameter_a, num_threads, encoded_data, encoded_data_size);
+        stop = arc_monotonic_seconds();
+    } else if (optimizer_choice == SECDED_ID){
+        if(PRINT)
+            printf("Utilizing SECDED-%"PRIu32" on %" PRIu32 " threads\n", optimizer_parameter_a, num_threads);
+        start = arc_monotonic_seconds();
+        err = arc_secded_encode(data, data_size, optimizer_parameter_a, num_threads, encoded_data, encoded_data_size);
+        stop = arc_monotonic_seconds();
+    } else if (optimizer_choice == RS_ID){
+        if(PRINT)
+            printf("Utilizing Reed Solomon-<k=%" PRIu32 ",m=%" PRIu32 ",w=%" PRIu32 "> on %" PRIu32 " threads\n", optimizer_parameter_a, optimizer_parameter_b, 8, num_threads);
+        start = arc_monotonic_seconds();
+        err = arc_reed_solomon_encode(data, data_size, optimizer_parameter_a, optimizer_parameter_b, num_threads, encoded_data, encoded_data_size);
+        stop = arc_monotonic_seconds();
+    } else {
+        ARC_TRACE_END(encode);
+        arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, 0, 0, 0, 0, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
+        printf("Encoding Error: No encoding function meets required criteria\n");
+        return 0;
     }
-    // Return once everything has been loaded
-    gettimeofday(&total_stop, NULL);
-    double total_time_taken = (double)(total_stop.tv_usec - total_start.tv_usec) / 1000000 + (double)(total_stop.tv_sec - total_start.tv_sec);
-    if(PRINT) {
-    printf("ARC Training and Loading Process Finished!\n");
-    printf("Total Training Time Taken: %lf Seconds\n", total_time_taken);
+    ARC_TRACE_END(encode);
+    // Check for encoding errors
+    if (err == 0){
+        arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+            optimizer_parameter_b, num_threads, 0, optimize_stop - call_start, stop - start, arc_monotonic_seconds() - call_start);
+        printf("Encoding Error: Error has occurred during encoding process\n");
+        return 0;
     }
 
-    // Free allocated simulated data
-    free(data);
+    // Get throughput of the encoding process
+    double encode_time_taken = stop - start;
+    double throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
+    arc_stats_record_encode(optimizer_choice, data_size, encode_time_taken);
+    double predicted_throughput = (report != NULL) ? arc_configuration_throughput(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads) : -1;
+                        
+    // Update the corresponding configuration in configuration array
+    arc_update_configuration(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, throughput_overhead);
+
+    // Describe what was chosen and where the time went
+    if (report != NULL){
+        double call_stop = arc_monotonic_seconds();
+        report->ecc_algorithm = optimizer_choice;
+        report->ecc_parameter_a = optimizer_parameter_a;
+        report->ecc_parameter_b = optimizer_parameter_b;
+        report->num_threads = num_threads;
+        report->predicted_throughput = predicted_throughput;
+        report->measured_throughput = throughput_overhead;
+        report->bytes_in = data_size;
+        report->bytes_out = *encoded_data_size;
+        report->optimize_seconds = optimize_stop - call_start;
+        report->encode_seconds = encode_time_taken;
+        report->update_seconds = call_stop - stop;
+        report->total_seconds = call_stop - call_start;
+        report->roofline_fraction = arc_roofline_fraction(data_size, *encoded_data_size, encode_time_taken, num_threads);
+    }
+    arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+        optimizer_parameter_b, num_threads, *encoded_data_size, optimize_stop - call_start, encode_time_taken, arc_monotonic_seconds() - call_start);
 
+    // Return data
+    if(PRINT)
+        printf("ARC Encoding Completed\n");
     return 1;
 }
 
-// arc_save:
-// Saves training data collected during normal use to resource files. This process helps 
-// ARC become smarter over time and should be done before arc_close is called.
+// arc_encodev:
+// Encode a data stream held in a list of fragments using best ECC approach based on given constraints,
+// without gathering the fragments into one buffer first
+// params:
+// data_parts               -   array of fragments forming the data stream in order
+// part_count               -   number of fragments
+// memory_constraint        -   maximum amount of memory overhead to introduce (1 - (encoded_size/original_size))
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// encoded_data             -   address of pointer to uint8_t arc encoded data stream
+// encoded_data_size        -   address of pointer to size of arc encoded data stream
 // return:
-// x            -   Success=1, Failure=0
-int arc_save(){
-    // Initialize Resources for Later Use
-    int i, j;
-    FILE *fp;
+// err                      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// The result is identical to arc_encode on the concatenated fragments and decodes with arc_decode
+int arc_encodev(const struct iovec* data_parts, int part_count, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    // Ensure initialization was called first
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    // Check that all constraints are valid
+    if (arc_check_constraints(memory_constraint, throughput_constraint, resiliency_count) == 0){
+        return 0;
+    }
+
+    double call_start = arc_monotonic_seconds();
+    uint64_t parts_size = 0;
+    int part;
+    for (part = 0; part < part_count; part++){
+        parts_size = parts_size + data_parts[part].iov_len;
+    }
+    uint32_t data_size = (parts_size > UINT32_MAX) ? UINT32_MAX : (uint32_t)parts_size;
+
+    // Given user constraints determine which encoding mode to use
+    uint32_t optimizer_parameter_a;
+    uint32_t optimizer_parameter_b;
+    uint32_t num_threads;
+    ARC_TRACE_BEGIN(optimize);
+    int optimizer_choice = arc_optimize(memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b, &num_threads);
+    ARC_TRACE_END(optimize);
+    double optimize_stop = arc_monotonic_seconds();
+    if (optimizer_choice < PARITY_ID || optimizer_choice > RS_ID){
+        arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, 0, 0, 0, 0, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
+        printf("Encoding Error: No encoding function meets required criteria\n");
+        return 0;
+    }
+    if(PRINT)
+        printf("Utilizing ECC method %d-%" PRIu32 "-%" PRIu32 " on %" PRIu32 " threads over %d fragments\n", optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, part_count);
+
+    // Encode straight from the fragments
+    double start, stop;
+    start = arc_monotonic_seconds();
+    int err = arc_configuration_encodev(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, data_parts, part_count, encoded_data, encoded_data_size);
+    stop = arc_monotonic_seconds();
+    if (err == 0){
+        arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+            optimizer_parameter_b, num_threads, 0, optimize_stop - call_start, stop - start, arc_monotonic_seconds() - call_start);
+        printf("Encoding Error: Error has occurred during encoding process\n");
+        return 0;
+    }
+
+    // Update the corresponding configuration in configuration array
+    struct arc_layout layout;
+    arc_layout_read(*encoded_data, *encoded_data_size, &layout);
+    double encode_time_taken = stop - start;
+    double throughput_overhead = (layout.data_size / encode_time_taken)/1E6; // MB/s
+    arc_stats_record_encode(optimizer_choice, layout.data_size, encode_time_taken);
+    arc_update_configuration(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, throughput_overhead);
+    arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+        optimizer_parameter_b, num_threads, *encoded_data_size, optimize_stop - call_start, encode_time_taken, arc_monotonic_seconds() - call_start);
+
+    if(PRINT)
+        printf("ARC Encoding Completed\n");
+    return 1;
+}
+
+// arc_encode_batch:
+// Encode many data streams at once using a single ECC plan, a single parallel region over the
+// blocks of every stream, and a single contiguous result allocation
+// params:
+// data                     -   array of uint8_t data streams
+// data_sizes               -   array of sizes of each data stream
+// batch_count              -   number of data streams
+// memory_constraint        -   maximum amount of memory overhead to introduce (1 - (encoded_size/original_size))
+// throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
+// resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
+// resiliency_count         -   Number of values set in resiliency constraint list
+// encoded_data             -   address of pointer to uint8_t buffer holding every arc encoded data stream
+// encoded_offsets          -   caller provided array of (batch_count + 1) entries receiving the offset of each
+//                              encoded data stream within encoded_data, with the final entry holding the total size
+// encoded_data_size        -   address of pointer to total size of encoded_data
+// return:
+// err                      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// encoded stream i can be decoded with arc_decode(encoded_data + encoded_offsets[i], encoded_offsets[i+1] - encoded_offsets[i], ...)
+int arc_encode_batch(uint8_t** data, uint32_t* data_sizes, uint32_t batch_count, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_offsets, uint32_t* encoded_data_size){
+    // Ensure initialization was called first
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    // Check that all constraints are valid
+    if (arc_check_constraints(memory_constraint, throughput_constraint, resiliency_count) == 0){
+        return 0;
+    }
+    if (batch_count == 0){
+        printf("INVALID BATCH: Please provide at least one data stream. . .\n");
+        return 0;
+    }
+    double call_start = arc_monotonic_seconds();
+    uint32_t i;
+    uint64_t total_size = 0;
+    uint64_t total_data_size = 0;
+    for (i = 0; i < batch_count; i++){
+        total_data_size = total_data_size + data_sizes[i];
+    }
+    // Captures log the batch as one call over the combined data
+    uint32_t capture_size = (total_data_size > UINT32_MAX) ? UINT32_MAX : (uint32_t)total_data_size;
+
+    // Plan every data stream with a single optimizer call
+    uint32_t optimizer_parameter_a;
+    uint32_t optimizer_parameter_b;
+    uint32_t num_threads;
+    ARC_TRACE_BEGIN(optimize);
+    int optimizer_choice = arc_optimize(memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b, &num_threads);
+    ARC_TRACE_END(optimize);
+    double optimize_stop = arc_monotonic_seconds();
+    if (optimizer_choice < PARITY_ID || optimizer_choice > RS_ID){
+        arc_capture_encode(capture_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, 0, 0, 0, 0, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
+        printf("Encoding Error: No encoding function meets required criteria\n");
+        return 0;
+    }
+    if(PRINT)
+        printf("Utilizing ECC method %d <%" PRIu32 ",%" PRIu32 "> on %" PRIu32 " threads for %" PRIu32 " data streams\n", optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, batch_count);
+
+    // Determine the layout and location of every encoded data stream
+    struct arc_layout* layouts = talloc(struct arc_layout, batch_count);
+    for (i = 0; i < batch_count; i++){
+        if (arc_layout_create(optimizer_choice, data_sizes[i], optimizer_parameter_a, optimizer_parameter_b, num_threads, &layouts[i]) == 0){
+            free(layouts);
+            arc_capture_encode(capture_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+                optimizer_parameter_b, num_threads, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
+            return 0;
+        }
+        encoded_offsets[i] = (uint32_t)total_size;
+        total_size = total_size + layouts[i].encoded_size;
+    }
+    if (total_size > UINT32_MAX){
+        printf("INVALID BATCH: Combined encoded size exceeds 4 GB. . .\n");
+        free(layouts);
+        arc_capture_encode(capture_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+            optimizer_parameter_b, num_threads, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
+        return 0;
+    }
+    encoded_offsets[batch_count] = (uint32_t)total_size;
+
+    // Create a single resulting array and write the metadata of every data stream
+    *encoded_data_size = (uint32_t)total_size;
+    ARC_TRACE_BEGIN(allocate);
+    *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
+    for (i = 0; i < batch_count; i++){
+        arc_layout_write_metadata(&layouts[i], data[i], *encoded_data + encoded_offsets[i]);
+    }
+
+    // Split the union of all blocks into tasks of roughly 64 KB of data each
+    uint32_t block_data_size = (optimizer_choice == RS_ID) ? optimizer_parameter_a * 8 : optimizer_parameter_a;
+    uint32_t blocks_per_task = 65536 / block_data_size;
+    if (blocks_per_task < 1){
+        blocks_per_task = 1;
+    }
+    // Packed check bits are written a whole group of 8 blocks at a time
+    if (layouts[0].packed){
+        blocks_per_task = (blocks_per_task < 8) ? 8 : blocks_per_task - (blocks_per_task % 8);
+    }
+    uint32_t task_count = 0;
+    for (i = 0; i < batch_count; i++){
+        task_count = task_count + (layouts[i].total_blocks + blocks_per_task - 1) / blocks_per_task;
+    }
+    uint32_t* task_stream = talloc(uint32_t, task_count + 1);
+    uint32_t* task_first_block = talloc(uint32_t, task_count + 1);
+    uint32_t current_task = 0;
+    for (i = 0; i < batch_count; i++){
+        uint32_t first_block;
+        for (first_block = 0; first_block < layouts[i].total_blocks; first_block = first_block + blocks_per_task){
+            task_stream[current_task] = i;
+            task_first_block[current_task] = first_block;
+            current_task++;
+        }
+    }
 
-    // For each number of available threads, write the updated values to the file
-    for(i = 1; i <= AVAIL_THREADS; i++){
-        // Create the pointer to the file
-        char num_thread_string[8];
-        sprintf(num_thread_string, "%d", i);
-        char * thread_file_name = concat(num_thread_string, thread_resource_file);
-        char * thread_file_location = concat(cache_resource_location, thread_file_name);
-        fp = fopen(thread_file_location, "w");
-        fprintf(fp, "ecc_algorithm,ecc_parameter_a,ecc_parameter_b,num_threads,memory_overhead,throughput_overhead\n");
+    // Build every RS matrix needed before entering the parallel region
+    int* matrices[257] = {NULL};
+    if (optimizer_choice == RS_ID){
+        for (i = 0; i < batch_count; i++){
+            arc_rs_matrix_cache_create(&layouts[i], matrices);
+        }
+    }
 
-        // Iterate over all configurations and write the corresponding thread configurations to file
-        for (j = 0; j < NUM_CONFIGURATIONS; j++){
-            if (arc_configurations[j].num_threads == i){
-                fprintf(fp, "%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%lf,%lf\n", arc_configurations[j].ecc_algorithm, arc_configurations[j].ecc_parameter_a, arc_configurations[j].ecc_parameter_b, arc_configurations[j].num_threads, arc_configurations[j].memory_overhead, arc_configurations[j].throughput_overhead);
+    // Set number of threads
+    omp_set_num_threads(num_threads);
+
+    // Encode the blocks of every data stream within one parallel region
+    double start, stop;
+    start = arc_monotonic_seconds();
+    uint32_t tasks_processed;
+    #pragma omp parallel
+    {
+        ARC_TRACE_BEGIN(encode_kernel);
+        #pragma omp for schedule(dynamic, 1) nowait
+        for (tasks_processed = 0; tasks_processed < task_count; tasks_processed++){
+            uint32_t stream = task_stream[tasks_processed];
+            uint32_t last_block = task_first_block[tasks_processed] + blocks_per_task;
+            uint32_t block;
+            if (last_block > layouts[stream].total_blocks){
+                last_block = layouts[stream].total_blocks;
+            }
+            if (layouts[stream].packed){
+                for (block = task_first_block[tasks_processed]; block < last_block; block = block + 8){
+                    arc_encode_group(&layouts[stream], block / 8, data[stream], *encoded_data + encoded_offsets[stream]);
+                }
+            } else {
+                for (block = task_first_block[tasks_processed]; block < last_block; block++){
+                    arc_encode_block(&layouts[stream], block, data[stream], *encoded_data + encoded_offsets[stream], matrices);
+                }
             }
         }
-
-        // Close file once all configurations have been written
-        fclose(fp);
+        ARC_TRACE_END(encode_kernel);
+    }
+    stop = arc_monotonic_seconds();
+
+    // Get throughput of the encoding process and update the configuration that was used
+    double encode_time_taken = stop - start;
+    arc_stats_record_encode(optimizer_choice, total_data_size, encode_time_taken);
+    if (encode_time_taken > 0 && total_data_size > 0){
+        double throughput_overhead = (total_data_size / encode_time_taken)/1E6; // MB/s
+        arc_update_configuration(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, throughput_overhead);
     }
 
-    return 1;
-}
+    // Free allocated variables
+    arc_rs_matrix_cache_free(matrices);
+    free(task_stream);
+    free(task_first_block);
+    free(layouts);
+    arc_capture_encode(capture_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+        optimizer_parameter_b, num_threads, *encoded_data_size, optimize_stop - call_start, encode_time_taken, arc_monotonic_seconds() - call_start);
 
-// arc_close:
-// Frees allocated resources needed for ARC to be used
-// return:
-// x            -   Success=1, Failure=0
-int arc_close(){
-    // Free arc configurations list
-    free(arc_configurations);
-    // Set init back to false 
-    INIT = 0;
     if(PRINT)
-        printf("ARC successfully closed\n");
+        printf("ARC Batch Encoding Completed\n");
     return 1;
 }
 
-// ARC Main Section
-// ################
-// arc_encode:
-// Encode given data using best ECC approach based on given constraints
+// arc_encode_parts:
+// Encode the given data using the split layout without copying the payload, so the encoded data stream
+// can be written with a single writev call
 // params:
 // data                     -   uint8_t data stream
 // data_size                -   size of data stream
@@ -731,111 +5043,73 @@ int arc_close(){
 // throughput_constraint    -   minimum bandwidth ARC should have in MB/s (data_size / encode_time_taken)/1E6)
 // resiliency_constraint    -   list of ECC methods to choose from / number of errors predicted to occur per MB of data
 // resiliency_count         -   Number of values set in resiliency constraint list
-// encoded_data             -   address of pointer to uint8_t arc encoded data stream
-// encoded_data_size        -   address of pointer to size of arc encoded data stream
+// encoded_parts            -   caller provided array of 3 iovecs receiving the metadata, the payload (data itself),
+//                              and the check byte trailer which together form the encoded data stream
+// check_data               -   address of pointer to the buffer holding the metadata and trailer (freed by the caller)
 // return:
 // err                      -   error code to determine if sucessful (1=sucessful,0=unsucessful)
-int arc_encode(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint8_t** encoded_data, uint32_t* encoded_data_size){
+int arc_encode_parts(uint8_t* data, uint32_t data_size, double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, struct iovec* encoded_parts, uint8_t** check_data){
     // Ensure initialization was called first
     if (!INIT){
         printf("Initialization Error: Please initialize ARC before further use\n");
         return 0;
     }
     // Check that all constraints are valid
-    if (memory_constraint <= 0 && memory_constraint != ARC_ANY_SIZE){
-        printf("INVALID MEMORY CONSTRAINT: Please ensure memory constraint is ARC_ANY_SIZE or greater than 0. . .\n");
-        return 0;
-    }
-    if (throughput_constraint <= 0 && throughput_constraint != ARC_ANY_BW){
-        printf("INVALID TIME CONSTRAINT: Please ensure timing constraint is ARC_ANY_BW greater than 0. . .\n");
-        return 0;
-    }
-    if (resiliency_count <= 0){
-        printf("INVALID RESILIENCY CONSTRAINT: Please ensure resiliency constraint is at least [ARC_ANY_ECC] and resiliency_count is greater than 0. . .\n");
+    if (arc_check_constraints(memory_constraint, throughput_constraint, resiliency_count) == 0){
         return 0;
     }
-    // printf("ARC Encoding Started\n");
+
+    double call_start = arc_monotonic_seconds();
 
     // Given user constraints determine which encoding mode to use
-    int err;
-    int optimizer_choice;
     uint32_t optimizer_parameter_a;
     uint32_t optimizer_parameter_b;
-    uint32_t num_threads = AVAIL_THREADS;
-
-    // Doesn't care about either
-    if (memory_constraint == ARC_ANY_SIZE && throughput_constraint == ARC_ANY_BW){
-        // When neither are required, use the method with highest memory overhead (aka most code bits)
-        //num_threads = AVAIL_THREADS;
-        optimizer_choice = arc_memory_optimizer(1000000, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b);
-    // Only cares about storage
-    } else if (memory_constraint != ARC_ANY_SIZE && throughput_constraint == ARC_ANY_BW) {
-        //num_threads = AVAIL_THREADS;
-        optimizer_choice = arc_memory_optimizer(memory_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b);
-    // Only cares about time
-    } else if (memory_constraint == ARC_ANY_SIZE && throughput_constraint != ARC_ANY_BW) {
-        optimizer_choice = arc_throughput_optimizer(throughput_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b, &num_threads);
-    // Cares about both
-    } else if (memory_constraint != ARC_ANY_SIZE && throughput_constraint != ARC_ANY_BW){
-        optimizer_choice = arc_joint_optimizer(memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b, &num_threads);
-    } else {
-        printf("Optimizer Error: This should not occur...\n");
-        return 0;
-    }
-
-    // Given the optimizer choice, encode with the correct scheme
-    struct timeval start, stop;
-    if (optimizer_choice == PARITY_ID){
-        if(PRINT)
-            printf("Utilizing Parity-%" PRIu32 " on %" PRIu32 " threads\n", optimizer_parameter_a, num_threads);
-        gettimeofday(&start, NULL);
-        err = arc_parity_encode(data, data_size, optimizer_parameter_a, num_threads, encoded_data, encoded_data_size);
-        gettimeofday(&stop, NULL);
-    } else if (optimizer_choice == HAMMING_ID){
-        if(PRINT)
-            printf("Utilizing Hamming-%" PRIu32 " on %" PRIu32 " threads\n", optimizer_parameter_a, num_threads);
-        gettimeofday(&start, NULL);
-        err = arc_hamming_encode(data, data_size, optimizer_parameter_a, num_threads, encoded_data, encoded_data_size);
-        gettimeofday(&stop, NULL);
-    } else if (optimizer_choice == SECDED_ID){
-        if(PRINT)
-            printf("Utilizing SECDED-%"PRIu32" on %" PRIu32 " threads\n", optimizer_parameter_a, num_threads);
-        gettimeofday(&start, NULL);
-        err = arc_secded_encode(data, data_size, optimizer_parameter_a, num_threads, encoded_data, encoded_data_size);
-        gettimeofday(&stop, NULL);
-    } else if (optimizer_choice == RS_ID){
-        if(PRINT)
-            printf("Utilizing Reed Solomon-<k=%" PRIu32 ",m=%" PRIu32 ",w=%" PRIu32 "> on %" PRIu32 " threads\n", optimizer_parameter_a, optimizer_parameter_b, 8, num_threads);
-        gettimeofday(&start, NULL);
-        err = arc_reed_solomon_encode(data, data_size, optimizer_parameter_a, optimizer_parameter_b, num_threads, encoded_data, encoded_data_size);
-        gettimeofday(&stop, NULL);
-    } else {
+    uint32_t num_threads;
+    ARC_TRACE_BEGIN(optimize);
+    int optimizer_choice = arc_optimize(memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, &optimizer_parameter_a, &optimizer_parameter_b, &num_threads);
+    ARC_TRACE_END(optimize);
+    double optimize_stop = arc_monotonic_seconds();
+    if (optimizer_choice < PARITY_ID || optimizer_choice > RS_ID){
+        arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, 0, 0, 0, 0, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
         printf("Encoding Error: No encoding function meets required criteria\n");
         return 0;
     }
-    // Check for encoding errors
-    if (err == 0){
-        printf("Encoding Error: Error has occurred during encoding process\n");
+
+    // Determine the split layout with the payload left in place
+    struct arc_layout layout;
+    if (arc_layout_create(optimizer_choice, data_size, optimizer_parameter_a, optimizer_parameter_b, num_threads, &layout) == 0){
+        arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+            optimizer_parameter_b, num_threads, 0, optimize_stop - call_start, 0, arc_monotonic_seconds() - call_start);
         return 0;
     }
-
-    // Get throughput of the encoding process
-    double encode_time_taken = (double)(stop.tv_usec - start.tv_usec) / 1000000 + (double)(stop.tv_sec - start.tv_sec);
-    double throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
-                        
-    // Update the corresponding configuration in configuration array
-    int i;
-    for (i = 0; i < NUM_CONFIGURATIONS; i++){
-        // Update configuration that was used
-        if (arc_configurations[i].ecc_algorithm == optimizer_choice && arc_configurations[i].num_threads == num_threads 
-        && arc_configurations[i].ecc_parameter_a == optimizer_parameter_a && arc_configurations[i].ecc_parameter_b == optimizer_parameter_b){
-            arc_configurations[i].throughput_overhead = (arc_configurations[i].throughput_overhead + throughput_overhead) / 2;
-        }
+    arc_layout_set_split(&layout, 1, 1);
+    *check_data = (uint8_t*)malloc(sizeof(uint8_t) * layout.encoded_size);
+    arc_layout_write_metadata(&layout, data, *check_data);
+
+    // Encode and time only the check bytes
+    double start, stop;
+    start = arc_monotonic_seconds();
+    arc_encode_blocks(&layout, data, *check_data, num_threads);
+    stop = arc_monotonic_seconds();
+
+    // Get throughput of the encoding process and update the configuration that was used
+    double encode_time_taken = stop - start;
+    arc_stats_record_encode(optimizer_choice, data_size, encode_time_taken);
+    if (encode_time_taken > 0 && data_size > 0){
+        double throughput_overhead = (data_size / encode_time_taken)/1E6; // MB/s
+        arc_update_configuration(optimizer_choice, optimizer_parameter_a, optimizer_parameter_b, num_threads, throughput_overhead);
     }
 
-    // Return data
-    if(PRINT)
-        printf("ARC Encoding Completed\n");
+    // Describe the encoded data stream as metadata, payload, and trailer
+    encoded_parts[0].iov_base = *check_data;
+    encoded_parts[0].iov_len = layout.metadata_length;
+    encoded_parts[1].iov_base = data;
+    encoded_parts[1].iov_len = data_size;
+    encoded_parts[2].iov_base = *check_data + layout.metadata_length;
+    encoded_parts[2].iov_len = layout.encoded_size - layout.metadata_length;
+    arc_capture_encode(data_size, memory_constraint, throughput_constraint, resiliency_constraint, resiliency_count, optimizer_choice, optimizer_parameter_a,
+        optimizer_parameter_b, num_threads, (uint32_t)(encoded_parts[0].iov_len + encoded_parts[1].iov_len + encoded_parts[2].iov_len), optimize_stop - call_start,
+        encode_time_taken, arc_monotonic_seconds() - call_start);
     return 1;
 }
 
@@ -857,13 +5131,26 @@ int arc_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** deco
     if(PRINT)
         printf("ARC Decoding Started\n");
 
+    double decode_start = arc_monotonic_seconds();
+    ARC_TRACE_BEGIN(decode);
+
     // Determine which method was used  
     uint8_t encoding_method = encoded_data[0];
 
     // Decompress with the correct decode method
     int err;
+    // If it starts with a versioned header
+    if (arc_header_present(encoded_data, encoded_data_size)){
+        if(PRINT)
+            printf("Versioned Header Found\n");
+        err = arc_layout_decode(encoded_data, encoded_data_size, decoded_data, decoded_data_size);
+    // If it was encoded with the split layout
+    } else if (encoding_method & SPLIT_LAYOUT_FLAG){
+        if(PRINT)
+            printf("Split Layout Encoding Found\n");
+        err = arc_layout_decode(encoded_data, encoded_data_size, decoded_data, decoded_data_size);
     // If it was encoded with parity
-    if (encoding_method == 0x01){
+    } else if (encoding_method == 0x01){
         if(PRINT)
             printf("Parity Encoding Found\n");
         err = arc_parity_decode(encoded_data, encoded_data_size, decoded_data, decoded_data_size);
@@ -882,33 +5169,519 @@ int arc_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** deco
             printf("Reed Solomon Encoding Found\n");
         err = arc_reed_solomon_decode(encoded_data, encoded_data_size, decoded_data, decoded_data_size);
     } else {
+        ARC_TRACE_END(decode);
         printf("INVALID ENCODING METHOD: No valid encoding method found to decode this data. . .\n");
         return 0;
     }
+    ARC_TRACE_END(decode);
+
+    // Record the decoding against the method that was used
+    struct arc_layout layout;
+    if (err == 1 && arc_layout_read(encoded_data, encoded_data_size, &layout) == 1){
+        arc_stats_record_decode(layout.ecc_algorithm, *decoded_data_size, arc_monotonic_seconds() - decode_start);
+    }
+
+    // Return data
+    if(PRINT)
+        printf("ARC Decoding Completed\n");
+    return err;
+}
+
+// arc_decode_zero_copy:
+// Decode the given encoded data, returning a pointer into the encoded data stream instead of a copy whenever possible
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// decoded_data         -   address of pointer to arc decoded uint8_t data stream
+// decoded_data_size    -   address of pointer to arc decoded data stream size
+// decoded_data_owned   -   address to store 1 if decoded_data was allocated and must be freed by the caller,
+//                          or 0 if it points into encoded_data
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// Only data streams encoded with ARC_SPLIT_LAYOUT that verify clean avoid the copy, all others fall back to arc_decode
+int arc_decode_zero_copy(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** decoded_data, uint32_t* decoded_data_size, int* decoded_data_owned){
+    // Ensure initialization was called first
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    *decoded_data_owned = 0;
+    double decode_start = arc_monotonic_seconds();
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 1 && layout.split){
+        // A clean split layout already holds the payload contiguously
+        uint32_t correctable_blocks, uncorrectable_blocks;
+        if (arc_layout_payload_intact(&layout, encoded_data) || (arc_check(encoded_data, encoded_data_size, NULL, &correctable_blocks, &uncorrectable_blocks) == 1
+            && correctable_blocks == 0 && uncorrectable_blocks == 0)){
+            *decoded_data = encoded_data + layout.metadata_length;
+            *decoded_data_size = layout.data_size;
+            arc_stats_record_decode(layout.ecc_algorithm, layout.data_size, arc_monotonic_seconds() - decode_start);
+            return 1;
+        }
+    }
+    int err = arc_decode(encoded_data, encoded_data_size, decoded_data, decoded_data_size);
+    *decoded_data_owned = (err == 1);
+    return err;
+}
+
+// arc_decode_range:
+// Decodes only the blocks covering a byte range of the original data stream
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// offset               -   offset of the first byte to decode within the original data stream
+// length               -   number of bytes to decode
+// decoded_data         -   caller allocated buffer of at least length bytes to hold the decoded range
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+// note:
+// Block offsets are computed directly from the metadata, so the cost is proportional to length
+// rather than to the size of the full data stream.
+int arc_decode_range(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t offset, uint32_t length, uint8_t* decoded_data){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    if (offset > layout.data_size || length > layout.data_size - offset){
+        printf("INVALID RANGE: Requested range extends past the end of the data stream. . .\n");
+        return 0;
+    }
+    if (length == 0){
+        return 1;
+    }
+
+    // Determine which blocks cover the requested range
+    uint32_t first_block = arc_layout_find_block(&layout, offset);
+    uint32_t last_block = arc_layout_find_block(&layout, offset + length - 1);
+    int* matrices[257] = {NULL};
+    if (layout.ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(&layout, matrices);
+    }
+
+    // Setup Loop Variables
+    uint32_t blocks_processed;
+    uint32_t span = last_block - first_block + 1;
+    uint32_t threads = (layout.threads < 1) ? 1 : layout.threads;
+    int chunk_size = arc_schedule_chunk(span, threads);
+    int decode_success = 1;
+    omp_set_num_threads(threads);
+
+    // Decode each covering block, only splitting across threads when the range is large
+    #pragma omp parallel for schedule(dynamic, chunk_size) if(span > (uint32_t)chunk_size)
+    for (blocks_processed = first_block; blocks_processed <= last_block; blocks_processed++){
+        uint32_t data_index, data_length, encoded_index;
+        arc_layout_block(&layout, blocks_processed, &data_index, &data_length, &encoded_index);
+        int status;
+        // Blocks entirely inside the range are decoded in place
+        if (data_index >= offset && data_index + data_length <= offset + length){
+            status = arc_decode_block(&layout, blocks_processed, encoded_data, decoded_data + (data_index - offset), matrices);
+        // Blocks straddling either end of the range are decoded aside and trimmed
+        } else {
+            uint8_t* block_data = talloc(uint8_t, data_length);
+            status = arc_decode_block(&layout, blocks_processed, encoded_data, block_data, matrices);
+            uint32_t start = (data_index < offset) ? offset : data_index;
+            uint32_t end = (data_index + data_length > offset + length) ? offset + length : data_index + data_length;
+            memcpy(decoded_data + (start - offset), block_data + (start - data_index), end - start);
+            free(block_data);
+        }
+        if (status == ARC_BLOCK_UNCORRECTABLE){
+            #pragma omp atomic write
+            decode_success = 0;
+        }
+    }
+    arc_rs_matrix_cache_free(matrices);
+
+    if (decode_success == 0){
+        printf("DATA INTEGRITY ERROR: Uncorrectable Block Found In Requested Range...\n");
+    }
+    return decode_success;
+}
+
+// arc_decode_salvage:
+// Decodes every block it can and reports which blocks could not be recovered instead of discarding the
+// whole data stream, so recovery work is proportional to the damage rather than the data size
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// decoded_data         -   address of pointer to arc decoded uint8_t data stream (uncorrectable blocks hold the data as stored)
+// decoded_data_size    -   address of pointer to arc decoded data stream size
+// error_bitmap         -   address of pointer to a bitmap of (block_count + 7) / 8 bytes where bit (b % 8) of byte (b / 8)
+//                          is set if block b is uncorrectable
+// block_count          -   address to store total number of blocks in the data stream
+// error_blocks         -   address to store number of uncorrectable blocks found
+// stop_early           -   1 to stop decoding as soon as an uncorrectable block is found (the contents of blocks
+//                          that were skipped are undefined), 0 to decode every block
+// return:
+// err                  -   error code to determine if every block was recovered (1=sucessful,0=uncorrectable blocks found or invalid)
+// note:
+// decoded_data and error_bitmap are allocated (and must be freed by the caller) whenever the metadata is valid,
+// even if uncorrectable blocks were found. Use arc_block_range to find the bytes held by each flagged block.
+int arc_decode_salvage(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t** decoded_data, uint32_t* decoded_data_size, uint8_t** error_bitmap, uint32_t* block_count, uint32_t* error_blocks, int stop_early){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    *decoded_data = NULL;
+    *error_bitmap = NULL;
+    *decoded_data_size = 0;
+    *block_count = 0;
+    *error_blocks = 0;
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    *decoded_data_size = layout.data_size;
+    *decoded_data = (uint8_t*)malloc(sizeof(uint8_t) * layout.data_size);
+    *block_count = layout.total_blocks;
+    *error_bitmap = (uint8_t*)calloc((layout.total_blocks + 7) / 8, sizeof(uint8_t));
+    int* matrices[257] = {NULL};
+    if (layout.ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(&layout, matrices);
+    }
+
+    // Setup Loop Variables
+    uint32_t units_processed;
+    uint32_t uncorrectable = 0;
+    int stop = 0;
+    uint32_t threads = (layout.threads < 1) ? 1 : layout.threads;
+    // Packed layouts are decoded a group of 8 blocks (one bitmap byte) at a time
+    uint32_t total_units = layout.packed ? (layout.total_blocks + 7) / 8 : layout.total_blocks;
+    int chunk_size = arc_schedule_chunk(total_units, threads);
+    omp_set_num_threads(threads);
+
+    // Check, correct, and write out each block, flagging the ones that cannot be recovered
+    #pragma omp parallel for schedule(dynamic, chunk_size) reduction(+:uncorrectable)
+    for (units_processed = 0; units_processed < total_units; units_processed++){
+        int stopped;
+        #pragma omp atomic read
+        stopped = stop;
+        if (stopped){
+            continue;
+        }
+        uint32_t found = 0;
+        if (layout.packed){
+            if (arc_decode_group(&layout, units_processed, encoded_data, *decoded_data, *error_bitmap) == ARC_BLOCK_UNCORRECTABLE){
+                found = __builtin_popcount((*error_bitmap)[units_processed]);
+            }
+        } else {
+            uint32_t data_index, data_length, encoded_index;
+            arc_layout_block(&layout, units_processed, &data_index, &data_length, &encoded_index);
+            if (arc_decode_block(&layout, units_processed, encoded_data, *decoded_data + data_index, matrices) == ARC_BLOCK_UNCORRECTABLE){
+                // Neighbouring blocks share a bitmap byte
+                uint8_t* bitmap_byte = *error_bitmap + (units_processed / 8);
+                uint8_t bitmap_bit = (uint8_t)(1 << (units_processed % 8));
+                #pragma omp atomic update
+                *bitmap_byte |= bitmap_bit;
+                found = 1;
+            }
+        }
+        uncorrectable += found;
+        if (stop_early && found > 0){
+            #pragma omp atomic write
+            stop = 1;
+        }
+    }
+    arc_rs_matrix_cache_free(matrices);
+
+    *error_blocks = uncorrectable;
+    if (uncorrectable > 0 && PRINT){
+        printf("DATA INTEGRITY WARNING: %" PRIu32 " Uncorrectable Block(s) Found, Remaining Data Salvaged...\n", uncorrectable);
+    }
+    return (uncorrectable == 0);
+}
+
+// arc_block_range:
+// Determines which bytes of the original data stream a block of an encoded data stream holds
+// params:
+// encoded_data         -   uint8_t arc encoded data stream
+// encoded_data_size    -   size of arc encoded data stream
+// block                -   index of the block (as used by the error bitmap of arc_decode_salvage)
+// offset               -   address to store offset of the block's first byte within the original data stream
+// length               -   address to store number of bytes held by the block
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_block_range(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t block, uint32_t* offset, uint32_t* length){
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    if (block >= layout.total_blocks){
+        printf("INVALID BLOCK: Requested block is past the end of the data stream. . .\n");
+        return 0;
+    }
+    uint32_t encoded_index;
+    arc_layout_block(&layout, block, offset, length, &encoded_index);
+    return 1;
+}
+
+// arc_check:
+// Verifies every block of the encoded data stream in place without decoding or copying any data
+// params:
+// encoded_data         -   uint8_t protected data stream
+// encoded_data_size    -   size of protected data stream
+// clean_blocks         -   address to store number of blocks that passed their check (may be NULL)
+// correctable_blocks   -   address to store number of blocks with errors that can be corrected (may be NULL)
+// uncorrectable_blocks -   address to store number of blocks with errors that cannot be corrected (may be NULL)
+// return:
+// err                  -   error code to determine if the data stream can be decoded (1=decodable,0=uncorrectable or invalid)
+int arc_check(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t* clean_blocks, uint32_t* correctable_blocks, uint32_t* uncorrectable_blocks){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    if (clean_blocks != NULL){
+        *clean_blocks = 0;
+    }
+    if (correctable_blocks != NULL){
+        *correctable_blocks = 0;
+    }
+    if (uncorrectable_blocks != NULL){
+        *uncorrectable_blocks = 0;
+    }
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    if(PRINT)
+        printf("ARC Check Started\n");
+
+    // Setup Loop Variables
+    uint32_t blocks_processed;
+    uint32_t clean = 0;
+    uint32_t correctable = 0;
+    uint32_t uncorrectable = 0;
+    uint32_t threads = (layout.threads < 1) ? 1 : layout.threads;
+    omp_set_num_threads(threads);
+
+    // Packed layouts are checked a group of 8 blocks at a time, only dirty groups are checked block by block
+    if (layout.packed){
+        uint32_t groups_processed;
+        uint32_t total_groups = (layout.total_blocks + 7) / 8;
+        #pragma omp parallel for schedule(static) reduction(+:clean,correctable,uncorrectable)
+        for (groups_processed = 0; groups_processed < total_groups; groups_processed++){
+            uint32_t group_blocks = arc_packed_group_blocks(&layout, groups_processed);
+            if (arc_packed_compute_group(&layout, groups_processed, encoded_data + layout.metadata_length) == arc_packed_load_group(&layout, groups_processed, encoded_data)){
+                clean += group_blocks;
+                continue;
+            }
+            uint32_t block;
+            for (block = groups_processed * 8; block < (groups_processed * 8) + group_blocks; block++){
+                int status = arc_check_block(&layout, block, encoded_data);
+                if (status == ARC_BLOCK_CLEAN){
+                    clean++;
+                } else if (status == ARC_BLOCK_CORRECTABLE){
+                    correctable++;
+                } else {
+                    uncorrectable++;
+                }
+            }
+        }
+    // Check each block, the scan is read only so blocks are split evenly between threads
+    } else {
+        #pragma omp parallel for schedule(static) reduction(+:clean,correctable,uncorrectable)
+        for (blocks_processed = 0; blocks_processed < layout.total_blocks; blocks_processed++){
+            int status = arc_check_block(&layout, blocks_processed, encoded_data);
+            if (status == ARC_BLOCK_CLEAN){
+                clean++;
+            } else if (status == ARC_BLOCK_CORRECTABLE){
+                correctable++;
+            } else {
+                uncorrectable++;
+            }
+        }
+    }
+
+    if (clean_blocks != NULL){
+        *clean_blocks = clean;
+    }
+    if (correctable_blocks != NULL){
+        *correctable_blocks = correctable;
+    }
+    if (uncorrectable_blocks != NULL){
+        *uncorrectable_blocks = uncorrectable;
+    }
+    if(PRINT)
+        printf("ARC Check Completed: %" PRIu32 " Clean, %" PRIu32 " Correctable, %" PRIu32 " Uncorrectable\n", clean, correctable, uncorrectable);
+    return (uncorrectable == 0);
+}
+
+
+
+// arc_repair:
+// Finds every correctable block of the encoded data stream and writes the corrected data and check bits back into
+// the encoded data stream in place, so later reads take the clean path again
+// params:
+// encoded_data         -   uint8_t protected data stream (modified in place)
+// encoded_data_size    -   size of protected data stream
+// repaired_blocks      -   address to store number of blocks that were corrected (may be NULL)
+// uncorrectable_blocks -   address to store number of blocks with errors that cannot be corrected (may be NULL)
+// return:
+// err                  -   error code to determine if the data stream is now clean (1=clean,0=uncorrectable blocks remain or invalid)
+int arc_repair(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t* repaired_blocks, uint32_t* uncorrectable_blocks){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    if (repaired_blocks != NULL){
+        *repaired_blocks = 0;
+    }
+    if (uncorrectable_blocks != NULL){
+        *uncorrectable_blocks = 0;
+    }
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    if(PRINT)
+        printf("ARC Repair Started\n");
+    int* matrices[257] = {NULL};
+    if (layout.ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(&layout, matrices);
+    }
+
+    // Setup Loop Variables
+    uint32_t units_processed;
+    uint32_t repaired = 0;
+    uint32_t uncorrectable = 0;
+    uint32_t threads = (layout.threads < 1) ? 1 : layout.threads;
+    // Packed layouts are repaired a group of 8 blocks (whole trailer bytes) at a time
+    uint32_t total_units = layout.packed ? (layout.total_blocks + 7) / 8 : layout.total_blocks;
+    int chunk_size = arc_schedule_chunk(total_units, threads);
+    omp_set_num_threads(threads);
+
+    // Check each block and rewrite the ones that can be corrected
+    #pragma omp parallel for schedule(dynamic, chunk_size) reduction(+:repaired,uncorrectable)
+    for (units_processed = 0; units_processed < total_units; units_processed++){
+        uint32_t first_block = units_processed;
+        uint32_t last_block = units_processed + 1;
+        if (layout.packed){
+            // Clean groups are verified with a single comparison
+            if (arc_packed_compute_group(&layout, units_processed, encoded_data + layout.metadata_length) == arc_packed_load_group(&layout, units_processed, encoded_data)){
+                continue;
+            }
+            first_block = units_processed * 8;
+            last_block = first_block + arc_packed_group_blocks(&layout, units_processed);
+        }
+        uint32_t block;
+        for (block = first_block; block < last_block; block++){
+            int status = arc_repair_block(&layout, block, encoded_data, matrices);
+            if (status == ARC_BLOCK_CORRECTABLE){
+                repaired++;
+            } else if (status == ARC_BLOCK_UNCORRECTABLE){
+                uncorrectable++;
+            }
+        }
+    }
+    arc_rs_matrix_cache_free(matrices);
 
-    // Return data
+    if (repaired_blocks != NULL){
+        *repaired_blocks = repaired;
+    }
+    if (uncorrectable_blocks != NULL){
+        *uncorrectable_blocks = uncorrectable;
+    }
     if(PRINT)
-        printf("ARC Decoding Completed\n");
-    return err;
+        printf("ARC Repair Completed: %" PRIu32 " Repaired, %" PRIu32 " Uncorrectable\n", repaired, uncorrectable);
+    return (uncorrectable == 0);
 }
 
-// arc_check:
-// Check the parity bits of the encoded data stream to ensure integrity
+// arc_update_range:
+// Replaces a byte range of the original data stream inside an encoded data stream, recomputing only the check bits
+// of the blocks covering the range so small updates cost O(change) instead of a full re-encode
 // params:
-// encoded_data         -   uint8_t protected data stream
-// encoded_data_size    -   size of protected data stream
+// encoded_data         -   uint8_t arc encoded data stream (modified in place)
+// encoded_data_size    -   size of arc encoded data stream
+// offset               -   offset of the first byte to replace within the original data stream
+// new_data             -   uint8_t replacement bytes
+// length               -   number of bytes to replace
 // return:
 // err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
-int arc_check(uint8_t* encoded_data, uint32_t encoded_data_size){
+// note:
+// Blocks with correctable errors are corrected while being updated. If any covering block is uncorrectable it is
+// left untouched and 0 is returned, the remaining blocks are still updated. A payload checksum is patched for the
+// updated blocks only, so it stays valid once the uncorrectable block is repaired.
+int arc_update_range(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t offset, const uint8_t* new_data, uint32_t length){
     if (!INIT){
         printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_read(encoded_data, encoded_data_size, &layout) == 0){
+        return 0;
+    }
+    if (offset > layout.data_size || length > layout.data_size - offset){
+        printf("INVALID RANGE: Requested range extends past the end of the data stream. . .\n");
+        return 0;
+    }
+    if (length == 0){
         return 1;
-    };
-    printf("ARC Check not supported at this time...\n");
-    return 1;
-}
+    }
+    // Determine which blocks cover the updated range
+    uint32_t first_block = arc_layout_find_block(&layout, offset);
+    uint32_t last_block = arc_layout_find_block(&layout, offset + length - 1);
+    int* matrices[257] = {NULL};
+    if (layout.ecc_algorithm == RS_ID){
+        arc_rs_matrix_cache_create(&layout, matrices);
+    }
 
+    // Patch the payload checksum by the CRC of the changed bits instead of re-reading the whole payload. Uncorrectable
+    // blocks are left untouched by the update, so they contribute no change
+    if (layout.payload_checksum_present){
+        uint8_t* delta = (uint8_t*)calloc(length, sizeof(uint8_t));
+        uint32_t block;
+        for (block = first_block; block <= last_block; block++){
+            uint32_t data_index, data_length, encoded_index;
+            arc_layout_block(&layout, block, &data_index, &data_length, &encoded_index);
+            uint8_t* block_data = talloc(uint8_t, data_length);
+            if (arc_decode_block(&layout, block, encoded_data, block_data, matrices) != ARC_BLOCK_UNCORRECTABLE){
+                uint32_t start = (data_index < offset) ? offset : data_index;
+                uint32_t end = (data_index + data_length > offset + length) ? offset + length : data_index + data_length;
+                uint32_t i;
+                for (i = start; i < end; i++){
+                    delta[i - offset] = block_data[i - data_index] ^ new_data[i - offset];
+                }
+            }
+            free(block_data);
+        }
+        uint32_t delta_checksum = arc_crc32c_update(0, delta, length);
+        layout.payload_checksum ^= arc_crc32c_shift(delta_checksum, (uint64_t)layout.data_size - offset - length);
+        arc_layout_write_header(&layout, encoded_data);
+        free(delta);
+    }
+
+    // Setup Loop Variables
+    uint32_t blocks_processed;
+    uint32_t span = last_block - first_block + 1;
+    uint32_t threads = (layout.threads < 1) ? 1 : layout.threads;
+    int chunk_size = arc_schedule_chunk(span, threads);
+    int update_success = 1;
+    omp_set_num_threads(threads);
+
+    // Update each covering block, packed blocks share trailer bytes with their neighbours so they are updated in order
+    #pragma omp parallel for schedule(dynamic, chunk_size) if(!layout.packed && span > (uint32_t)chunk_size)
+    for (blocks_processed = first_block; blocks_processed <= last_block; blocks_processed++){
+        if (arc_update_block(&layout, blocks_processed, encoded_data, offset, new_data, length, matrices) == ARC_BLOCK_UNCORRECTABLE){
+            #pragma omp atomic write
+            update_success = 0;
+        }
+    }
+    arc_rs_matrix_cache_free(matrices);
 
+    if (update_success == 0){
+        printf("DATA INTEGRITY ERROR: Uncorrectable Block Found In Updated Range...\n");
+    }
+    return update_success;
+}
 
 // ARC Engine Section
 // ###################
@@ -922,6 +5695,8 @@ int arc_check(uint8_t* encoded_data, uint32_t encoded_data_size){
 // memory_choice_parameter_b    -   second resulting ecc method parameter (if applicable, 0 otherwise)
 // return:
 // identifier                   -   identifier to determine which ecc method to use
+// note:
+// Walks the configuration table, so it must run with the configuration lock held (as arc_optimize does)
 int arc_memory_optimizer(double memory_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* memory_choice_parameter_a, uint32_t* memory_choice_parameter_b){
     if (!INIT){
         printf("Initialization Error: Please initialize ARC before further use\n");
@@ -1038,6 +5813,8 @@ int arc_memory_optimizer(double memory_constraint, int *resiliency_constraint, i
 // num_threads                      -   number of threads required to obtain optimal bandwidth
 // return:
 // identifier                       -   identifier to determine which ecc method to use
+// note:
+// Walks the configuration table, so it must run with the configuration lock held (as arc_optimize does)
 int arc_throughput_optimizer(double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* throughput_choice_parameter_a, uint32_t* throughput_choice_parameter_b, uint32_t* num_threads){
     if (!INIT){
         printf("Initialization Error: Please initialize ARC before further use\n");
@@ -1112,8 +5889,9 @@ int arc_throughput_optimizer(double throughput_constraint, int *resiliency_const
         // Ensure ECC algorithm is viable given resiliency constraint
         if (ecc_options[(arc_configurations[i].ecc_algorithm - 1)] == 1){
             // Look for optimal approach
-            if ((optimal_index == -1 && arc_configurations[i].throughput_overhead >= throughput_constraint) || 
-                (arc_configurations[i].throughput_overhead >= throughput_constraint && arc_configurations[i].throughput_overhead < optimal_overhead)){
+            double lower_throughput = arc_configuration_lower_throughput(&arc_configurations[i]);
+            if ((optimal_index == -1 && lower_throughput >= throughput_constraint) || 
+                (lower_throughput >= throughput_constraint && arc_configurations[i].throughput_overhead < optimal_overhead)){
                 optimal_index = i;
                 optimal_overhead = arc_configurations[i].throughput_overhead;
             }
@@ -1158,6 +5936,8 @@ int arc_throughput_optimizer(double throughput_constraint, int *resiliency_const
 // num_threads                      -   number of threads required to obtain optimal bandwidth
 // return:
 // identifier                       -   identifier to determine which ecc method to use
+// note:
+// Walks the configuration table, so it must run with the configuration lock held (as arc_optimize does)
 int arc_joint_optimizer(double memory_constraint, double throughput_constraint, int *resiliency_constraint, int resiliency_count, uint32_t* optimizer_parameter_a, uint32_t* optimizer_parameter_b, uint32_t* num_threads){
     if (!INIT){
         printf("Initialization Error: Please initialize ARC before further use\n");
@@ -1236,8 +6016,8 @@ int arc_joint_optimizer(double memory_constraint, double throughput_constraint,
 
         // Ensure ECC algorithm is viable given resiliency constraint
         if (ecc_options[(arc_configurations[i].ecc_algorithm - 1)] == 1){
-            // Check to see if it satisfies throughput constraint
-            if (arc_configurations[i].throughput_overhead >= throughput_constraint){
+            // Check to see if it satisfies throughput constraint (with confidence to spare)
+            if (arc_configuration_lower_throughput(&arc_configurations[i]) >= throughput_constraint){
                 possible_throughput_configurations[possible_throughput_config_index] = i;
                 possible_throughput_config_index++;
             }
@@ -1440,153 +6220,55 @@ int arc_parity_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, ui
     if (PRINT){
         printf("Starting Parity Encoding\n");
     }
-    // Determine number of blocks given data_size and block_size
-    uint32_t block_count = (uint32_t)ceil((float)data_size / (float)block_size);
-    uint32_t remainder_size = data_size % block_size;
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_create(PARITY_ID, data_size, block_size, 0, threads, &layout) == 0){
+        return 0;
+    }
 
     // Calculate and create resulting array
-    uint32_t metadata_length = 17;
-    *encoded_data_size = data_size + block_count + metadata_length;
+    *encoded_data_size = layout.encoded_size;
+    ARC_TRACE_BEGIN(allocate);
     *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
 
     // Write specific metadata back to array
-    // Store Approach Identifier
-    (*encoded_data)[0] = 0x01;
-    // Store Block Count in 4 Bytes
-    (*encoded_data)[1] = (uint8_t)((block_count & 0xFF000000) >> 24);  
-    (*encoded_data)[2] = (uint8_t)((block_count & 0x00FF0000) >> 16);
-    (*encoded_data)[3] = (uint8_t)((block_count & 0x0000FF00) >> 8);
-    (*encoded_data)[4] = (uint8_t)((block_count & 0x000000FF));
-    // Store Block Size in 4 Bytes
-    (*encoded_data)[5] = (uint8_t)((block_size & 0xFF000000) >> 24);  
-    (*encoded_data)[6] = (uint8_t)((block_size & 0x00FF0000) >> 16);
-    (*encoded_data)[7] = (uint8_t)((block_size & 0x0000FF00) >> 8);
-    (*encoded_data)[8] = (uint8_t)((block_size & 0x000000FF));
-    // Store Remainder Block Size in 4 Bytes 
-    (*encoded_data)[9] = (uint8_t)((remainder_size & 0xFF000000) >> 24); 
-    (*encoded_data)[10] = (uint8_t)((remainder_size & 0x00FF0000) >> 16);
-    (*encoded_data)[11] = (uint8_t)((remainder_size & 0x0000FF00) >> 8);
-    (*encoded_data)[12] = (uint8_t)((remainder_size & 0x000000FF));
-    // Store Number of Threads used
-    (*encoded_data)[13] = (uint8_t)((threads & 0xFF000000) >> 24); 
-    (*encoded_data)[14] = (uint8_t)((threads & 0x00FF0000) >> 16);
-    (*encoded_data)[15] = (uint8_t)((threads & 0x0000FF00) >> 8);
-    (*encoded_data)[16] = (uint8_t)((threads & 0x000000FF));
-    // Set current index for encoded_data after metadata
-    uint32_t encoded_data_index = metadata_length;
-    
-    // Setup Loop Variables 
-    uint32_t blocks_processed;
-    // Determine number of threads per block
-    int n_per_thread;
-    if (block_count < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = block_count / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
+    arc_layout_write_metadata(&layout, data, *encoded_data);
 
     // Calculate parity for each block of data
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < block_count; blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_block_size;
-
-        // Determine loop offsets
-        // Remainder Block
-        if (blocks_processed == block_count-1 && remainder_size != 0){
-            current_block_size = remainder_size;
-        // Full Block
-        } else {
-            current_block_size = block_size;
-        }
-        // Loop Specific Index Locations
-        uint32_t current_data_index = block_size*blocks_processed;
-        uint32_t current_encoded_data_index = encoded_data_index + (block_size+1)*blocks_processed;
-
-        // Setup Current Block Variables
-        uint32_t block_data_start = current_data_index;
-        uint8_t block_parity = 0;
-        uint32_t bytes_processed = 0;
-        int first_iter = 0;
-
-        // Setup temporary variables
-        uint64_t bytes_8;
-        uint8_t bytes_1;
-        uint8_t bytes_parity;
-
-        // Iterate over all bytes and calculate overall block parity
-        while(bytes_processed != current_block_size){
-            // Work on 8 bytes at a time
-            if (current_block_size - bytes_processed >= 8){
-                // Load bytes
-                bytes_8 = ((uint64_t)data[current_data_index] << 56) | ((uint64_t)data[current_data_index+1] << 48) | \
-                ((uint64_t)data[current_data_index+2] << 40) | ((uint64_t)data[current_data_index+3] << 32) | \
-                ((uint64_t)data[current_data_index+4] << 24) | ((uint64_t)data[current_data_index+5] << 16) | \
-                ((uint64_t)data[current_data_index+6] << 8) | ((uint64_t)data[current_data_index+7]);
-                current_data_index = current_data_index+8;
-
-                // Calculate parity for 8 bytes
-                bytes_parity = arc_calculate_parity_uint64(bytes_8);
-
-                // Combine block parity and bytes parity
-                if (first_iter){
-                    block_parity = bytes_parity;
-                    first_iter = 1;
-                } else {
-                    if (block_parity == 0 && bytes_parity == 0){
-                        block_parity = 0;
-                    } else if (block_parity == 1 && bytes_parity == 1) {
-                        block_parity = 0;
-                    } else {
-                        block_parity = 1;
-                    }
-                }
-                // Increment bytes processed by 8
-                bytes_processed = bytes_processed + 8;
+    arc_encode_blocks(&layout, data, *encoded_data, threads);
 
-            // Work on a single byte at a time
-            } else {
-                // Load byte
-                bytes_1 = data[current_data_index];
-                current_data_index++;
-
-                // Calculate parity for byte
-                bytes_parity = arc_calculate_parity_uint8(bytes_1);
-
-                // Combine block parity and byte parity
-                if (first_iter){
-                    block_parity = bytes_parity;
-                    first_iter = 1;
-                } else {
-                    if (block_parity == 0 && bytes_parity == 0){
-                        block_parity = 0;
-                    } else if (block_parity == 1 && bytes_parity == 1) {
-                        block_parity = 0;
-                    } else {
-                        block_parity = 1;
-                    }
-                }
-                // Increment bytes processed by 1
-                bytes_processed = bytes_processed + 1;
-            }
-        }
+    // Return resulting array
+    if (PRINT){
+        printf("Parity Encoding Finished\n");
+    }
+    return 1;
+}
 
-        // Upon block completion, write parity and data to resulting array
-        (*encoded_data)[current_encoded_data_index] = block_parity;
-        current_encoded_data_index++;
-        int i;
-        for (i = block_data_start; i < current_data_index; i++){
-            (*encoded_data)[current_encoded_data_index] = data[i];
-            current_encoded_data_index++;
-        }
+// arc_parity_encodev:
+// Encodes a data stream held in a list of fragments using single-bit parity, without gathering it into one buffer first
+// params:
+// data_parts           -   array of fragments forming the data stream in order
+// part_count           -   number of fragments
+// block_size           -   number of bytes in each protected block
+// threads              -   number of OpenMP threads to split work across
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_parity_encodev(const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
     }
     if (PRINT){
-        printf("Parity Encoding Finished!\n");
+        printf("Starting Parity Encoding\n");
     }
-    // Return resulting array
-    return 1;
+    int err = arc_configuration_encodev(PARITY_ID, block_size, 0, threads, data_parts, part_count, encoded_data, encoded_data_size);
+    if (PRINT){
+        printf("Parity Encoding Finished\n");
+    }
+    return err;
 }
 
 // arc_parity_decode:
@@ -1606,148 +6288,9 @@ int arc_parity_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t
     if (PRINT){
         printf("Starting Parity Decoding\n");
     }
-    // Pull metadata from encoded_data array
-    uint32_t metadata_length = 17;
-    uint32_t block_count = (((uint32_t)encoded_data[1] & 0x000000FF) << 24) | (((uint32_t)encoded_data[2] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[3] & 0x000000FF) << 8) | (((uint32_t)encoded_data[4] & 0x000000FF));
-    uint32_t block_size = (((uint32_t)encoded_data[5] & 0x000000FF) << 24) | (((uint32_t)encoded_data[6] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[7] & 0x000000FF) << 8) | (((uint32_t)encoded_data[8] & 0x000000FF));
-    uint32_t remainder_size = (((uint32_t)encoded_data[9] & 0x000000FF) << 24) | (((uint32_t)encoded_data[10] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[11] & 0x000000FF) << 8) | (((uint32_t)encoded_data[12] & 0x000000FF));
-    uint32_t threads = (((uint32_t)encoded_data[13] & 0x000000FF) << 24) | (((uint32_t)encoded_data[14] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[15] & 0x000000FF) << 8) | (((uint32_t)encoded_data[16] & 0x000000FF));
-    uint32_t encoded_data_index = metadata_length;
-
-    // Determine size of original array and allocate space
-    *data_size = encoded_data_size - block_count - metadata_length;
-    *data = (uint8_t*)malloc(sizeof(uint8_t) * *data_size);
-
-    // Setup Loop Variables 
-    uint32_t blocks_processed;
-    int decode_success = 1;
-    // Determine number of threads per block
-    int n_per_thread;
-    if (block_count < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = block_count / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
-
-    // Recalculate Parity for each block and compare to original parity
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < block_count; blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_block_size; 
-
-        // Determine loop offsets
-        // Remainder Block
-        if (blocks_processed == block_count-1 && remainder_size != 0){
-            current_block_size = remainder_size;
-        // Full Block
-        } else {
-            current_block_size = block_size;
-        }
-        // Loop Specific Index Locations
-        uint32_t current_encoded_data_index = encoded_data_index + (block_size+1)*blocks_processed;
-        uint32_t current_data_index = block_size*blocks_processed;
-
-        // Pull original parity and save for later
-        uint8_t original_block_parity = encoded_data[current_encoded_data_index];
-        current_encoded_data_index++;
-
-        // Setup Current Block Variables
-        uint32_t block_data_start = current_encoded_data_index;
-        uint8_t block_parity = 0;
-        uint32_t bytes_processed = 0;
-        int first_iter = 0;
-
-        // Setup temporary variables
-        uint64_t bytes_8;
-        uint8_t bytes_1;
-        uint8_t bytes_parity;
-
-        // Iterate over all bytes and calculate overall block parity
-        while(bytes_processed != current_block_size){
-            // Work on 8 bytes at a time
-            if (current_block_size - bytes_processed >= 8){
-                // Load bytes
-                bytes_8 = ((uint64_t)encoded_data[current_encoded_data_index] << 56) | ((uint64_t)encoded_data[current_encoded_data_index+1] << 48) | \
-                ((uint64_t)encoded_data[current_encoded_data_index+2] << 40) | ((uint64_t)encoded_data[current_encoded_data_index+3] << 32) | \
-                ((uint64_t)encoded_data[current_encoded_data_index+4] << 24) | ((uint64_t)encoded_data[current_encoded_data_index+5] << 16) | \
-                ((uint64_t)encoded_data[current_encoded_data_index+6] << 8) | ((uint64_t)encoded_data[current_encoded_data_index+7]);
-                current_encoded_data_index = current_encoded_data_index+8;
-
-                // Calculate parity for 8 bytes
-                bytes_parity = arc_calculate_parity_uint64(bytes_8);
-
-                // Combine block parity and byte parity
-                if (first_iter){
-                    block_parity = bytes_parity;
-                    first_iter = 1;
-                } else {
-                    if (block_parity == 0 && bytes_parity == 0){
-                        block_parity = 0;
-                    } else if (block_parity == 1 && bytes_parity == 1) {
-                        block_parity = 0;
-                    } else {
-                        block_parity = 1;
-                    }
-                }
-                // Increment bytes processed by 8
-                bytes_processed = bytes_processed + 8;
-
-            // Work on a single byte at a time
-            } else {
-                // Load byte
-                bytes_1 = encoded_data[current_encoded_data_index];
-                current_encoded_data_index++;
-
-                // Calculate parity for byte
-                bytes_parity = arc_calculate_parity_uint8(bytes_1);
-
-                // Combine block parity and byte parity
-                if (first_iter){
-                    block_parity = bytes_parity;
-                    first_iter = 1;
-                } else {
-                    if (block_parity == 0 && bytes_parity == 0){
-                        block_parity = 0;
-                    } else if (block_parity == 1 && bytes_parity == 1) {
-                        block_parity = 0;
-                    } else {
-                        block_parity = 1;
-                    }
-                }
-                // Increment bytes processed by 1
-                bytes_processed = bytes_processed + 1;
-            }
-        }
-        
-        // Compare Original Block Parity and New Block Parity
-        if (original_block_parity == block_parity){
-            // If parity is correct, add data to array
-            int i;
-            for (i = block_data_start; i < current_encoded_data_index; i++){
-                (*data)[current_data_index] = encoded_data[i];
-                current_data_index++;
-            }
-        } else {
-            // If parity is incorrect, print error and exit
-            if(PRINT)
-                printf("DATA INTEGRITY ERROR: Single Bit Parity Error Found. . .\n");
-            #pragma omp critical 
-            {
-                decode_success = 0;
-            }
-        }
-    }
-    
-    // Free decoded data and set data_size to 0 if decoding process failed
+    // Interleaved, split, and packed layouts (with or without a versioned header) are all decoded through their layout
+    int decode_success = arc_layout_decode(encoded_data, encoded_data_size, data, data_size);
     if (decode_success == 0){
-        free(*data);
-        *data_size = 0;
         if (PRINT){
             printf("Parity Decoding Failed!\n");
         }
@@ -1756,7 +6299,6 @@ int arc_parity_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t
             printf("Parity Decoding Finished!\n");
         }
     }
-    // Return resulting array and decode success value
     return decode_success;
 }
 
@@ -1854,124 +6396,24 @@ int arc_hamming_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, u
     if (PRINT){
         printf("Starting Hamming Encoding\n");
     }
-    // Check that block_size is valid and supported
-    if (block_size != 1 && block_size != 8){
-        printf("INVALID BLOCK SIZE: Please select a supported block size. . .\n");
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_create(HAMMING_ID, data_size, block_size, 0, threads, &layout) == 0){
         return 0;
     }
-    // Set metadata length
-    uint32_t metadata_length = 17;
 
-    // Determine number of blocks given data_size and block_size
-    uint32_t block_count = (uint32_t)floor((float)data_size / (float)block_size);
-    uint32_t remainder_blocks = data_size % block_size;
-
-    // Given block size, determine number of parity bytes for each block
-    if (block_size == 1 || block_size == 8){
-        *encoded_data_size = data_size + block_count + remainder_blocks + metadata_length;
-    }
-    // Create encoded_data array from resulting 
+    // Calculate and create resulting array
+    *encoded_data_size = layout.encoded_size;
+    ARC_TRACE_BEGIN(allocate);
     *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
 
     // Write specific metadata back to array
-    // Store Approach Identifier
-    (*encoded_data)[0] = 0x02;
-    // Store Block Count in 4 Bytes 
-    (*encoded_data)[1] = (uint8_t)((block_count & 0xFF000000) >> 24);  
-    (*encoded_data)[2] = (uint8_t)((block_count & 0x00FF0000) >> 16);
-    (*encoded_data)[3] = (uint8_t)((block_count & 0x0000FF00) >> 8);
-    (*encoded_data)[4] = (uint8_t)((block_count & 0x000000FF));
-    // Store Block Size in 4 Bytes 
-    (*encoded_data)[5] = (uint8_t)((block_size & 0xFF000000) >> 24);  
-    (*encoded_data)[6] = (uint8_t)((block_size & 0x00FF0000) >> 16);
-    (*encoded_data)[7] = (uint8_t)((block_size & 0x0000FF00) >> 8);
-    (*encoded_data)[8] = (uint8_t)((block_size & 0x000000FF));    
-    // Store Remainder Blocks in 4 Bytes 
-    (*encoded_data)[9] = (uint8_t)((remainder_blocks & 0xFF000000) >> 24);  
-    (*encoded_data)[10] = (uint8_t)((remainder_blocks & 0x00FF0000) >> 16);
-    (*encoded_data)[11] = (uint8_t)((remainder_blocks & 0x0000FF00) >> 8);
-    (*encoded_data)[12] = (uint8_t)((remainder_blocks & 0x000000FF));
-    // Store Number of Threads used
-    (*encoded_data)[13] = (uint8_t)((threads & 0xFF000000) >> 24); 
-    (*encoded_data)[14] = (uint8_t)((threads & 0x00FF0000) >> 16);
-    (*encoded_data)[15] = (uint8_t)((threads & 0x0000FF00) >> 8);
-    (*encoded_data)[16] = (uint8_t)((threads & 0x000000FF));
-    // Set current index for encoded_data after metadata
-    uint32_t encoded_data_index = metadata_length;
-
-    // Setup Loop Variables 
-    uint32_t blocks_processed;
-    // Determine number of threads per block
-    int n_per_thread;
-    if ((block_count+remainder_blocks) < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = (block_count+remainder_blocks) / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
+    arc_layout_write_metadata(&layout, data, *encoded_data);
 
     // Calculate hamming for each block of data
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < (block_count + remainder_blocks); blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_data_index;
-        uint32_t current_encoded_data_index;
-        uint32_t current_block_size;
-
-        // Determine loop offsets
-        // Full Blocks
-        if (blocks_processed < block_count){
-            current_data_index = blocks_processed * block_size;
-            current_encoded_data_index = encoded_data_index + (blocks_processed * (block_size + 1));
-            current_block_size = block_size;
-        // Remainder Blocks
-        } else {
-            current_data_index = block_count * block_size + (blocks_processed - block_count);
-            current_encoded_data_index = (encoded_data_index + (block_count * (block_size + 1))) + ((blocks_processed - block_count) * 2);
-            current_block_size = 1;
-        }
-
-        // Setup temporary variables
-        uint8_t block_1;
-        uint64_t block_8;
-        uint8_t block_parity;
-
-        // Gather data based on current_block_size
-        if (current_block_size == 8){
-            // Load data
-            block_8 = ((uint64_t)data[current_data_index] << 56) | ((uint64_t)data[current_data_index+1] << 48) | \
-            ((uint64_t)data[current_data_index+2] << 40) | ((uint64_t)data[current_data_index+3] << 32) | \
-            ((uint64_t)data[current_data_index+4] << 24) | ((uint64_t)data[current_data_index+5] << 16) | \
-            ((uint64_t)data[current_data_index+6] << 8) | ((uint64_t)data[current_data_index+7]);
-
-            // Calculate Hamming on 8 Byte block
-            block_parity = arc_calculate_hamming_uint64(block_8);
-
-            // Upon completion, wriet parity bits and 8 bytes of data to resulting array
-            (*encoded_data)[current_encoded_data_index] = block_parity;
-            current_encoded_data_index++;
-            int i;
-            for (i = current_data_index; i < current_data_index+block_size; i++){
-                (*encoded_data)[current_encoded_data_index] = data[i];
-                current_encoded_data_index++;
-            }
+    arc_encode_blocks(&layout, data, *encoded_data, threads);
 
-        } else if (current_block_size == 1){
-            // Load data
-            block_1 = data[current_data_index];
-
-            // Calculate Hamming on 1 Byte block
-            block_parity = arc_calculate_hamming_uint8(block_1);
-
-            // Upon completion, write parity bits and 1 byte of data to resulting array
-            (*encoded_data)[current_encoded_data_index] = block_parity;
-            current_encoded_data_index++;
-            (*encoded_data)[current_encoded_data_index] = data[current_data_index];
-            current_encoded_data_index++;
-        }
-    }
-    
     // Return resulting array
     if (PRINT){
         printf("Hamming Encoding Finished\n");
@@ -1979,6 +6421,32 @@ int arc_hamming_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, u
     return 1;
 }
 
+// arc_hamming_encodev:
+// Encodes a data stream held in a list of fragments using Hamming, without gathering it into one buffer first
+// params:
+// data_parts           -   array of fragments forming the data stream in order
+// part_count           -   number of fragments
+// block_size           -   number of bytes in each protected block (1 or 8)
+// threads              -   number of OpenMP threads to split work across
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_hamming_encodev(const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    if (PRINT){
+        printf("Starting Hamming Encoding\n");
+    }
+    int err = arc_configuration_encodev(HAMMING_ID, block_size, 0, threads, data_parts, part_count, encoded_data, encoded_data_size);
+    if (PRINT){
+        printf("Hamming Encoding Finished\n");
+    }
+    return err;
+}
+
 // arc_hamming_decode:
 // Decodes data encoded using hamming encoding
 // params:
@@ -1996,212 +6464,15 @@ int arc_hamming_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_
     if (PRINT){
         printf("Starting Hamming Decoding\n");
     }
-    // Set metadata length
-    uint32_t metadata_length = 17;
-
-    // Pull metadata from encoded_data array
-    uint32_t block_count = (((uint32_t)encoded_data[1] & 0x000000FF) << 24) | (((uint32_t)encoded_data[2] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[3] & 0x000000FF) << 8) | (((uint32_t)encoded_data[4] & 0x000000FF));
-    uint32_t block_size = (((uint32_t)encoded_data[5] & 0x000000FF) << 24) | (((uint32_t)encoded_data[6] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[7] & 0x000000FF) << 8) | (((uint32_t)encoded_data[8] & 0x000000FF));
-    uint32_t remainder_blocks = (((uint32_t)encoded_data[9] & 0x000000FF) << 24) | (((uint32_t)encoded_data[10] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[11] & 0x000000FF) << 8) | (((uint32_t)encoded_data[12] & 0x000000FF));
-    uint32_t threads = (((uint32_t)encoded_data[13] & 0x000000FF) << 24) | (((uint32_t)encoded_data[14] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[15] & 0x000000FF) << 8) | (((uint32_t)encoded_data[16] & 0x000000FF));
-    uint32_t encoded_data_index = metadata_length;
-
-    // Check that block_size is valid and supported
-    if (block_size != 1 && block_size != 8){
-        printf("INVALID BLOCK SIZE: Please select a supported block size. . .\n");
-        return 0;
-    } 
-
-    // Determine size of original array and allocate it
-    if (block_size == 1 || block_size == 8){
-        *data_size = encoded_data_size - block_count - remainder_blocks - metadata_length;
-    }
-    *data = (uint8_t*)malloc(sizeof(uint8_t) * *data_size);
-
-    // Setup Loop Variables 
-    uint32_t blocks_processed;
-    int decode_success = 1;
-    // Determine number of threads per block
-    int n_per_thread;
-    if ((block_count+remainder_blocks) < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = (block_count+remainder_blocks) / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
-
-    // Recalculate hamming for each block of data
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < (block_count + remainder_blocks); blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_encoded_data_index;
-        uint32_t current_data_index;
-        uint32_t current_block_size;
-
-        // Determine loop offsets
-        // Full Blocks
-        if (blocks_processed < block_count){
-            current_encoded_data_index = encoded_data_index + (blocks_processed * (block_size + 1));
-            current_data_index = blocks_processed * block_size;
-            current_block_size = block_size;
-        // Remainder Blocks
-        } else {
-            current_encoded_data_index = (encoded_data_index + (block_count * (block_size + 1))) + ((blocks_processed - block_count) * 2);
-            current_data_index = block_count * block_size + (blocks_processed - block_count);
-            current_block_size = 1;
-        }
-
-        // Pull original parity bits and save for later
-        uint8_t original_block_parity;
-        if (current_block_size == 1 || current_block_size == 8){
-            original_block_parity = encoded_data[current_encoded_data_index];
-            current_encoded_data_index++;
-        }
-
-        // Set current block variables
-        uint32_t block_data_start = current_encoded_data_index;
-
-        // Setup temporary variables
-        uint8_t block_1;
-        uint64_t block_8;
-        uint8_t block_parity;
-        uint8_t xor_parity;
-
-        // Gather data for current block 
-        if (current_block_size == 8){
-            // Load data 
-            block_8 =  ((uint64_t)encoded_data[current_encoded_data_index] << 56) | ((uint64_t)encoded_data[current_encoded_data_index+1] << 48) | \
-            ((uint64_t)encoded_data[current_encoded_data_index+2] << 40) | ((uint64_t)encoded_data[current_encoded_data_index+3] << 32) | \
-            ((uint64_t)encoded_data[current_encoded_data_index+4] << 24) | ((uint64_t)encoded_data[current_encoded_data_index+5] << 16) | \
-            ((uint64_t)encoded_data[current_encoded_data_index+6] << 8) | ((uint64_t)encoded_data[current_encoded_data_index+7]);
-            current_encoded_data_index = current_encoded_data_index+8;
-
-            // Calculate Hamming on 8 Byte block
-            block_parity = arc_calculate_hamming_uint64(block_8);
-
-            // Upon completion, compare both parity bits to ensure data integrity
-            xor_parity = original_block_parity ^ block_parity;
-
-            if (xor_parity == 0){
-               // If parity is correct, add data to array
-               int i;
-               for (i = block_data_start; i < current_encoded_data_index; i++){
-                   (*data)[current_data_index] = encoded_data[i];
-                   current_data_index++;
-               }
-            } else {
-                if(PRINT)
-                    printf("Incorrect Parity Found...\nAttempting to Fix Now...\n");
-                // Using xor_parity value attempt to fix data and parity
-                int j;
-                for (j = 0; j < 72; j++){
-                    if (xor_parity == H_8_Syndrome_Table[j]){
-                        if (j < 64){
-                            block_8 = block_8 ^ ((uint64_t)1 << j);
-                            block_parity = arc_calculate_hamming_uint64(block_8);
-                        } else {
-                            block_parity = block_parity ^ (1 << (j-64));
-                        }
-                        break;
-                    }
-                }
-
-                // Recalculate Hamming on "fixed" data and parity
-                xor_parity = original_block_parity ^ block_parity;
-                if (xor_parity == 0){
-                    if(PRINT)
-                        printf("Data Corrected!\n");
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0xFF00000000000000) >> 56);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x00FF000000000000) >> 48);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x0000FF0000000000) >> 40);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x000000FF00000000) >> 32);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x00000000FF000000) >> 24);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x0000000000FF0000) >> 16);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x000000000000FF00) >> 8);
-                    current_data_index++;
-                    (*data)[current_data_index] = (uint8_t)((block_8 & 0x00000000000000FF));
-                    current_data_index++;
-                } else {
-                    printf("DATA INTEGRITY ERROR: Parity Error Found, Correction Failed...\n");
-                    #pragma omp critical 
-                    {
-                        decode_success = 0;
-                    }
-                }
-            }
-        } else if (current_block_size == 1){
-            // Load data 
-            block_1 = encoded_data[current_encoded_data_index];
-            current_encoded_data_index++;
-
-            // Calculate Hamming on 1 Byte block
-            block_parity = arc_calculate_hamming_uint8(block_1);
-
-            // Upon completion, compare both parity bits to ensure data integrity
-            xor_parity = original_block_parity ^ block_parity;
-
-            if (xor_parity == 0){
-               // If parity is correct, add data to array
-               (*data)[current_data_index] = encoded_data[block_data_start];
-               current_data_index++;
-            } else {
-                if(PRINT)
-                    printf("Incorrect Parity Found...\nAttempting to Fix Now...\n");
-                // Using xor_parity value attempt to fix data and parity
-                int j;
-                for (j = 0; j < 16; j++){
-                    if (xor_parity == H_1_Syndrome_Table[j]){
-                        if (j < 8){
-                            block_1 = block_1 ^ ( 1 << j);
-                            block_parity = arc_calculate_hamming_uint8(block_1);
-                        } else {
-                            block_parity = block_parity ^ ( 1 << (j-8));
-                        }
-                        break;
-                    }
-                }
-
-                // Recalculate Hamming on "fixed" data and parity
-                xor_parity = original_block_parity ^ block_parity;
-                if (xor_parity == 0){
-                    if(PRINT)
-                        printf("Data Corrected!\n");
-                    (*data)[current_data_index] = block_1;
-                    current_data_index++;
-                } else {
-                    printf("DATA INTEGRITY ERROR: Parity Error Found, Correction Failed...\n");
-                    #pragma omp critical 
-                    {
-                        decode_success = 0;
-                    }
-                }
-            }
-        }
-    }
-
-    // Free decoded data and set data_size to 0 if decoding process failed
+    // Interleaved, split, and packed layouts (with or without a versioned header) are all decoded through their layout
+    int decode_success = arc_layout_decode(encoded_data, encoded_data_size, data, data_size);
     if (decode_success == 0){
-        free(*data);
-        *data_size = 0;
         printf("Hamming Decoding Failed!\n");
-    
     } else{
         if (PRINT){
             printf("Hamming Decoding Finished!\n");
         }
     }
-    // Return resulting array and decode success value
     return decode_success;
 }
 
@@ -2316,130 +6587,55 @@ int arc_secded_encode(uint8_t* data, uint32_t data_size, uint32_t block_size, ui
     if (PRINT){
         printf("Starting SECDED Encoding\n");
     }
-
-    // Check that block_size is valid and supported
-    if (block_size != 1 && block_size != 8){
-        printf("INVALID BLOCK SIZE: Please select a supported block size. . .\n");
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_create(SECDED_ID, data_size, block_size, 0, threads, &layout) == 0){
         return 0;
     }
-    // Set metadata length
-    uint32_t metadata_length = 17;
 
-    // Determine number of blocks given data_size and block_size
-    uint32_t block_count = (uint32_t)floor((float)data_size / (float)block_size);
-    uint32_t remainder_blocks = data_size % block_size;
-
-    // Given block size, determine number of parity bytes for each block
-    if (block_size == 1 || block_size == 8){
-        *encoded_data_size = data_size + block_count + remainder_blocks + metadata_length;
-    }
-    // Create encoded_data array from resulting 
+    // Calculate and create resulting array
+    *encoded_data_size = layout.encoded_size;
+    ARC_TRACE_BEGIN(allocate);
     *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
 
     // Write specific metadata back to array
-    // Store Approach Identifier
-    (*encoded_data)[0] = 0x03;
-    // Store Block Count in 4 Bytes 
-    (*encoded_data)[1] = (uint8_t)((block_count & 0xFF000000) >> 24);  
-    (*encoded_data)[2] = (uint8_t)((block_count & 0x00FF0000) >> 16);
-    (*encoded_data)[3] = (uint8_t)((block_count & 0x0000FF00) >> 8);
-    (*encoded_data)[4] = (uint8_t)((block_count & 0x000000FF));
-    // Store Block Size in 4 Bytes 
-    (*encoded_data)[5] = (uint8_t)((block_size & 0xFF000000) >> 24);  
-    (*encoded_data)[6] = (uint8_t)((block_size & 0x00FF0000) >> 16);
-    (*encoded_data)[7] = (uint8_t)((block_size & 0x0000FF00) >> 8);
-    (*encoded_data)[8] = (uint8_t)((block_size & 0x000000FF));    
-    // Store Remainder Blocks in 4 Bytes 
-    (*encoded_data)[9] = (uint8_t)((remainder_blocks & 0xFF000000) >> 24);  
-    (*encoded_data)[10] = (uint8_t)((remainder_blocks & 0x00FF0000) >> 16);
-    (*encoded_data)[11] = (uint8_t)((remainder_blocks & 0x0000FF00) >> 8);
-    (*encoded_data)[12] = (uint8_t)((remainder_blocks & 0x000000FF));
-    // Store Number of Threads used
-    (*encoded_data)[13] = (uint8_t)((threads & 0xFF000000) >> 24); 
-    (*encoded_data)[14] = (uint8_t)((threads & 0x00FF0000) >> 16);
-    (*encoded_data)[15] = (uint8_t)((threads & 0x0000FF00) >> 8);
-    (*encoded_data)[16] = (uint8_t)((threads & 0x000000FF));
-    // Set current index for encoded_data after metadata
-    uint32_t encoded_data_index = metadata_length;
-
-     // Setup Loop Variables 
-    uint32_t blocks_processed;
-    // Determine number of threads per block
-    int n_per_thread;
-    if ((block_count+remainder_blocks) < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = (block_count+remainder_blocks) / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
+    arc_layout_write_metadata(&layout, data, *encoded_data);
 
     // Calculate SECDED for each block of data
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < (block_count + remainder_blocks); blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_data_index;
-        uint32_t current_encoded_data_index;
-        uint32_t current_block_size;
-
-        // Determine loop offsets
-        // Full Blocks
-        if (blocks_processed < block_count){
-            current_data_index = blocks_processed * block_size;
-            current_encoded_data_index = encoded_data_index + (blocks_processed * (block_size + 1));
-            current_block_size = block_size;
-        // Remainder Blocks
-        } else {
-            current_data_index = block_count * block_size + (blocks_processed - block_count);
-            current_encoded_data_index = (encoded_data_index + (block_count * (block_size + 1))) + ((blocks_processed - block_count) * 2);
-            current_block_size = 1;
-        }
-
-        // Setup temporary variables
-        uint8_t block_1;
-        uint64_t block_8;
-        uint8_t block_parity;
+    arc_encode_blocks(&layout, data, *encoded_data, threads);
 
-        // Gather data based on current_block_size
-        if (current_block_size == 8){
-            // Load data
-            block_8 = ((uint64_t)data[current_data_index] << 56) | ((uint64_t)data[current_data_index+1] << 48) | \
-            ((uint64_t)data[current_data_index+2] << 40) | ((uint64_t)data[current_data_index+3] << 32) | \
-            ((uint64_t)data[current_data_index+4] << 24) | ((uint64_t)data[current_data_index+5] << 16) | \
-            ((uint64_t)data[current_data_index+6] << 8) | ((uint64_t)data[current_data_index+7]);
-
-            // Calculate SECDED on 8 Byte block
-            block_parity = arc_calculate_secded_uint64(block_8);
-
-            // Upon completion, wriet parity bits and 8 bytes of data to resulting array
-            (*encoded_data)[current_encoded_data_index] = block_parity;
-            current_encoded_data_index++;
-            int i;
-            for (i = current_data_index; i < current_data_index+block_size; i++){
-                (*encoded_data)[current_encoded_data_index] = data[i];
-                current_encoded_data_index++;
-            }
-
-        } else if (current_block_size == 1){
-            // Load data
-            block_1 = data[current_data_index];
-
-            // Calculate SECDED on 1 Byte block
-            block_parity = arc_calculate_secded_uint8(block_1);
+    // Return resulting array
+    if (PRINT){
+        printf("SECDED Encoding Finished\n");
+    }
+    return 1;
+}
 
-            // Upon completion, write parity bits and 1 byte of data to resulting array
-            (*encoded_data)[current_encoded_data_index] = block_parity;
-            current_encoded_data_index++;
-            (*encoded_data)[current_encoded_data_index] = data[current_data_index];
-            current_encoded_data_index++;
-        }
+// arc_secded_encodev:
+// Encodes a data stream held in a list of fragments using SECDED, without gathering it into one buffer first
+// params:
+// data_parts           -   array of fragments forming the data stream in order
+// part_count           -   number of fragments
+// block_size           -   number of bytes in each protected block (1 or 8)
+// threads              -   number of OpenMP threads to split work across
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_secded_encodev(const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
     }
-    
-    // Return resulting array
+    if (PRINT){
+        printf("Starting SECDED Encoding\n");
+    }
+    int err = arc_configuration_encodev(SECDED_ID, block_size, 0, threads, data_parts, part_count, encoded_data, encoded_data_size);
     if (PRINT){
         printf("SECDED Encoding Finished\n");
     }
-    return 1;
+    return err;
 }
 
 // arc_secded_decode:
@@ -2459,268 +6655,15 @@ int arc_secded_decode(uint8_t* encoded_data, uint32_t encoded_data_size, uint8_t
     if (PRINT){
         printf("Starting SECDED Decoding\n");
     }
-    // Set metadata length
-    uint32_t metadata_length = 17;
-
-    // Pull metadata from encoded_data array
-    uint32_t block_count = (((uint32_t)encoded_data[1] & 0x000000FF) << 24) | (((uint32_t)encoded_data[2] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[3] & 0x000000FF) << 8) | (((uint32_t)encoded_data[4] & 0x000000FF));
-    uint32_t block_size = (((uint32_t)encoded_data[5] & 0x000000FF) << 24) | (((uint32_t)encoded_data[6] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[7] & 0x000000FF) << 8) | (((uint32_t)encoded_data[8] & 0x000000FF));
-    uint32_t remainder_blocks = (((uint32_t)encoded_data[9] & 0x000000FF) << 24) | (((uint32_t)encoded_data[10] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[11] & 0x000000FF) << 8) | (((uint32_t)encoded_data[12] & 0x000000FF));
-    uint32_t threads = (((uint32_t)encoded_data[13] & 0x000000FF) << 24) | (((uint32_t)encoded_data[14] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[15] & 0x000000FF) << 8) | (((uint32_t)encoded_data[16] & 0x000000FF));
-    uint32_t encoded_data_index = 17;
-
-    // Check that block_size is valid and supported
-    if (block_size != 1 && block_size != 8){
-        printf("INVALID BLOCK SIZE: Please select a supported block size. . .\n");
-        return 0;
-    } 
-
-    // Determine size of original array and allocate it
-    if (block_size == 1 || block_size == 8){
-        *data_size = encoded_data_size - block_count - remainder_blocks - 17;
-    }
-    *data = (uint8_t*)malloc(sizeof(uint8_t) * *data_size);
-
-    // Setup Loop Variables 
-    uint32_t blocks_processed;
-    int decode_success = 1;
-    // Determine number of threads per block
-    int n_per_thread;
-    if ((block_count+remainder_blocks) < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = (block_count+remainder_blocks) / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
-
-    // Recalculate secded for each block of data
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < (block_count + remainder_blocks); blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_encoded_data_index;
-        uint32_t current_data_index;
-        uint32_t current_block_size;
-
-        // Determine loop offsets
-        // Full Blocks
-        if (blocks_processed < block_count){
-            current_encoded_data_index = encoded_data_index + (blocks_processed * (block_size + 1));
-            current_data_index = blocks_processed * block_size;
-            current_block_size = block_size;
-        // Remainder Blocks
-        } else {
-            current_encoded_data_index = (encoded_data_index + (block_count * (block_size + 1))) + ((blocks_processed - block_count) * 2);
-            current_data_index = block_count * block_size + (blocks_processed - block_count);
-            current_block_size = 1;
-        }
-
-        // Pull original parity bits and save for later
-        uint8_t original_block_parity;
-        if (current_block_size == 1 || current_block_size == 8){
-            original_block_parity = encoded_data[current_encoded_data_index];
-            current_encoded_data_index++;
-        }
-
-        // Set current block variables
-        uint32_t block_data_start = current_encoded_data_index;
-
-        // Setup temporary variables
-        uint8_t block_1;
-        uint64_t block_8;
-        uint8_t block_parity;
-        uint8_t xor_parity;
-        uint8_t secded_parity_bit;
-        uint8_t temp_original_block_parity;
-        uint8_t block_parity_parity;
-        uint8_t block_data_parity;
-        uint8_t other_secded_parity_bit;
-
-        // Gather data for current block 
-        if (current_block_size == 8){
-            // Load data 
-            block_8 =  ((uint64_t)encoded_data[current_encoded_data_index] << 56) | ((uint64_t)encoded_data[current_encoded_data_index+1] << 48) | \
-            ((uint64_t)encoded_data[current_encoded_data_index+2] << 40) | ((uint64_t)encoded_data[current_encoded_data_index+3] << 32) | \
-            ((uint64_t)encoded_data[current_encoded_data_index+4] << 24) | ((uint64_t)encoded_data[current_encoded_data_index+5] << 16) | \
-            ((uint64_t)encoded_data[current_encoded_data_index+6] << 8) | ((uint64_t)encoded_data[current_encoded_data_index+7]);
-            current_encoded_data_index = current_encoded_data_index+8;
-
-            // Calculate secded on 8 Byte block
-            block_parity = arc_calculate_secded_uint64(block_8);
-
-            // Upon completion, compare both parity bits to ensure data integrity
-            xor_parity = original_block_parity ^ block_parity;
-
-            if (xor_parity == 0){
-               // If parity is correct, add data to array
-               int i;
-               for (i = block_data_start; i < current_encoded_data_index; i++){
-                   (*data)[current_data_index] = encoded_data[i];
-                   current_data_index++;
-               }
-            } else {
-                if(PRINT)
-                    printf("Incorrect Parity Found...\nChecking for Double Bit Errors...\n");
-                // With syndrome being non-zero, check parity to see if double bit error occured
-                // Grab current secded parity bit
-                secded_parity_bit = ((original_block_parity & 0b10000000) >> 7);
-                // Remove secded parity bit from block parity
-                temp_original_block_parity = (original_block_parity & 0b01111111);
-
-                // Calculate actual parity on faulty codeword data
-                block_parity_parity = arc_calculate_parity_uint8(temp_original_block_parity);
-                block_data_parity = arc_calculate_parity_uint64(block_8);
-                // Combine found parity
-                other_secded_parity_bit = 0;
-                if (block_parity_parity != block_data_parity){
-                    other_secded_parity_bit = 1;
-                }
-                // If secded parity is the same as previous block secded parity, then Double Error Detected
-                if (secded_parity_bit == other_secded_parity_bit){
-                    printf("DATA INTEGRITY ERROR: Double Bit Error Found, Correction Impossible...\n");
-                    #pragma omp critical 
-                    {
-                        decode_success = 0;
-                    }
-                // If parity is not the same then a single bit error can be attempted to be fixed
-                } else {
-                    if(PRINT)    
-                        printf("Double Bit Error Not Found...\nAttempting to Fix...\n");
-                    // Using xor_parity value attempt to fix data and parity
-                    int j;
-                    for (j = 0; j < 72; j++){
-                        if (xor_parity == S_8_Syndrome_Table[j]){
-                            if (j < 64){
-                                block_8 = block_8 ^ ((uint64_t)1 << j);
-                                block_parity = arc_calculate_secded_uint64(block_8);
-                            } else {
-                                block_parity = block_parity ^ (1 << (j-64));
-                            }
-                            break;
-                        }
-                    }
-
-                    // Recalculate secded on "fixed" data and parity
-                    xor_parity = original_block_parity ^ block_parity;
-                    if (xor_parity == 0){
-                        if(PRINT)
-                            printf("Data Corrected!\n");
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0xFF00000000000000) >> 56);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x00FF000000000000) >> 48);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x0000FF0000000000) >> 40);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x000000FF00000000) >> 32);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x00000000FF000000) >> 24);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x0000000000FF0000) >> 16);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x000000000000FF00) >> 8);
-                        current_data_index++;
-                        (*data)[current_data_index] = (uint8_t)((block_8 & 0x00000000000000FF));
-                        current_data_index++;
-                    } else {
-                        printf("DATA INTEGRITY ERROR: Parity Error Found, Correction Failed...\n");
-                        #pragma omp critical 
-                        {
-                            decode_success = 0;
-                        }
-                    }
-                }
-            }
-        } else if (current_block_size == 1){
-            // Load data 
-            block_1 = encoded_data[current_encoded_data_index];
-            current_encoded_data_index++;
-
-            // Calculate secded on 1 Byte block
-            block_parity = arc_calculate_secded_uint8(block_1);
-
-            // Upon completion, compare both parity bits to ensure data integrity
-            xor_parity = original_block_parity ^ block_parity;
-
-            if (xor_parity == 0){
-               // If parity is correct, add data to array
-               (*data)[current_data_index] = encoded_data[block_data_start];
-               current_data_index++;
-            } else {
-                if(PRINT)
-                    printf("Incorrect Parity Found...\nChecking for Double Bit Errors...\n");
-                // With syndrome being non-zero, check parity to see if double bit error occured
-                // Grab current secded parity bit
-                secded_parity_bit = ((original_block_parity & 0b00010000) >> 4);
-                // Remove secded parity bit from block parity
-                temp_original_block_parity = (original_block_parity & 0b11101111);
-
-                // Calculate actual parity on faulty codeword data
-                block_parity_parity = arc_calculate_parity_uint8(temp_original_block_parity);
-                block_data_parity = arc_calculate_parity_uint8(block_1);
-                // Combine found parity
-                other_secded_parity_bit = 0;
-                if (block_parity_parity != block_data_parity){
-                    other_secded_parity_bit = 1;
-                }
-                // If secded parity is the same as previous block secded parity, then Double Error Detected
-                if (secded_parity_bit == other_secded_parity_bit){
-                    printf("DATA INTEGRITY ERROR: Double Bit Error Found, Correction Impossible...\n");
-                    #pragma omp critical 
-                    {
-                        decode_success = 0;
-                    }
-                // If parity is not the same then a single bit error can be attempted to be fixed
-                } else {
-                    if(PRINT)
-                        printf("Double Bit Error Not Found...\nAttempting to Fix...\n");
-                    // Using xor_parity value attempt to fix data and parity
-                    int j;
-                    for (j = 0; j < 16; j++){
-                        if (xor_parity == S_1_Syndrome_Table[j]){
-                            if (j < 8){
-                                block_1 = block_1 ^ ( 1 << j);
-                                block_parity = arc_calculate_secded_uint8(block_1);
-                            } else {
-                                block_parity = block_parity ^ ( 1 << (j-8));
-                            }
-                            break;
-                        }
-                    }
-
-                    // Recalculate secded on "fixed" data and parity
-                    xor_parity = original_block_parity ^ block_parity;
-                    if (xor_parity == 0){
-                        if(PRINT)
-                            printf("Data Corrected!\n");
-                        (*data)[current_data_index] = block_1;
-                        current_data_index++;
-                    } else {
-                        printf("DATA INTEGRITY ERROR: Unknown Bit Error Found, Correction Failed...\n");
-                        #pragma omp critical 
-                        {
-                            decode_success = 0;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // Free decoded data and set data_size to 0 if decoding process failed
+    // Interleaved, split, and packed layouts (with or without a versioned header) are all decoded through their layout
+    int decode_success = arc_layout_decode(encoded_data, encoded_data_size, data, data_size);
     if (decode_success == 0){
-        free(*data);
-        *data_size = 0;
-            printf("SECDED Decoding Failed!\n");  
+        printf("SECDED Decoding Failed!\n");
     } else{
         if (PRINT){
             printf("SECDED Decoding Finished!\n");
         }
     }
-    // Return resulting array and decode success value
     return decode_success;
 }
 
@@ -2746,223 +6689,23 @@ int arc_reed_solomon_encode(uint8_t* data, uint32_t data_size, uint32_t data_dev
     if (PRINT){
         printf("Starting Reed Solomon Encoding\n");
     }
-    // Set metadata length 
-    uint32_t metadata_length = 25;
-
-    // Ensure k+m <= 2^w
-    if (data_devices + code_devices > ((long)1 << 8)){
-        printf("INVALID PARAMETER SIZES: Please select inputs where data devices + code devices <= 2^8. . .\n");
+    // Determine the layout of the encoded data stream
+    struct arc_layout layout;
+    if (arc_layout_create(RS_ID, data_size, data_devices, code_devices, threads, &layout) == 0){
         return 0;
     }
 
-    // Determine number of blocks given data_size and data_devices
-    // Calculate number of longs within the overall data
-    uint32_t longs_per_data = (uint32_t)ceil((float)data_size / (float)8);
-    // Calculate remainder bytes in final long of data
-    uint32_t remainder_long_in_data = data_size % 8;
-    // Calculate number of ecc blocks that are needed given longs per data
-    uint32_t block_count = (uint32_t)ceil((float)longs_per_data / (float)data_devices);
-    // Calculate number of data devices in final ecc block
-    uint32_t remainder_data_devices = longs_per_data % data_devices;
-
-    // Create encoded_data array given sizes
-    uint32_t data_bytes;
-    uint32_t code_bytes;
-    uint32_t parity_bytes;
-
-    // Calculate bytes needed for data
-    if (remainder_data_devices == 0){
-        data_bytes = data_devices * 8 * block_count;
-    } else {
-        data_bytes = (data_devices * 8 * (block_count-1)) + (remainder_data_devices * 8);
-    }
-    // Calculate bytes needed for coding
-    code_bytes = code_devices * 8 * block_count;
-    // Calculate bytes needed for parity
-    if (remainder_data_devices == 0){
-        parity_bytes = (data_devices + code_devices) * block_count;
-    } else {
-        parity_bytes = ((data_devices + code_devices) * (block_count-1)) + (code_devices + remainder_data_devices);
-    }
-
-    // Create encoded_data array from resulting 
-    *encoded_data_size = metadata_length + data_bytes + code_bytes + parity_bytes;
+    // Calculate and create resulting array
+    *encoded_data_size = layout.encoded_size;
+    ARC_TRACE_BEGIN(allocate);
     *encoded_data = (uint8_t*)malloc(sizeof(uint8_t) * *encoded_data_size);
+    ARC_TRACE_END(allocate);
 
     // Write specific metadata back to array
-    // Store Approach Identifier
-    (*encoded_data)[0] = 0x04;
-    // Store Data Devices
-    (*encoded_data)[1] = (uint8_t)((data_devices & 0xFF000000) >> 24);  
-    (*encoded_data)[2] = (uint8_t)((data_devices & 0x00FF0000) >> 16);
-    (*encoded_data)[3] = (uint8_t)((data_devices & 0x0000FF00) >> 8);
-    (*encoded_data)[4] = (uint8_t)((data_devices & 0x000000FF));
-    // Store Code Devices
-    (*encoded_data)[5] = (uint8_t)((code_devices & 0xFF000000) >> 24);  
-    (*encoded_data)[6] = (uint8_t)((code_devices & 0x00FF0000) >> 16);
-    (*encoded_data)[7] = (uint8_t)((code_devices & 0x0000FF00) >> 8);
-    (*encoded_data)[8] = (uint8_t)((code_devices & 0x000000FF));
-    // Store Block Count
-    (*encoded_data)[9] = (uint8_t)((block_count & 0xFF000000) >> 24);  
-    (*encoded_data)[10] = (uint8_t)((block_count & 0x00FF0000) >> 16);
-    (*encoded_data)[11] = (uint8_t)((block_count & 0x0000FF00) >> 8);
-    (*encoded_data)[12] = (uint8_t)((block_count & 0x000000FF));
-    // Store Remainder Data Devices
-    (*encoded_data)[13] = (uint8_t)((remainder_data_devices & 0xFF000000) >> 24);  
-    (*encoded_data)[14] = (uint8_t)((remainder_data_devices & 0x00FF0000) >> 16);
-    (*encoded_data)[15] = (uint8_t)((remainder_data_devices & 0x0000FF00) >> 8);
-    (*encoded_data)[16] = (uint8_t)((remainder_data_devices & 0x000000FF));
-    // Store Remainder Long in Data
-    (*encoded_data)[17] = (uint8_t)((remainder_long_in_data & 0xFF000000) >> 24);  
-    (*encoded_data)[18] = (uint8_t)((remainder_long_in_data & 0x00FF0000) >> 16);
-    (*encoded_data)[19] = (uint8_t)((remainder_long_in_data & 0x0000FF00) >> 8);
-    (*encoded_data)[20] = (uint8_t)((remainder_long_in_data & 0x000000FF));
-    // Store Number of Threads used
-    (*encoded_data)[21] = (uint8_t)((threads & 0xFF000000) >> 24); 
-    (*encoded_data)[22] = (uint8_t)((threads & 0x00FF0000) >> 16);
-    (*encoded_data)[23] = (uint8_t)((threads & 0x0000FF00) >> 8);
-    (*encoded_data)[24] = (uint8_t)((threads & 0x000000FF));
-    // Set current index for 
-    uint32_t encoded_data_index = metadata_length;
-
-    // Setup Loop Variables
-    uint32_t blocks_processed;
-
-    // Determine number of threads per block
-    int n_per_thread;
-    if (block_count < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = block_count / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
-    
-    // Calculate Reed-Solomon Encoding for each block
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < block_count; blocks_processed++){
-        // Declare private loop variables
-        int i, j;
-        int remainder_block;
-        int longs_processed = 0;
-        int current_blocks_longs;
-        long temp_l;
-        uint32_t current_block_data_devices;
-
-        // Set current block size (data devices for this block)
-        if (blocks_processed == block_count-1 && remainder_data_devices != 0){
-            current_block_data_devices = remainder_data_devices;
-            current_blocks_longs = current_block_data_devices * 8;
-            remainder_block = 1;
-        } else {
-            current_block_data_devices = data_devices;
-            current_blocks_longs = current_block_data_devices * 8;
-            remainder_block = 0;
-        }
-
-        // Calculate index offsets
-        uint32_t current_block_data_index = data_devices * 8 * blocks_processed;
-        uint32_t current_block_encoded_data_index = encoded_data_index + ((data_devices+code_devices)*8 + (data_devices+code_devices))*blocks_processed;
-        
-        // Inflate data to the correct form for Reed-Solomon Encoding
-        // Create appropriate size data matrix
-        char** rs_data;
-        rs_data = talloc(char *, current_block_data_devices);
-        for (i = 0; i < current_block_data_devices; i++){
-            rs_data[i] = talloc(char, 8);
-
-            if (longs_processed != current_blocks_longs-1 || 
-               (longs_processed == current_blocks_longs-1 && blocks_processed != block_count-1) || 
-               (longs_processed == current_blocks_longs-1 && blocks_processed == block_count-1 && remainder_long_in_data == 0)){
-                temp_l = 0;
-                for (j = 0; j < 8; j++){
-                    temp_l = temp_l | ((long)data[current_block_data_index] << (64-(8*(j+1)))); 
-                    current_block_data_index++;
-                }
-                longs_processed++;
-            } else {
-                temp_l = 0;
-                for (j = 0; j < remainder_long_in_data; j++){
-                    temp_l = temp_l | ((long)data[current_block_data_index] << (64-(8*(j+1))));
-                    current_block_data_index++;
-                }
-                longs_processed++;
-            }
-            // Save inflated data
-            memcpy(rs_data[i], &temp_l, 8);
-        }
-
-        // Create Coding Data Matrix
-        char** rs_code;
-        rs_code = talloc(char*, code_devices);
-        for (i = 0; i < code_devices; i++){
-            rs_code[i] = talloc(char, 8);
-        }
-
-        // Setup Vandermonde Matrix
-        int* matrix = reed_sol_vandermonde_coding_matrix(current_block_data_devices, code_devices, 8);
-
-        // Encode with classic Reed-Solomon Encoding
-        jerasure_matrix_encode(current_block_data_devices, code_devices, 8, matrix, rs_data, rs_code, 8);
-
-        // Flatten rs_code and rs_data back to a uint8_t array
-        uint32_t block_stream_size = (current_block_data_devices + code_devices) * 8;
-        uint8_t* block_stream = (uint8_t*)malloc(sizeof(uint8_t) * block_stream_size);
-
-        uint32_t block_stream_index = 0;
-        for (i = 0; i < code_devices; i++){
-            for (j = 7; j >= 0; j--){
-                block_stream[block_stream_index] = (uint8_t)rs_code[i][j]; 
-                rs_code[i][j] = 0;
-                block_stream_index++;
-            }
-        }
-        for (i = 0; i < current_block_data_devices; i++){
-            for (j = 7; j >= 0; j--){
-                block_stream[block_stream_index] = (uint8_t)rs_data[i][j]; 
-                rs_data[i][j] = 0;
-                block_stream_index++;
-            }
-        }
-
-        // Apply Parity protection to each device and save to protected data stream
-        uint32_t bytes_processed = 0;
-        uint32_t device_data_bytes = 0;
-        uint8_t device_parity;
-        uint64_t device_data;
+    arc_layout_write_metadata(&layout, data, *encoded_data);
 
-        while(bytes_processed != block_stream_size){
-            // Gather eight bytes of device data
-            device_data = 0;
-            for (j = 0; j < 8; j++){
-                device_data = device_data | ((uint64_t)block_stream[device_data_bytes] << (64-(8*(j+1)))); 
-                device_data_bytes++;
-            }
-            // Calculate parity
-            device_parity = arc_calculate_parity_uint64(device_data);
-
-            // Write parity and data out to protected data stream
-            (*encoded_data)[current_block_encoded_data_index] = device_parity;
-            current_block_encoded_data_index++;
-            for (i = bytes_processed; i < bytes_processed + 8; i++){
-                (*encoded_data)[current_block_encoded_data_index] = block_stream[i];
-                current_block_encoded_data_index++;
-            }
-            bytes_processed = bytes_processed + 8; 
-        }
-
-        // Free allocated variables
-        for (i = 0; i < current_block_data_devices; i++){
-            free(rs_data[i]);
-        }
-        free(rs_data);
-        for (i = 0; i < code_devices; i++){
-            free(rs_code[i]);
-        }
-        free(rs_code);
-        free(block_stream);
-        free(matrix);
-    }
+    // Calculate Reed-Solomon encoding for each block of data
+    arc_encode_blocks(&layout, data, *encoded_data, threads);
 
     // Return resulting array
     if (PRINT){
@@ -2971,6 +6714,32 @@ int arc_reed_solomon_encode(uint8_t* data, uint32_t data_size, uint32_t data_dev
     return 1;
 }
 
+// arc_reed_solomon_encodev:
+// Encodes a data stream held in a list of fragments using Reed-Solomon, without gathering it into one buffer first
+// params:
+// data_parts           -   array of fragments forming the data stream in order
+// part_count           -   number of fragments
+// data_devices         -   number of data devices (8 byte longs) in each block
+// code_devices         -   number of code devices in each block
+// threads              -   number of OpenMP threads to split work across
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_reed_solomon_encodev(const struct iovec* data_parts, int part_count, uint32_t data_devices, uint32_t code_devices, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    if (PRINT){
+        printf("Starting Reed Solomon Encoding\n");
+    }
+    int err = arc_configuration_encodev(RS_ID, data_devices, code_devices, threads, data_parts, part_count, encoded_data, encoded_data_size);
+    if (PRINT){
+        printf("Reed Solomon Encoding Finished\n");
+    }
+    return err;
+}
 
 // arc_reed_solomon_decode:
 // Decode data encoded using reed-solomon encoding
@@ -2989,324 +6758,95 @@ int arc_reed_solomon_decode(uint8_t* encoded_data, uint32_t encoded_data_size, u
     if (PRINT){
         printf("Starting Reed Solomon Decoding\n");
     }
-    // Set metadata length
-    uint32_t metadata_length = 25;
-
-    // Pull metadata from encoded_data array
-    uint32_t data_devices = (((uint32_t)encoded_data[1] & 0x000000FF) << 24) | (((uint32_t)encoded_data[2] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[3] & 0x000000FF) << 8) | (((uint32_t)encoded_data[4] & 0x000000FF));
-    uint32_t code_devices = (((uint32_t)encoded_data[5] & 0x000000FF) << 24) | (((uint32_t)encoded_data[6] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[7] & 0x000000FF) << 8) | (((uint32_t)encoded_data[8] & 0x000000FF));
-    uint32_t block_count = (((uint32_t)encoded_data[9] & 0x000000FF) << 24) | (((uint32_t)encoded_data[10] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[11] & 0x000000FF) << 8) | (((uint32_t)encoded_data[12] & 0x000000FF));
-    uint32_t remainder_data_devices = (((uint32_t)encoded_data[13] & 0x000000FF) << 24) | (((uint32_t)encoded_data[14] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[15] & 0x000000FF) << 8) | (((uint32_t)encoded_data[16] & 0x000000FF));
-    uint32_t remainder_long_in_data = (((uint32_t)encoded_data[17] & 0x000000FF) << 24) | (((uint32_t)encoded_data[18] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[19] & 0x000000FF) << 8) | (((uint32_t)encoded_data[20] & 0x000000FF));
-    uint32_t threads = (((uint32_t)encoded_data[21] & 0x000000FF) << 24) | (((uint32_t)encoded_data[22] & 0x000000FF) << 16) | \
-    (((uint32_t)encoded_data[23] & 0x000000FF) << 8) | (((uint32_t)encoded_data[24] & 0x000000FF));
-    uint32_t encoded_data_index = metadata_length;
-
-    // Check that all inputs are still valid
-    // Ensure k+m <= 2^w
-    if (data_devices + code_devices > ((long)1 << 8)){
-        printf("INVALID PARAMETER SIZES: Please select inputs where data devices + code devices <= 2^device length. . .\n");
-        return 0;
-    }
-
-
-    // Determine size of the original array 
-    if (remainder_data_devices == 0){
-        if (remainder_long_in_data == 0){
-            *data_size = (data_devices * 8 * block_count);
-        } else {
-            *data_size = (data_devices * 8 * block_count) - (8 - remainder_long_in_data);
-        }
-    } else {
-        if (remainder_long_in_data == 0){
-            *data_size = (data_devices * 8 * (block_count-1)) + (remainder_data_devices * 8);
-        } else {
-            *data_size = (data_devices * 8 * (block_count-1)) + (remainder_data_devices * 8) - (8 - remainder_long_in_data);
-        }
-    }
-    *data = (uint8_t*)malloc(sizeof(uint8_t) * *data_size);
-
-    // Setup Loop Variables
-    uint32_t blocks_processed;
-    int decode_success = 1;
-
-    // Determine number of threads per block
-    int n_per_thread;
-    if (block_count < threads){
-        n_per_thread = 1;
-    } else {
-        n_per_thread = block_count / threads;
-    }
-    // Set number of threads
-	omp_set_num_threads(threads);
-    
-    // Calculate Reed-Solomon Encoding for each block
-    #pragma omp parallel for schedule(static, n_per_thread)
-    for (blocks_processed = 0; blocks_processed < block_count; blocks_processed++){
-        // Declare private loop variables
-        uint32_t current_block_data_devices;
-        uint32_t current_block_encoded_data_start; 
-        uint32_t current_block_total_devices;
-        uint32_t current_devices_processed;
-        int i, j;
-
-        // Set up erasures array
-        int* erasures = talloc(int, (code_devices+1));
-        int erasure_count;
-
-        // Set number of data devices in block
-        if (blocks_processed == block_count-1 && remainder_data_devices != 0){
-            current_block_data_devices = remainder_data_devices;
-        } else {
-            current_block_data_devices = data_devices;
-        }
-
-        // Calculate index offsets
-        uint32_t current_block_encoded_data_index = encoded_data_index + ((data_devices+code_devices)*8 + (data_devices+code_devices))*blocks_processed;
-        uint32_t current_block_data_index = data_devices * 8 * blocks_processed;
-
-        // Store original encoded data index for resetting later
-        current_block_encoded_data_start = current_block_encoded_data_index;
-        // Set total number of devices in block
-        current_block_total_devices = current_block_data_devices + code_devices;
-
-        // Check parity for each device in block
-        uint8_t previous_device_parity;
-        uint8_t new_device_parity;
-        uint8_t xor_parity;
-        uint64_t device_data;
-        int parity_correct = 1;
-        current_devices_processed = 0;
-        erasure_count = 0;
-        while(current_devices_processed != current_block_total_devices){
-            // Save previous datas parity
-            previous_device_parity = encoded_data[current_block_encoded_data_index];
-            current_block_encoded_data_index++;
-            // Gather data for current device
-            device_data = 0;
-            for (j = 0; j < 8; j++){
-                device_data = device_data | ((uint64_t)encoded_data[current_block_encoded_data_index] << (64-(8*(j+1)))); 
-                current_block_encoded_data_index++;
-            }
-            // Calculate parity
-            new_device_parity = arc_calculate_parity_uint64(device_data);
-
-            // Compare parities using XOR
-            xor_parity = previous_device_parity ^ new_device_parity;
-            // If the parities are different, set incorrect parity and count needed erasure
-            if (xor_parity != 0){
-                if (parity_correct == 1){
-                    parity_correct = 0;
-                }
-                // If erasures needed pass number of coding devices, return since data cannot be fixed
-                if (erasure_count < code_devices){
-                    // NOTE: (The below arithmetic is due to the fact that jerasure expects data then code, 
-                    // but in this code, we put code then data)
-
-                    // If the erasure is in a data device
-                    if (current_devices_processed >= code_devices){
-                        erasures[erasure_count] = current_devices_processed - code_devices;
-                    // If the erasure is in a code device
-                    } else {
-                        erasures[erasure_count] = current_devices_processed + current_block_data_devices;
-                    }
-                    erasure_count++;
-                } else {
-                    printf("DATA INTEGRITY ERROR: Too Many Erasures Needed To Fix Data, Correction Impossible...\n");
-                    #pragma omp critical 
-                    {
-                        decode_success = 0;
-                    }
-                }
-            }
-            current_devices_processed++;
-        }
-
-        if (decode_success == 1){
-            // If parity was correct for all items in the block, then write data out to data stream
-            if (parity_correct == 1){
-                // Reset data index to beginning of block and devices processed to 0
-                current_block_encoded_data_index = current_block_encoded_data_start;
-                current_devices_processed = 0;
-                while(current_devices_processed != current_block_total_devices){
-                    if (current_devices_processed >= code_devices){
-                        // Skip past parity byte
-                        current_block_encoded_data_index++;
-
-                        // Write out bytes to data stream
-                        for (i = 0; i < 8; i++){
-                            // Make sure not to write off the end of the data array
-                            if (current_block_data_index < *data_size){
-                                (*data)[current_block_data_index] = encoded_data[current_block_encoded_data_index];
-                                current_block_data_index++;
-                                current_block_encoded_data_index++;
-                            }
-                        }
-                    } else {
-                        // Skip coding devices
-                        current_block_encoded_data_index = current_block_encoded_data_index + 9;
-                    }
-                    current_devices_processed++;
-                }
-            // If parity was incorrect for any items in the block, then erase faulty devices, decode with jerasure, and write fixed data out
-            } else {
-                if(PRINT)
-                    printf("Incorrect Parity Found. . .\nFixing Now\n");
-                // Reset data index to beginning of block and devices processed to 0
-                current_block_encoded_data_index = current_block_encoded_data_start;
-                current_devices_processed = 0;
-                // Set negative one to last space in erasures array
-                erasures[erasure_count] = -1;
-
-                // Create Coding Data Matrix
-                char** rs_code;
-                rs_code = talloc(char*, code_devices);
-                for (i = 0; i < code_devices; i++){
-                    rs_code[i] = talloc(char, 8);
-                }
-
-                // Inflate data and code 
-                char** rs_data;
-                rs_data = talloc(char *, current_block_data_devices);
-                int rs_data_i = 0;
-                int rs_code_i = 0;
-                long temp_l = 0;
-                while(current_devices_processed != current_block_total_devices){
-                    // place data into rs_data
-                    if (current_devices_processed >= code_devices){
-                        // Initialize rs_data row 
-                        rs_data[rs_data_i] = talloc(char, 8);
-                        // Determine if device needs to be erased
-                        int erase = 0;
-                        for (i = 0; i < code_devices; i++){
-                            if (erasures[i] == -1){
-                                break;
-                            } else if (erasures[i] == current_devices_processed - code_devices){
-                                erase = 1;
-                            }
-                        }
-                        if (erase == 1){
-                            // Erase device
-                            temp_l = 0;
-                            memcpy(rs_data[rs_data_i], &temp_l, 8);
-                            rs_data_i++;
-                            // Move past current device data
-                            current_block_encoded_data_index = current_block_encoded_data_index + 9;
-                        } else {
-                            // Skip parity byte
-                            current_block_encoded_data_index++;
-                            // Pull all eight bytes together 
-                            temp_l = 0;
-                            for (j = 0; j < 8; j++){
-                                temp_l = temp_l | ((long)encoded_data[current_block_encoded_data_index] << (64-(8*(j+1)))); 
-                                current_block_encoded_data_index++;
-                            }
-                            // Save long to rs_data
-                            memcpy(rs_data[rs_data_i], &temp_l, 8);
-                            rs_data_i++;
-                        }
-                    } else {
-                        // Initialize rs_code row
-                        temp_l = 0;
-                        memcpy(rs_code[rs_code_i], &temp_l, 8);
-
-                        // Determine if device needs to be erased
-                        int erase = 0;
-                        for (i = 0; i < code_devices; i++){
-                            if (erasures[i] == -1){
-                                break;
-                            } else if (erasures[i] == current_devices_processed + current_block_data_devices){
-                                erase = 1;
-                            }
-                        }
-                        if (erase == 1){
-                            // Erase device
-                            temp_l = 0;
-                            memcpy(rs_code[rs_code_i], &temp_l, 8);
-                            rs_code_i++;
-                            // Move past current device data
-                            current_block_encoded_data_index = current_block_encoded_data_index + 9;
-                        } else {
-                            // Skip parity byte
-                            current_block_encoded_data_index++;
-                            // Pull all eight bytes together 
-                            temp_l = 0;
-                            for (j = 0; j < 8; j++){
-                                temp_l = temp_l | ((long)encoded_data[current_block_encoded_data_index] << (64-(8*(j+1)))); 
-                                current_block_encoded_data_index++;
-                            }
-                            // Save long to rs_code
-                            memcpy(rs_code[rs_code_i], &temp_l, 8);
-                            rs_code_i++;
-                        }
-                    }
-                    // Move to next device
-                    current_devices_processed++;
-                }
-
-                // Setup Vandermonde Matrix
-                int* matrix = reed_sol_vandermonde_coding_matrix(current_block_data_devices, code_devices, 8);
-
-                // Send inflated data code and erasures to jerasure decode
-                int err = jerasure_matrix_decode(current_block_data_devices, code_devices, 8, matrix, 1, erasures, rs_data, rs_code, 8);
-
-                // Check for a successful decode
-                if (err == -1){
-                    printf("DATA INTEGRITY ERROR: Reed Solomon Decode Has Failed...\n");
-                    #pragma omp critical 
-                    {
-                        decode_success = 0;
-                    }
-                }
-
-                if (decode_success == 1){
-                    // Flatten data and write out to result data stream
-                    for (i = 0; i < current_block_data_devices; i++){
-                        // Write bytes to data stream
-                        for (j = 7; j >= 0; j--){
-                            // Make sure not to write off the end of the data array
-                            if (current_block_data_index < *data_size){
-                                (*data)[current_block_data_index] = (uint8_t)rs_data[i][j];
-                                rs_data[i][j] = 0;
-                                current_block_data_index++;
-                            }
-                        }
-                    }
-                } 
-
-                // Free allocated variables
-                for (i = 0; i < current_block_data_devices; i++){
-                    free(rs_data[i]);
-                }
-                free(rs_data);
-                for (i = 0; i < code_devices; i++){
-                    free(rs_code[i]);
-                }
-                free(matrix);
-            }
-        }  
-
-        // Free allocated variables
-        free(erasures);
-    }
-
-    // Free decoded data and set data_size to 0 if decoding process failed
+    // Interleaved, split, and packed layouts (with or without a versioned header) are all decoded through their layout
+    int decode_success = arc_layout_decode(encoded_data, encoded_data_size, data, data_size);
     if (decode_success == 0){
-        free(*data);
-        *data_size = 0;
         printf("Reed Solomon Decoding Failed!\n");
     } else{
         if (PRINT){
             printf("Reed Solomon Decoding Finished!\n");
         }
     }
-    // Return resulting array and decode success value
     return decode_success;
 }
 
+// arc_packed_method_identifier:
+// Maps a user facing ECC method to the identifier of a method whose check bits can be packed
+// params:
+// ecc_method           -   ARC_PARITY, ARC_HAMMING, or ARC_SECDED
+// return:
+// identifier           -   PARITY_ID, HAMMING_ID, or SECDED_ID (0 if the method cannot be packed)
+int arc_packed_method_identifier(int ecc_method){
+    if (ecc_method == ARC_PARITY){
+        return PARITY_ID;
+    } else if (ecc_method == ARC_HAMMING){
+        return HAMMING_ID;
+    } else if (ecc_method == ARC_SECDED){
+        return SECDED_ID;
+    }
+    printf("INVALID ENCODING METHOD: Only Parity, Hamming, and SECDED check bits can be packed. . .\n");
+    return 0;
+}
+
+// arc_packed_encode:
+// Encodes data with Parity, Hamming-1, or SECDED-1 while packing the check bits of every block back to back
+// (a bitmap for Parity, 4 bit fields for Hamming, 5 bit fields for SECDED) after the contiguous payload
+// params:
+// ecc_method           -   ARC_PARITY, ARC_HAMMING, or ARC_SECDED
+// data                 -   uint8_t data stream
+// data_size            -   size of data stream
+// block_size           -   number of bytes in each protected block (must be 1 for Hamming and SECDED)
+// threads              -   number of OpenMP threads to split work across
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_packed_encode(int ecc_method, uint8_t* data, uint32_t data_size, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    int ecc_algorithm = arc_packed_method_identifier(ecc_method);
+    if (ecc_algorithm == 0){
+        return 0;
+    }
+    if (PRINT){
+        printf("Starting Packed Encoding\n");
+    }
+    int err = arc_configuration_encode(ecc_algorithm, block_size, 1, threads, data, data_size, encoded_data, encoded_data_size);
+    if (PRINT){
+        printf("Packed Encoding Finished\n");
+    }
+    return err;
+}
 
+// arc_packed_encodev:
+// Encodes a data stream held in a list of fragments like arc_packed_encode, without gathering it into one buffer first
+// params:
+// ecc_method           -   ARC_PARITY, ARC_HAMMING, or ARC_SECDED
+// data_parts           -   array of fragments forming the data stream in order
+// part_count           -   number of fragments
+// block_size           -   number of bytes in each protected block (must be 1 for Hamming and SECDED)
+// threads              -   number of OpenMP threads to split work across
+// encoded_data         -   address of pointer to encoded uint8_t protected data stream
+// encoded_data_size    -   address of pointer to encoded size of protected data stream
+// return:
+// err                  -   error code to determine if sucessful (1=sucessful,0=unsucessful)
+int arc_packed_encodev(int ecc_method, const struct iovec* data_parts, int part_count, uint32_t block_size, uint32_t threads, uint8_t** encoded_data, uint32_t* encoded_data_size){
+    if (!INIT){
+        printf("Initialization Error: Please initialize ARC before further use\n");
+        return 0;
+    }
+    int ecc_algorithm = arc_packed_method_identifier(ecc_method);
+    if (ecc_algorithm == 0){
+        return 0;
+    }
+    if (PRINT){
+        printf("Starting Packed Encoding\n");
+    }
+    int err = arc_configuration_encodev(ecc_algorithm, block_size, 1, threads, data_parts, part_count, encoded_data, encoded_data_size);
+    if (PRINT){
+        printf("Packed Encoding Finished\n");
+    }
+    return err;
+}
@@ -11,6 +11,65 @@
 #include "arc.h"
 #include <omp.h>      //OpenMP
 
+// Counts completed asynchronous requests for TEST 10
+void async_test_callback(int err, uint8_t* result_data, uint32_t result_data_size, void* user_data){
+    int* completed = (int*)user_data;
+    if (err == 1){
+        __sync_fetch_and_add(completed, 1);
+    }
+}
+
+// Shared state for the pipeline functions used in TEST 11
+struct pipeline_test_state {
+    uint8_t* data;
+    uint32_t slab_size;
+    uint32_t next_slab;
+    int pass;
+};
+
+// Simulates compression of a slab by copying it into a new buffer
+int pipeline_test_compress(uint32_t slab, void* user_data, uint8_t** compressed_data, uint32_t* compressed_data_size){
+    struct pipeline_test_state* state = (struct pipeline_test_state*)user_data;
+    *compressed_data = malloc(state->slab_size);
+    memcpy(*compressed_data, state->data + slab * state->slab_size, state->slab_size);
+    *compressed_data_size = state->slab_size;
+    return 1;
+}
+
+// Decodes each written slab and checks it arrives in order and intact
+int pipeline_test_write(uint32_t slab, uint8_t* encoded_data, uint32_t encoded_data_size, void* user_data){
+    struct pipeline_test_state* state = (struct pipeline_test_state*)user_data;
+    uint8_t* decoded_data;
+    uint32_t decoded_data_size;
+    if (slab != state->next_slab || arc_decode(encoded_data, encoded_data_size, &decoded_data, &decoded_data_size) == 0){
+        state->pass = 0;
+        return 0;
+    }
+    if (decoded_data_size != state->slab_size || memcmp(decoded_data, state->data + slab * state->slab_size, state->slab_size) != 0){
+        state->pass = 0;
+    }
+    free(decoded_data);
+    state->next_slab++;
+    return 1;
+}
+
+// Collects the errors reported by the scrubber in TEST 19
+struct scrub_test_state {
+    pthread_mutex_t lock;
+    uint32_t correctable;
+    uint32_t uncorrectable;
+    int reports;
+};
+
+void scrub_test_callback(uint8_t* encoded_data, uint32_t encoded_data_size, uint32_t correctable_blocks, uint32_t uncorrectable_blocks, void* user_data){
+    struct scrub_test_state* state = (struct scrub_test_state*)user_data;
+    pthread_mutex_lock(&state->lock);
+    state->correctable += correctable_blocks;
+    state->uncorrectable += uncorrectable_blocks;
+    state->reports++;
+    pthread_mutex_unlock(&state->lock);
+}
+
 int main(int argc, char *argv[]){
     int i, j, k;
     double i_lf;
@@ -761,6 +820,1148 @@ int main(int argc, char *argv[]){
         printf("\nERROR: ARC Joint Constraint Test Failed!\n\n");
     }
 
+
+
+    // *********************************
+    // TEST 9: ARC Batch Encoding Functionality
+    // *********************************
+    printf("Testing ARC's Batch Encoding Functionality\n");
+    for (i = 1; i <= 4; i++){
+        // Split the data stream into many small data streams of varying size
+        uint32_t batch_count = 50 * i;
+        uint8_t* batch_data[200];
+        uint32_t batch_sizes[200];
+        uint32_t batch_offset = 0;
+        for (j = 0; j < batch_count; j++){
+            batch_data[j] = data + batch_offset;
+            batch_sizes[j] = 1 + ((j * 977) % 2000);
+            batch_offset = batch_offset + batch_sizes[j];
+        }
+
+        // Encode with ARC
+        uint32_t arc_batch_encoded_size;
+        uint8_t* arc_batch_encoded;
+        uint32_t arc_batch_offsets[201];
+        int resiliency_constraint[] = {-i};
+        int batch_err = arc_encode_batch(batch_data, batch_sizes, batch_count, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_batch_encoded, arc_batch_offsets, &arc_batch_encoded_size);
+
+        // Decode each data stream with ARC and check for correctness
+        int arc_batch_pass = (batch_err == 1 && arc_batch_offsets[batch_count] == arc_batch_encoded_size);
+        for (j = 0; j < batch_count && arc_batch_pass == 1; j++){
+            uint32_t arc_batch_decoded_size;
+            uint8_t* arc_batch_decoded;
+            err = arc_decode(arc_batch_encoded + arc_batch_offsets[j], arc_batch_offsets[j+1] - arc_batch_offsets[j], &arc_batch_decoded, &arc_batch_decoded_size);
+            if (err == 1 && arc_batch_decoded_size == batch_sizes[j]){
+                if (memcmp(arc_batch_decoded, batch_data[j], batch_sizes[j]) != 0){
+                    arc_batch_pass = 0;
+                }
+                free(arc_batch_decoded);
+            } else {
+                arc_batch_pass = 0;
+            }
+        }
+
+        total_tests++;
+        if (arc_batch_pass == 1){
+            test_passes++;
+        }
+
+        // Free temp variables
+        if (batch_err == 1){
+            free(arc_batch_encoded);
+        }
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Batch Encoding Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Batch Encoding Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 10: ARC Asynchronous Functionality
+    // *********************************
+    printf("Testing ARC's Asynchronous Functionality\n");
+    int async_completed = 0;
+    int async_pass = 1;
+    struct arc_ticket* encode_tickets[4];
+    uint32_t async_sizes[4];
+    for (i = 0; i < 4; i++){
+        // Queue encodes of different portions of the data stream
+        async_sizes[i] = data_size / (i + 1);
+        int resiliency_constraint[] = {-(i + 1)};
+        encode_tickets[i] = arc_encode_async(data, async_sizes[i], ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, async_test_callback, &async_completed);
+        if (encode_tickets[i] == NULL){
+            async_pass = 0;
+        }
+    }
+    for (i = 0; i < 4; i++){
+        if (encode_tickets[i] == NULL){
+            continue;
+        }
+        // Wait for encode then decode asynchronously and check for correctness
+        uint32_t arc_async_encoded_size;
+        uint8_t* arc_async_encoded;
+        err = arc_wait(encode_tickets[i], &arc_async_encoded, &arc_async_encoded_size);
+        if (err != 1){
+            async_pass = 0;
+            continue;
+        }
+        struct arc_ticket* decode_ticket = arc_decode_async(arc_async_encoded, arc_async_encoded_size, async_test_callback, &async_completed);
+        uint32_t arc_async_decoded_size;
+        uint8_t* arc_async_decoded;
+        err = (decode_ticket != NULL) ? arc_wait(decode_ticket, &arc_async_decoded, &arc_async_decoded_size) : 0;
+        if (err == 1){
+            if (arc_async_decoded_size != async_sizes[i] || memcmp(arc_async_decoded, data, async_sizes[i]) != 0){
+                async_pass = 0;
+            }
+            free(arc_async_decoded);
+        } else {
+            async_pass = 0;
+        }
+        free(arc_async_encoded);
+    }
+    total_tests++;
+    if (async_pass == 1 && async_completed == 8){
+        test_passes++;
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Asynchronous Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Asynchronous Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 11: ARC Pipeline Functionality
+    // *********************************
+    printf("Testing ARC's Pipeline Functionality\n");
+    for (i = 1; i <= 4; i++){
+        // Vary slab count and queue depth
+        struct pipeline_test_state pipeline_state;
+        pipeline_state.data = data;
+        pipeline_state.slab_size = data_size / (4 * i);
+        pipeline_state.next_slab = 0;
+        pipeline_state.pass = 1;
+        int resiliency_constraint[] = {-i};
+        err = arc_pipeline(4 * i, i, pipeline_test_compress, pipeline_test_write, &pipeline_state, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1);
+
+        total_tests++;
+        if (err == 1 && pipeline_state.pass == 1 && pipeline_state.next_slab == 4 * i){
+            test_passes++;
+        }
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Pipeline Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Pipeline Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 12: ARC Check Functionality
+    // *********************************
+    printf("Testing ARC's Check Functionality\n");
+    for (i = 1; i <= 4; i++){
+        // Encode with each ECC method
+        uint32_t arc_check_encoded_size;
+        uint8_t* arc_check_encoded;
+        int resiliency_constraint[] = {-i};
+        err = arc_encode(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_check_encoded, &arc_check_encoded_size);
+        if (err == 0){
+            total_tests++;
+            continue;
+        }
+        uint32_t metadata_length = ARC_HEADER_LENGTH;
+        uint32_t clean, correctable, uncorrectable;
+
+        // Untouched data should be entirely clean
+        int check_pass = (arc_check(arc_check_encoded, arc_check_encoded_size, &clean, &correctable, &uncorrectable) == 1);
+        check_pass = check_pass && clean > 0 && correctable == 0 && uncorrectable == 0;
+
+        // A single bit flip in the first block is only correctable by Hamming, SECDED, and RS
+        arc_check_encoded[metadata_length + 1] ^= 0x01;
+        err = arc_check(arc_check_encoded, arc_check_encoded_size, &clean, &correctable, &uncorrectable);
+        if (i == 1){
+            check_pass = check_pass && err == 0 && correctable == 0 && uncorrectable == 1;
+        } else {
+            check_pass = check_pass && err == 1 && correctable == 1 && uncorrectable == 0;
+        }
+
+        // A second bit flip in the same SECDED block is detected as uncorrectable
+        if (i == 3){
+            arc_check_encoded[metadata_length + 1] ^= 0x02;
+            err = arc_check(arc_check_encoded, arc_check_encoded_size, &clean, &correctable, &uncorrectable);
+            check_pass = check_pass && err == 0 && correctable == 0 && uncorrectable == 1;
+        }
+
+        // A truncated data stream is rejected
+        check_pass = check_pass && arc_check(arc_check_encoded, arc_check_encoded_size - 1, NULL, NULL, NULL) == 0;
+
+        total_tests++;
+        if (check_pass == 1){
+            test_passes++;
+        }
+        free(arc_check_encoded);
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Check Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Check Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 13: ARC Range Decoding Functionality
+    // *********************************
+    printf("Testing ARC's Range Decoding Functionality\n");
+    uint32_t range_offsets[] = {0, 3, 12345, data_size - 5, 0};
+    uint32_t range_lengths[] = {1, 100, 7777, 5, data_size};
+    uint8_t* arc_range_decoded = malloc(data_size);
+    for (i = 1; i <= 4; i++){
+        // Encode with each ECC method
+        uint32_t arc_range_encoded_size;
+        uint8_t* arc_range_encoded;
+        int resiliency_constraint[] = {-i};
+        err = arc_encode(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_range_encoded, &arc_range_encoded_size);
+        if (err == 0){
+            total_tests++;
+            continue;
+        }
+        // Correctable codes should repair a flipped bit inside a requested range
+        if (i > 1){
+            arc_range_encoded[ARC_HEADER_LENGTH + 1] ^= 0x01;
+        }
+
+        // Decode a variety of ranges and compare against the original data
+        int range_pass = 1;
+        for (j = 0; j < 5; j++){
+            memset(arc_range_decoded, 0, data_size);
+            err = arc_decode_range(arc_range_encoded, arc_range_encoded_size, range_offsets[j], range_lengths[j], arc_range_decoded);
+            if (err != 1 || memcmp(arc_range_decoded, data + range_offsets[j], range_lengths[j]) != 0){
+                range_pass = 0;
+            }
+        }
+        // Ranges past the end of the data stream are rejected
+        if (arc_decode_range(arc_range_encoded, arc_range_encoded_size, data_size - 5, 6, arc_range_decoded) != 0){
+            range_pass = 0;
+        }
+
+        total_tests++;
+        if (range_pass == 1){
+            test_passes++;
+        }
+        free(arc_range_encoded);
+    }
+    free(arc_range_decoded);
+    if (test_passes == total_tests){
+        printf("\nARC Range Decoding Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Range Decoding Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 14: ARC Split Layout Functionality
+    // *********************************
+    printf("Testing ARC's Split Layout Functionality\n");
+    ARC_SPLIT_LAYOUT = 1;
+    for (i = 1; i <= 4; i++){
+        // Encode with each ECC method
+        uint32_t arc_split_encoded_size;
+        uint8_t* arc_split_encoded;
+        int resiliency_constraint[] = {-i};
+        err = arc_encode(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_split_encoded, &arc_split_encoded_size);
+        if (err == 0){
+            total_tests++;
+            continue;
+        }
+        uint32_t metadata_length = ARC_HEADER_LENGTH;
+
+        // The payload is stored contiguously right after the metadata
+        int split_pass = (memcmp(arc_split_encoded + metadata_length, data, data_size) == 0);
+
+        // A clean decode points straight into the encoded data stream
+        uint32_t arc_split_decoded_size;
+        uint8_t* arc_split_decoded;
+        int owned;
+        err = arc_decode_zero_copy(arc_split_encoded, arc_split_encoded_size, &arc_split_decoded, &arc_split_decoded_size, &owned);
+        split_pass = split_pass && err == 1 && owned == 0 && arc_split_decoded == arc_split_encoded + metadata_length && arc_split_decoded_size == data_size;
+
+        // Encoding in parts produces the same data stream without copying the payload
+        struct iovec parts[3];
+        uint8_t* check_data;
+        err = arc_encode_parts(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, parts, &check_data);
+        if (err == 1){
+            split_pass = split_pass && parts[1].iov_base == data && parts[0].iov_len + parts[1].iov_len + parts[2].iov_len == arc_split_encoded_size;
+            split_pass = split_pass && memcmp(parts[0].iov_base, arc_split_encoded, parts[0].iov_len) == 0;
+            split_pass = split_pass && memcmp(parts[2].iov_base, arc_split_encoded + metadata_length + data_size, parts[2].iov_len) == 0;
+            free(check_data);
+        } else {
+            split_pass = 0;
+        }
+
+        // Correctable errors in the payload are fixed by a copying decode
+        if (i > 1){
+            arc_split_encoded[metadata_length + 1] ^= 0x01;
+            err = arc_decode_zero_copy(arc_split_encoded, arc_split_encoded_size, &arc_split_decoded, &arc_split_decoded_size, &owned);
+            split_pass = split_pass && err == 1 && owned == 1 && arc_split_decoded_size == data_size && memcmp(arc_split_decoded, data, data_size) == 0;
+            if (err == 1){
+                free(arc_split_decoded);
+            }
+            // Range decodes also read from the split layout
+            uint8_t arc_split_range[64];
+            err = arc_decode_range(arc_split_encoded, arc_split_encoded_size, 0, 64, arc_split_range);
+            split_pass = split_pass && err == 1 && memcmp(arc_split_range, data, 64) == 0;
+        }
+
+        total_tests++;
+        if (split_pass == 1){
+            test_passes++;
+        }
+        free(arc_split_encoded);
+    }
+    ARC_SPLIT_LAYOUT = 0;
+    if (test_passes == total_tests){
+        printf("\nARC Split Layout Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Split Layout Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 15: ARC Packed Check Bit Functionality
+    // *********************************
+    printf("Testing ARC's Packed Check Bit Functionality\n");
+    int packed_methods[] = {ARC_PARITY, ARC_HAMMING, ARC_SECDED};
+    uint32_t packed_check_bits[] = {1, 4, 5};
+    for (i = 0; i < 3; i++){
+        // Encode with packed check bits
+        uint32_t arc_packed_encoded_size;
+        uint8_t* arc_packed_encoded;
+        err = arc_packed_encode(packed_methods[i], data, data_size, 1, 4, &arc_packed_encoded, &arc_packed_encoded_size);
+        if (err == 0){
+            total_tests++;
+            continue;
+        }
+
+        // The trailer holds exactly check_bits bits per byte of data
+        int packed_pass = (arc_packed_encoded_size == ARC_HEADER_LENGTH + data_size + ((data_size * packed_check_bits[i]) + 7) / 8);
+        packed_pass = packed_pass && memcmp(arc_packed_encoded + ARC_HEADER_LENGTH, data, data_size) == 0;
+
+        // Clean data streams decode straight back
+        uint32_t arc_packed_decoded_size;
+        uint8_t* arc_packed_decoded;
+        err = arc_decode(arc_packed_encoded, arc_packed_encoded_size, &arc_packed_decoded, &arc_packed_decoded_size);
+        packed_pass = packed_pass && err == 1 && arc_packed_decoded_size == data_size && memcmp(arc_packed_decoded, data, data_size) == 0;
+        if (err == 1){
+            free(arc_packed_decoded);
+        }
+
+        // Parity detects a flipped bit, Hamming and SECDED correct it
+        uint32_t clean_blocks, correctable_blocks, uncorrectable_blocks;
+        arc_packed_encoded[ARC_HEADER_LENGTH + 1001] ^= 0x04;
+        arc_check(arc_packed_encoded, arc_packed_encoded_size, &clean_blocks, &correctable_blocks, &uncorrectable_blocks);
+        if (i == 0){
+            packed_pass = packed_pass && uncorrectable_blocks == 1 && clean_blocks == data_size - 1;
+        } else {
+            packed_pass = packed_pass && correctable_blocks == 1 && clean_blocks == data_size - 1;
+            err = arc_decode(arc_packed_encoded, arc_packed_encoded_size, &arc_packed_decoded, &arc_packed_decoded_size);
+            packed_pass = packed_pass && err == 1 && memcmp(arc_packed_decoded, data, data_size) == 0;
+            if (err == 1){
+                free(arc_packed_decoded);
+            }
+        }
+
+        total_tests++;
+        if (packed_pass == 1){
+            test_passes++;
+        }
+        free(arc_packed_encoded);
+    }
+    // The optimizer offers packed Hamming-1 between Hamming-8 and unpacked Hamming-1
+    {
+        uint32_t arc_packed_encoded_size;
+        uint8_t* arc_packed_encoded;
+        int resiliency_constraint[] = {ARC_HAMMING};
+        err = arc_encode(data, data_size, 0.6, ARC_ANY_BW, resiliency_constraint, 1, &arc_packed_encoded, &arc_packed_encoded_size);
+        total_tests++;
+        if (err == 1 && arc_packed_encoded[5] == (0x02 | 0x10 | 0x20)){
+            test_passes++;
+        }
+        if (err == 1){
+            free(arc_packed_encoded);
+        }
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Packed Check Bit Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Packed Check Bit Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 16: ARC Salvage Decoding Functionality
+    // *********************************
+    printf("Testing ARC's Salvage Decoding Functionality\n");
+    {
+        // Encode with 16 byte parity blocks and corrupt the blocks holding bytes 1000 and 300000
+        uint32_t arc_salvage_encoded_size;
+        uint8_t* arc_salvage_encoded;
+        err = arc_parity_encode(data, data_size, 16, 4, &arc_salvage_encoded, &arc_salvage_encoded_size);
+        int salvage_pass = (err == 1);
+        if (err == 1){
+            arc_salvage_encoded[ARC_HEADER_LENGTH + ((1000 / 16) * 17) + 1 + (1000 % 16)] ^= 0x01;
+            arc_salvage_encoded[ARC_HEADER_LENGTH + ((300000 / 16) * 17) + 1 + (300000 % 16)] ^= 0x01;
+
+            // Every other block is returned intact and only the damaged blocks are flagged
+            uint32_t arc_salvage_decoded_size, block_count, error_blocks;
+            uint8_t* arc_salvage_decoded;
+            uint8_t* error_bitmap;
+            err = arc_decode_salvage(arc_salvage_encoded, arc_salvage_encoded_size, &arc_salvage_decoded, &arc_salvage_decoded_size, &error_bitmap, &block_count, &error_blocks, 0);
+            salvage_pass = (err == 0 && error_blocks == 2 && block_count == data_size / 16 && arc_salvage_decoded_size == data_size);
+            if (salvage_pass){
+                uint32_t block, offset, length;
+                for (block = 0; block < block_count; block++){
+                    arc_block_range(arc_salvage_encoded, arc_salvage_encoded_size, block, &offset, &length);
+                    if (error_bitmap[block / 8] & (1 << (block % 8))){
+                        salvage_pass = salvage_pass && ((offset <= 1000 && 1000 < offset + length) || (offset <= 300000 && 300000 < offset + length));
+                    } else {
+                        salvage_pass = salvage_pass && memcmp(arc_salvage_decoded + offset, data + offset, length) == 0;
+                    }
+                }
+            }
+            free(arc_salvage_decoded);
+            free(error_bitmap);
+
+            // Stopping early reports the damage without decoding every block
+            err = arc_decode_salvage(arc_salvage_encoded, arc_salvage_encoded_size, &arc_salvage_decoded, &arc_salvage_decoded_size, &error_bitmap, &block_count, &error_blocks, 1);
+            salvage_pass = salvage_pass && err == 0 && error_blocks >= 1;
+            free(arc_salvage_decoded);
+            free(error_bitmap);
+            free(arc_salvage_encoded);
+        }
+        total_tests++;
+        if (salvage_pass == 1){
+            test_passes++;
+        }
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Salvage Decoding Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Salvage Decoding Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 17: ARC Repair Functionality
+    // *********************************
+    printf("Testing ARC's Repair Functionality\n");
+    for (i = 0; i < 3; i++){
+        // Encode with Hamming-8, packed SECDED-1, and RS
+        uint32_t arc_repair_encoded_size;
+        uint8_t* arc_repair_encoded;
+        if (i == 0){
+            err = arc_hamming_encode(data, data_size, 8, 4, &arc_repair_encoded, &arc_repair_encoded_size);
+        } else if (i == 1){
+            err = arc_packed_encode(ARC_SECDED, data, data_size, 1, 4, &arc_repair_encoded, &arc_repair_encoded_size);
+        } else {
+            err = arc_reed_solomon_encode(data, data_size, 16, 4, 4, &arc_repair_encoded, &arc_repair_encoded_size);
+        }
+        if (err == 0){
+            total_tests++;
+            continue;
+        }
+        uint8_t* arc_repair_original = (uint8_t*)malloc(arc_repair_encoded_size);
+        memcpy(arc_repair_original, arc_repair_encoded, arc_repair_encoded_size);
+
+        // Corrupt a data byte and a check byte of two different blocks
+        arc_repair_encoded[1000] ^= 0x08;
+        arc_repair_encoded[arc_repair_encoded_size - 5] ^= 0x01;
+
+        // Repairing restores the original encoded data stream byte for byte
+        uint32_t repaired_blocks, uncorrectable_blocks;
+        err = arc_repair(arc_repair_encoded, arc_repair_encoded_size, &repaired_blocks, &uncorrectable_blocks);
+        int repair_pass = (err == 1 && repaired_blocks == 2 && uncorrectable_blocks == 0);
+        repair_pass = repair_pass && memcmp(arc_repair_encoded, arc_repair_original, arc_repair_encoded_size) == 0;
+
+        // A second scrub finds nothing left to repair
+        err = arc_repair(arc_repair_encoded, arc_repair_encoded_size, &repaired_blocks, &uncorrectable_blocks);
+        repair_pass = repair_pass && err == 1 && repaired_blocks == 0;
+
+        total_tests++;
+        if (repair_pass == 1){
+            test_passes++;
+        }
+        free(arc_repair_original);
+        free(arc_repair_encoded);
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Repair Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Repair Test Failed!\n\n");
+    }
+
+    // *********************************
+    // TEST 18: ARC Range Update Functionality
+    // *********************************
+    printf("Testing ARC's Range Update Functionality\n");
+    for (i = 1; i <= 4; i++){
+        // Encode a copy of the data with each ECC method
+        uint8_t* arc_update_data = (uint8_t*)malloc(data_size);
+        memcpy(arc_update_data, data, data_size);
+        uint32_t arc_update_encoded_size;
+        uint8_t* arc_update_encoded;
+        if (i == 1){
+            err = arc_parity_encode(arc_update_data, data_size, 16, 4, &arc_update_encoded, &arc_update_encoded_size);
+        } else if (i == 2){
+            err = arc_hamming_encode(arc_update_data, data_size, 8, 4, &arc_update_encoded, &arc_update_encoded_size);
+        } else if (i == 3){
+            err = arc_secded_encode(arc_update_data, data_size, 1, 4, &arc_update_encoded, &arc_update_encoded_size);
+        } else {
+            err = arc_reed_solomon_encode(arc_update_data, data_size, 32, 8, 4, &arc_update_encoded, &arc_update_encoded_size);
+        }
+        if (err == 0){
+            free(arc_update_data);
+            total_tests++;
+            continue;
+        }
+
+        // Update an unaligned range in place and in the original data
+        uint8_t arc_update_bytes[300];
+        for (k = 0; k < 300; k++){
+            arc_update_bytes[k] = (uint8_t)(k * 7 + i);
+        }
+        memcpy(arc_update_data + 12345, arc_update_bytes, 300);
+        err = arc_update_range(arc_update_encoded, arc_update_encoded_size, 12345, arc_update_bytes, 300);
+
+        // The result matches a full re-encode of the updated data
+        uint32_t arc_reencoded_size;
+        uint8_t* arc_reencoded;
+        int update_pass = (err == 1);
+        if (i == 1){
+            err = arc_parity_encode(arc_update_data, data_size, 16, 4, &arc_reencoded, &arc_reencoded_size);
+        } else if (i == 2){
+            err = arc_hamming_encode(arc_update_data, data_size, 8, 4, &arc_reencoded, &arc_reencoded_size);
+        } else if (i == 3){
+            err = arc_secded_encode(arc_update_data, data_size, 1, 4, &arc_reencoded, &arc_reencoded_size);
+        } else {
+            err = arc_reed_solomon_encode(arc_update_data, data_size, 32, 8, 4, &arc_reencoded, &arc_reencoded_size);
+        }
+        update_pass = update_pass && err == 1 && arc_reencoded_size == arc_update_encoded_size && memcmp(arc_reencoded, arc_update_encoded, arc_reencoded_size) == 0;
+
+        total_tests++;
+        if (update_pass == 1){
+            test_passes++;
+        }
+        free(arc_reencoded);
+        free(arc_update_encoded);
+        free(arc_update_data);
+    }
+    if (test_passes == total_tests){
+        printf("\nARC Range Update Test Passed!\n\n");
+    } else {
+        printf("\nERROR: ARC Range Update Test Failed!\n\n");
+    }
+
+    // TEST 19: ARC Scrubber Functionality
+    // *********************************
+    printf("Testing ARC's Scrubber Functionality\n");
+    uint32_t arc_scrub_hamming_size, arc_scrub_rs_size;
+    uint8_t* arc_scrub_hamming;
+    uint8_t* arc_scrub_rs;
+    err = arc_hamming_encode(data, data_size, 8, 4, &arc_scrub_hamming, &arc_scrub_hamming_size);
+    err = err && arc_reed_solomon_encode(data, data_size, 16, 4, 4, &arc_scrub_rs, &arc_scrub_rs_size);
+    if (err == 1){
+        uint8_t* arc_scrub_original = (uint8_t*)malloc(arc_scrub_hamming_size);
+        memcpy(arc_scrub_original, arc_scrub_hamming, arc_scrub_hamming_size);
+
+        // Corrupt one block in each data stream
+        arc_scrub_hamming[2000] ^= 0x10;
+        arc_scrub_rs[3000] ^= 0x40;
+
+        // Scrub both with repair enabled until the errors have been reported
+        struct scrub_test_state scrub_state;
+        pthread_mutex_init(&scrub_state.lock, NULL);
+        scrub_state.correctable = 0;
+        scrub_state.uncorrectable = 0;
+        scrub_state.reports = 0;
+        struct arc_scrubber* scrubber = arc_scrubber_create(ARC_ANY_BW, 0.01, 1, scrub_test_callback, &scrub_state);
+        int scrub_pass = (scrubber != NULL);
+        if (scrubber != NULL){
+            scrub_pass = scrub_pass && arc_scrubber_register(scrubber, arc_scrub_hamming, arc_scrub_hamming_size);
+            scrub_pass = scrub_pass && arc_scrubber_register(scrubber, arc_scrub_rs, arc_scrub_rs_size);
+            for (j = 0; j < 500; j++){
+                pthread_mutex_lock(&scrub_state.lock);
+                int reports = scrub_state.reports;
+                pthread_mutex_unlock(&scrub_state.lock);
+                if (reports >= 2){
+                    break;
+                }
+                usleep(10000);
+            }
+            scrub_pass = scrub_pass && arc_scrubber_unregister(scrubber, arc_scrub_rs);
+            scrub_pass = scrub_pass && !arc_scrubber_unregister(scrubber, arc_scrub_rs);
+            arc_scrubber_destroy(scrubber);
+        }
+
+        // Both errors were reported once and repaired in place
+        scrub_pass = scrub_pass && scrub_state.reports == 2 && scrub_state.correctable == 2 && scrub_state.uncorrectable == 0;
+        scrub_pass = scrub_pass && memcmp(arc_scrub_hamming, arc_scrub_original, arc_scrub_hamming_size) == 0;
+        uint32_t arc_scrub_decoded_size;
+        uint8_t* arc_scrub_decoded = NULL;
+        scrub_pass = scrub_pass && arc_decode(arc_scrub_rs, arc_scrub_rs_size, &arc_scrub_decoded, &arc_scrub_decoded_size);
+        uint32_t clean_blocks, correctable_blocks, uncorrectable_blocks;
+        scrub_pass = scrub_pass && arc_check(arc_scrub_rs, arc_scrub_rs_size, &clean_blocks, &correctable_blocks, &uncorrectable_blocks);
+        scrub_pass = scrub_pass && correctable_blocks == 0 && memcmp(arc_scrub_decoded, data, data_size) == 0;
+        if (scrub_pass == 1){
+            printf("\nARC Scrubber Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Scrubber Test Failed!\n\n");
+        }
+        pthread_mutex_destroy(&scrub_state.lock);
+        free(arc_scrub_decoded);
+        free(arc_scrub_original);
+        free(arc_scrub_hamming);
+        free(arc_scrub_rs);
+    } else {
+        printf("\nERROR: ARC Scrubber Test Failed!\n\n");
+    }
+
+    // TEST 20: ARC Versioned Header Functionality
+    // *********************************
+    printf("Testing ARC's Versioned Header Functionality\n");
+    {
+        uint32_t arc_header_encoded_size, arc_header_decoded_size;
+        uint8_t* arc_header_encoded;
+        uint8_t* arc_header_decoded;
+        err = arc_hamming_encode(data, data_size, 8, 4, &arc_header_encoded, &arc_header_encoded_size);
+        int header_pass = (err == 1 && arc_header_encoded[0] == 'A' && arc_header_encoded[4] == 2 && arc_header_encoded[5] == 0x02);
+        if (err == 1){
+            // Every single bit flip in the header is rejected before any block is touched
+            for (j = 0; j < ARC_HEADER_LENGTH * 8; j++){
+                arc_header_encoded[j / 8] ^= (uint8_t)(1 << (j % 8));
+                if (arc_check(arc_header_encoded, arc_header_encoded_size, NULL, NULL, NULL) != 0){
+                    header_pass = 0;
+                }
+                arc_header_encoded[j / 8] ^= (uint8_t)(1 << (j % 8));
+            }
+            err = arc_decode(arc_header_encoded, arc_header_encoded_size, &arc_header_decoded, &arc_header_decoded_size);
+            header_pass = header_pass && err == 1 && memcmp(arc_header_decoded, data, data_size) == 0;
+            if (err == 1){
+                free(arc_header_decoded);
+            }
+            free(arc_header_encoded);
+        }
+
+        // The legacy header can still be written and read
+        ARC_FORMAT_VERSION = 1;
+        err = arc_reed_solomon_encode(data, data_size, 16, 4, 4, &arc_header_encoded, &arc_header_encoded_size);
+        ARC_FORMAT_VERSION = 2;
+        header_pass = header_pass && err == 1 && arc_header_encoded[0] == 0x04;
+        if (err == 1){
+            err = arc_decode(arc_header_encoded, arc_header_encoded_size, &arc_header_decoded, &arc_header_decoded_size);
+            header_pass = header_pass && err == 1 && memcmp(arc_header_decoded, data, data_size) == 0;
+            if (err == 1){
+                free(arc_header_decoded);
+            }
+            free(arc_header_encoded);
+        }
+
+        // A payload checksum lets clean split data streams skip the block checks and survives range updates
+        ARC_PAYLOAD_CHECKSUM = 1;
+        ARC_SPLIT_LAYOUT = 1;
+        err = arc_secded_encode(data, data_size, 8, 4, &arc_header_encoded, &arc_header_encoded_size);
+        ARC_SPLIT_LAYOUT = 0;
+        header_pass = header_pass && err == 1;
+        if (err == 1){
+            int owned;
+            err = arc_decode_zero_copy(arc_header_encoded, arc_header_encoded_size, &arc_header_decoded, &arc_header_decoded_size, &owned);
+            header_pass = header_pass && err == 1 && owned == 0 && memcmp(arc_header_decoded, data, data_size) == 0;
+            uint8_t* arc_header_updated = (uint8_t*)malloc(data_size);
+            memcpy(arc_header_updated, data, data_size);
+            for (k = 0; k < 100; k++){
+                arc_header_updated[4321 + k] = (uint8_t)(k * 3);
+            }
+            err = arc_update_range(arc_header_encoded, arc_header_encoded_size, 4321, arc_header_updated + 4321, 100);
+            err = err && arc_decode(arc_header_encoded, arc_header_encoded_size, &arc_header_decoded, &arc_header_decoded_size);
+            header_pass = header_pass && err == 1 && memcmp(arc_header_decoded, arc_header_updated, data_size) == 0;
+            if (err == 1){
+                free(arc_header_decoded);
+            }
+
+            // An uncorrectable block is skipped by the update and left out of the checksum patch, the rest are still updated
+            arc_header_encoded[ARC_HEADER_LENGTH + 4400] ^= 0x03;
+            uint8_t arc_header_stale[8];
+            memcpy(arc_header_stale, arc_header_updated + 4400, 8);
+            for (k = 0; k < 100; k++){
+                arc_header_updated[4321 + k] = (uint8_t)(k * 5 + 1);
+            }
+            err = arc_update_range(arc_header_encoded, arc_header_encoded_size, 4321, arc_header_updated + 4321, 100);
+            header_pass = header_pass && err == 0;
+            memcpy(arc_header_updated + 4400, arc_header_stale, 8);
+            arc_header_encoded[ARC_HEADER_LENGTH + 4400] ^= 0x03;
+            err = arc_decode(arc_header_encoded, arc_header_encoded_size, &arc_header_decoded, &arc_header_decoded_size);
+            header_pass = header_pass && err == 1 && memcmp(arc_header_decoded, arc_header_updated, data_size) == 0;
+            if (err == 1){
+                free(arc_header_decoded);
+            }
+            free(arc_header_updated);
+            free(arc_header_encoded);
+        }
+
+        // A double bit error that Hamming silently miscorrects is caught by the payload checksum
+        err = arc_hamming_encode(data, data_size, 8, 4, &arc_header_encoded, &arc_header_encoded_size);
+        ARC_PAYLOAD_CHECKSUM = 0;
+        header_pass = header_pass && err == 1;
+        if (err == 1){
+            arc_header_encoded[ARC_HEADER_LENGTH + 1] ^= 0x06;
+            err = arc_decode(arc_header_encoded, arc_header_encoded_size, &arc_header_decoded, &arc_header_decoded_size);
+            header_pass = header_pass && err == 0;
+            if (err == 1){
+                free(arc_header_decoded);
+            }
+            free(arc_header_encoded);
+        }
+
+        if (header_pass == 1){
+            printf("\nARC Versioned Header Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Versioned Header Test Failed!\n\n");
+        }
+    }
+
+    // TEST 21: ARC Scatter-Gather Encoding Functionality
+    // *********************************
+    printf("Testing ARC's Scatter-Gather Encoding Functionality\n");
+    {
+        // Split the data into uneven fragments (including an empty one) so blocks straddle boundaries
+        uint32_t fragment_sizes[] = {1, 7, 13, 0, 4093, 3, 100000};
+        struct iovec fragments[8];
+        uint32_t fragment_offset = 0;
+        for (j = 0; j < 7; j++){
+            fragments[j].iov_base = data + fragment_offset;
+            fragments[j].iov_len = fragment_sizes[j];
+            fragment_offset = fragment_offset + fragment_sizes[j];
+        }
+        fragments[7].iov_base = data + fragment_offset;
+        fragments[7].iov_len = data_size - fragment_offset;
+
+        int gather_pass = 1;
+        for (i = 0; i < 7; i++){
+            // Every codec (and a split layout) matches encoding the contiguous data
+            uint32_t arc_gather_size, arc_contiguous_size;
+            uint8_t* arc_gather_encoded;
+            uint8_t* arc_contiguous_encoded;
+            ARC_SPLIT_LAYOUT = (i == 6);
+            if (i == 0){
+                err = arc_parity_encodev(fragments, 8, 16, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_parity_encode(data, data_size, 16, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            } else if (i == 1){
+                err = arc_hamming_encodev(fragments, 8, 8, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_hamming_encode(data, data_size, 8, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            } else if (i == 2){
+                err = arc_secded_encodev(fragments, 8, 1, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_secded_encode(data, data_size, 1, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            } else if (i == 3){
+                err = arc_reed_solomon_encodev(fragments, 8, 32, 8, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_reed_solomon_encode(data, data_size, 32, 8, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            } else if (i == 4){
+                err = arc_packed_encodev(ARC_PARITY, fragments, 8, 3, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_packed_encode(ARC_PARITY, data, data_size, 3, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            } else if (i == 5){
+                err = arc_packed_encodev(ARC_SECDED, fragments, 8, 1, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_packed_encode(ARC_SECDED, data, data_size, 1, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            } else {
+                err = arc_reed_solomon_encodev(fragments, 8, 16, 4, 4, &arc_gather_encoded, &arc_gather_size);
+                err = err && arc_reed_solomon_encode(data, data_size, 16, 4, 4, &arc_contiguous_encoded, &arc_contiguous_size);
+            }
+            ARC_SPLIT_LAYOUT = 0;
+            gather_pass = gather_pass && err == 1 && arc_gather_size == arc_contiguous_size && memcmp(arc_gather_encoded, arc_contiguous_encoded, arc_gather_size) == 0;
+            if (err == 1){
+                free(arc_gather_encoded);
+                free(arc_contiguous_encoded);
+            }
+        }
+
+        // The optimizer driven variant decodes back to the concatenated fragments
+        int resiliency_constraint[] = {ARC_ANY_ECC};
+        uint32_t arc_gather_size, arc_gather_decoded_size;
+        uint8_t* arc_gather_encoded;
+        uint8_t* arc_gather_decoded;
+        err = arc_encodev(fragments, 8, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_gather_encoded, &arc_gather_size);
+        err = err && arc_decode(arc_gather_encoded, arc_gather_size, &arc_gather_decoded, &arc_gather_decoded_size);
+        gather_pass = gather_pass && err == 1 && arc_gather_decoded_size == data_size && memcmp(arc_gather_decoded, data, data_size) == 0;
+        if (err == 1){
+            free(arc_gather_decoded);
+            free(arc_gather_encoded);
+        }
+
+        if (gather_pass == 1){
+            printf("\nARC Scatter-Gather Encoding Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Scatter-Gather Encoding Test Failed!\n\n");
+        }
+    }
+
+    // TEST 22: ARC Encode Report and Statistics Functionality
+    // *********************************
+    printf("Testing ARC's Encode Report and Statistics Functionality\n");
+    {
+        // The report describes the configuration chosen and the encoded result
+        int report_pass = 1;
+        int resiliency_constraint[] = {ARC_ANY_ECC};
+        struct arc_encode_report report;
+        struct arc_stats stats;
+        uint32_t arc_report_size, arc_report_decoded_size;
+        uint8_t* arc_report_encoded;
+        uint8_t* arc_report_decoded;
+        arc_reset_stats();
+        err = arc_encode_reported(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_report_encoded, &arc_report_size, &report);
+        report_pass = report_pass && err == 1 && report.ecc_algorithm >= 1 && report.ecc_algorithm <= 4;
+        report_pass = report_pass && report.bytes_in == data_size && report.bytes_out == arc_report_size;
+        report_pass = report_pass && report.predicted_throughput > 0 && report.measured_throughput > 0;
+        report_pass = report_pass && report.total_seconds >= report.optimize_seconds + report.encode_seconds;
+        if (err == 1){
+            free(arc_report_encoded);
+        }
+
+        // A single bit error corrected while decoding is counted
+        err = arc_hamming_encode(data, data_size, 8, 4, &arc_report_encoded, &arc_report_size);
+        arc_report_encoded[ARC_HEADER_LENGTH + 1] ^= 0x10;
+        err = err && arc_decode(arc_report_encoded, arc_report_size, &arc_report_decoded, &arc_report_decoded_size);
+        report_pass = report_pass && err == 1 && memcmp(arc_report_decoded, data, data_size) == 0;
+        if (err == 1){
+            free(arc_report_decoded);
+        }
+        free(arc_report_encoded);
+        arc_get_stats(&stats);
+        report_pass = report_pass && stats.encode_calls == 1 && stats.bytes_protected == data_size;
+        report_pass = report_pass && stats.decode_calls == 1 && stats.bytes_decoded == data_size;
+        report_pass = report_pass && stats.blocks_corrected == 1 && stats.blocks_uncorrectable == 0;
+        report_pass = report_pass && stats.encode_seconds[report.ecc_algorithm] > 0 && stats.decode_seconds[2] > 0;
+
+        if (report_pass == 1){
+            printf("\nARC Encode Report and Statistics Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Encode Report and Statistics Test Failed!\n\n");
+        }
+    }
+
+    // TEST 23: ARC Tracing Functionality
+    // *********************************
+    printf("Testing ARC's Tracing Functionality\n");
+    {
+        // Encode and decode while tracing, then check the Chrome trace holds balanced phase events
+        int trace_pass = 1;
+        int resiliency_constraint[] = {ARC_ANY_ECC};
+        uint32_t arc_trace_encoded_size, arc_trace_decoded_size;
+        uint8_t* arc_trace_encoded;
+        uint8_t* arc_trace_decoded;
+        char* trace_file = "arc_test_trace.json";
+        trace_pass = trace_pass && arc_trace_start(trace_file) == 1;
+        err = arc_encode(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_trace_encoded, &arc_trace_encoded_size);
+        err = err && arc_decode(arc_trace_encoded, arc_trace_encoded_size, &arc_trace_decoded, &arc_trace_decoded_size);
+        trace_pass = trace_pass && err == 1;
+        if (err == 1){
+            free(arc_trace_decoded);
+            free(arc_trace_encoded);
+        }
+        trace_pass = trace_pass && arc_trace_stop() == 1 && ARC_TRACE == 0;
+
+        FILE* trace_fp = fopen(trace_file, "r");
+        trace_pass = trace_pass && trace_fp != NULL;
+        if (trace_fp != NULL){
+            char line[256];
+            int begins = 0, ends = 0, optimize = 0, encode_kernel = 0, decode_kernel = 0;
+            trace_pass = trace_pass && fgets(line, sizeof(line), trace_fp) != NULL && strncmp(line, "{\"traceEvents\":[", 16) == 0;
+            while (fgets(line, sizeof(line), trace_fp) != NULL){
+                begins += (strstr(line, "\"ph\":\"B\"") != NULL);
+                ends += (strstr(line, "\"ph\":\"E\"") != NULL);
+                optimize += (strstr(line, "\"name\":\"optimize\"") != NULL);
+                encode_kernel += (strstr(line, "\"name\":\"encode_kernel\"") != NULL);
+                decode_kernel += (strstr(line, "\"name\":\"decode_kernel\"") != NULL);
+            }
+            fclose(trace_fp);
+            remove(trace_file);
+            trace_pass = trace_pass && begins > 0 && begins == ends && optimize >= 2 && encode_kernel >= 2 && decode_kernel >= 2;
+        }
+
+        if (trace_pass == 1){
+            printf("\nARC Tracing Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Tracing Test Failed!\n\n");
+        }
+    }
+
+    // TEST 24: ARC Workload Capture Functionality
+    // *********************************
+    printf("Testing ARC's Workload Capture Functionality\n");
+    {
+        // Capture encodes of a few sizes through every encode entry point, then read the capture back and check each
+        // call and its plan were logged
+        int capture_pass = 1;
+        int resiliency_constraint[] = {ARC_HAMMING, ARC_SECDED};
+        uint32_t capture_sizes[6] = {4096, 65536, data_size, 8192, 8192, 4096};
+        uint32_t capture_encoded_sizes[6];
+        char* capture_file = "arc_test_capture.cap";
+        int i;
+        capture_pass = capture_pass && arc_capture_start(capture_file) == 1;
+        for (i = 0; i < 3; i++){
+            uint8_t* arc_capture_encoded;
+            err = arc_encode(data, capture_sizes[i], ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 2, &arc_capture_encoded, &capture_encoded_sizes[i]);
+            capture_pass = capture_pass && err == 1;
+            if (err == 1){
+                free(arc_capture_encoded);
+            }
+        }
+        {
+            // Vectored, batch, and multipart encodes are logged as one call over all of their data
+            uint8_t* arc_capture_encoded;
+            struct iovec capture_parts[3] = {{data, 1000}, {data + 1000, 7192}};
+            err = arc_encodev(capture_parts, 2, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 2, &arc_capture_encoded, &capture_encoded_sizes[3]);
+            capture_pass = capture_pass && err == 1;
+            if (err == 1){
+                free(arc_capture_encoded);
+            }
+            uint8_t* capture_batch[2] = {data, data + 4096};
+            uint32_t capture_batch_sizes[2] = {4096, 4096};
+            uint32_t capture_offsets[3];
+            err = arc_encode_batch(capture_batch, capture_batch_sizes, 2, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 2, &arc_capture_encoded, capture_offsets, &capture_encoded_sizes[4]);
+            capture_pass = capture_pass && err == 1;
+            if (err == 1){
+                free(arc_capture_encoded);
+            }
+            err = arc_encode_parts(data, 4096, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 2, capture_parts, &arc_capture_encoded);
+            capture_pass = capture_pass && err == 1;
+            if (err == 1){
+                capture_encoded_sizes[5] = capture_parts[0].iov_len + capture_parts[1].iov_len + capture_parts[2].iov_len;
+                free(arc_capture_encoded);
+            }
+        }
+        capture_pass = capture_pass && arc_capture_stop() == 1;
+
+        FILE* capture_fp = arc_capture_open(capture_file);
+        capture_pass = capture_pass && capture_fp != NULL;
+        if (capture_fp != NULL){
+            struct arc_capture_record record;
+            double last_timestamp = -1;
+            int records = 0;
+            while (arc_capture_read(capture_fp, &record) == 1){
+                capture_pass = capture_pass && records < 6 && record.data_size == capture_sizes[records] && record.encoded_data_size == capture_encoded_sizes[records];
+                capture_pass = capture_pass && record.memory_constraint == ARC_ANY_SIZE && record.throughput_constraint == ARC_ANY_BW;
+                capture_pass = capture_pass && record.resiliency_count == 2 && record.resiliency_constraint[0] == ARC_HAMMING && record.resiliency_constraint[1] == ARC_SECDED;
+                capture_pass = capture_pass && (record.ecc_algorithm == 2 || record.ecc_algorithm == 3) && record.num_threads >= 1;
+                capture_pass = capture_pass && record.timestamp >= last_timestamp && record.encode_seconds > 0 && record.total_seconds >= record.encode_seconds;
+                last_timestamp = record.timestamp;
+                records++;
+            }
+            fclose(capture_fp);
+            capture_pass = capture_pass && records == 6;
+        }
+        remove(capture_file);
+
+        if (capture_pass == 1){
+            printf("\nARC Workload Capture Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Workload Capture Test Failed!\n\n");
+        }
+    }
+
+    // TEST 25: ARC Roofline Functionality
+    // *********************************
+    printf("Testing ARC's Roofline Functionality\n");
+    {
+        // Every thread count has a probed bandwidth and encodes report their share of it
+        int roofline_pass = 1;
+        int resiliency_constraint[] = {ARC_ANY_ECC};
+        uint32_t arc_roofline_encoded_size;
+        uint8_t* arc_roofline_encoded;
+        struct arc_encode_report roofline_report;
+        uint32_t t;
+        for (t = 1; t <= (uint32_t)AVAIL_THREADS; t++){
+            roofline_pass = roofline_pass && arc_roofline_bandwidth(t) > 0;
+        }
+        roofline_pass = roofline_pass && arc_roofline_bandwidth(0) == -1 && arc_roofline_bandwidth(AVAIL_THREADS + 1) == -1;
+        roofline_pass = roofline_pass && arc_roofline_fraction(1000000, 1000000, 1.0, 1) > 0 && arc_roofline_fraction(1000000, 1000000, 0, 1) == -1;
+        err = arc_encode_reported(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_roofline_encoded, &arc_roofline_encoded_size, &roofline_report);
+        roofline_pass = roofline_pass && err == 1 && roofline_report.roofline_fraction > 0;
+        if (err == 1){
+            free(arc_roofline_encoded);
+        }
+
+        // With a near zero bound every configuration counts as memory-bound, so the optimizer caps to a single thread
+        double roofline_bound = ARC_ROOFLINE_BOUND;
+        ARC_ROOFLINE_BOUND = 1E-9;
+        err = arc_encode_reported(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_roofline_encoded, &arc_roofline_encoded_size, &roofline_report);
+        roofline_pass = roofline_pass && err == 1 && roofline_report.num_threads == 1;
+        if (err == 1){
+            free(arc_roofline_encoded);
+        }
+        ARC_ROOFLINE_BOUND = roofline_bound;
+
+        if (roofline_pass == 1){
+            printf("\nARC Roofline Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Roofline Test Failed!\n\n");
+        }
+    }
+
+    // TEST 26: ARC Online Learning Functionality
+    // *********************************
+    printf("Testing ARC's Online Learning Functionality\n");
+    {
+        // Each encode adds a sample to the configuration it used, moves its estimate toward the measurement,
+        // and passes part of that change on to the same configuration on a neighbouring thread count
+        int learning_pass = 1;
+        int resiliency_constraint[] = {ARC_SECDED};
+        uint32_t arc_learning_encoded_size;
+        uint8_t* arc_learning_encoded;
+        struct arc_encode_report learning_report;
+        double mean_before, variance_before, mean_after, variance_after;
+        double neighbour_before, neighbour_after, neighbour_variance;
+        uint32_t count_before, count_after, neighbour_count;
+        int i;
+        err = arc_encode_reported(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_learning_encoded, &arc_learning_encoded_size, &learning_report);
+        learning_pass = learning_pass && err == 1;
+        if (err == 1){
+            free(arc_learning_encoded);
+            uint32_t neighbour_threads = (learning_report.num_threads > 1) ? learning_report.num_threads - 1 : learning_report.num_threads + 1;
+            int has_neighbour = neighbour_threads <= (uint32_t)AVAIL_THREADS;
+            learning_pass = learning_pass && arc_configuration_estimate(learning_report.ecc_algorithm, learning_report.ecc_parameter_a, learning_report.ecc_parameter_b,
+                learning_report.num_threads, &mean_before, &variance_before, &count_before) == 1;
+            if (has_neighbour){
+                learning_pass = learning_pass && arc_configuration_estimate(learning_report.ecc_algorithm, learning_report.ecc_parameter_a, learning_report.ecc_parameter_b,
+                    neighbour_threads, &neighbour_before, &neighbour_variance, &neighbour_count) == 1;
+            }
+            learning_pass = learning_pass && arc_configuration_estimate(learning_report.ecc_algorithm, 0xFFFF, 0xFFFF, 1, &mean_after, &variance_after, &count_after) == 0;
+
+            // Encode again with the same constraints (the same configuration is chosen) and compare
+            for (i = 0; i < 3 && learning_pass; i++){
+                struct arc_encode_report repeat_report;
+                err = arc_encode_reported(data, data_size, ARC_ANY_SIZE, ARC_ANY_BW, resiliency_constraint, 1, &arc_learning_encoded, &arc_learning_encoded_size, &repeat_report);
+                learning_pass = learning_pass && err == 1 && repeat_report.ecc_parameter_a == learning_report.ecc_parameter_a && repeat_report.num_threads == learning_report.num_threads;
+                if (err == 1){
+                    free(arc_learning_encoded);
+                }
+                learning_pass = learning_pass && arc_configuration_estimate(repeat_report.ecc_algorithm, repeat_report.ecc_parameter_a, repeat_report.ecc_parameter_b,
+                    repeat_report.num_threads, &mean_after, &variance_after, &count_after) == 1;
+                learning_pass = learning_pass && (count_after == count_before + 1 || count_before == UINT32_MAX) && variance_after >= 0;
+                // The estimate moves toward the (possibly clamped) measurement without passing it
+                double lower = (mean_before < repeat_report.measured_throughput) ? mean_before : repeat_report.measured_throughput;
+                double upper = (mean_before < repeat_report.measured_throughput) ? repeat_report.measured_throughput : mean_before;
+                learning_pass = learning_pass && mean_after >= lower * 0.999999 && mean_after <= upper * 1.000001;
+                if (has_neighbour){
+                    learning_pass = learning_pass && arc_configuration_estimate(repeat_report.ecc_algorithm, repeat_report.ecc_parameter_a, repeat_report.ecc_parameter_b,
+                        neighbour_threads, &neighbour_after, &neighbour_variance, &neighbour_count) == 1;
+                    // The neighbour moves in the same direction by a smaller relative amount
+                    double change = (mean_after / mean_before) - 1;
+                    double neighbour_change = (neighbour_after / neighbour_before) - 1;
+                    learning_pass = learning_pass && change * neighbour_change >= 0 && fabs(neighbour_change) <= fabs(change) + 1E-12;
+                    neighbour_before = neighbour_after;
+                }
+                mean_before = mean_after;
+                count_before = count_after;
+            }
+        }
+
+        if (learning_pass == 1){
+            printf("\nARC Online Learning Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Online Learning Test Failed!\n\n");
+        }
+    }
+
+    // TEST 27: ARC Exploration Functionality
+    // *********************************
+    printf("Testing ARC's Exploration Functionality\n");
+    {
+        // Every explored configuration must still use the requested method and meet the memory constraint
+        int explore_pass = 1;
+        int resiliency_constraint[] = {ARC_SECDED};
+        uint32_t arc_explore_encoded_size;
+        uint8_t* arc_explore_encoded;
+        uint8_t* arc_explore_decoded;
+        uint32_t arc_explore_decoded_size;
+        struct arc_encode_report explore_report;
+        struct arc_stats explore_stats;
+        int policies[2] = {ARC_EXPLORE_EPSILON, ARC_EXPLORE_UCB};
+        double explore_rate = ARC_EXPLORE_RATE;
+        int p, i;
+        arc_reset_stats();
+        // Explore on every epsilon-greedy decision so the policy is exercised
+        ARC_EXPLORE_RATE = 1.0;
+        for (p = 0; p < 2; p++){
+            ARC_EXPLORE = policies[p];
+            for (i = 0; i < 20 && explore_pass; i++){
+                err = arc_encode_reported(data, data_size, 1.5, ARC_ANY_BW, resiliency_constraint, 1, &arc_explore_encoded, &arc_explore_encoded_size, &explore_report);
+                explore_pass = explore_pass && err == 1 && explore_report.ecc_algorithm == 3 && explore_report.num_threads >= 1 && explore_report.num_threads <= (uint32_t)AVAIL_THREADS;
+                explore_pass = explore_pass && ((double)arc_explore_encoded_size / (double)data_size) - 1 <= 1.5 + 0.01;
+                if (err == 1){
+                    err = arc_decode(arc_explore_encoded, arc_explore_encoded_size, &arc_explore_decoded, &arc_explore_decoded_size);
+                    explore_pass = explore_pass && err == 1 && arc_explore_decoded_size == data_size && memcmp(arc_explore_decoded, data, data_size) == 0;
+                    if (err == 1){
+                        free(arc_explore_decoded);
+                    }
+                    free(arc_explore_encoded);
+                }
+            }
+        }
+        ARC_EXPLORE = ARC_EXPLORE_NONE;
+        ARC_EXPLORE_RATE = explore_rate;
+        // With more than one thread there are several candidates, so random picks differ from the optimizer's choice at some point
+        explore_pass = explore_pass && arc_get_stats(&explore_stats) == 1 && (AVAIL_THREADS == 1 || explore_stats.explorations > 0);
+
+        if (explore_pass == 1){
+            printf("\nARC Exploration Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Exploration Test Failed!\n\n");
+        }
+    }
+
+    // TEST 28: ARC Method Decoder Layout Functionality
+    // *********************************
+    printf("Testing ARC's Method Decoder Layout Functionality\n");
+    {
+        // Each method's decoder must accept split and packed streams written without a versioned header
+        int layout_pass = 1;
+        uint32_t arc_layout_encoded_size;
+        uint8_t* arc_layout_encoded;
+        uint8_t* arc_layout_decoded;
+        uint32_t arc_layout_decoded_size;
+        int packed_methods[] = {ARC_PARITY, ARC_HAMMING, ARC_SECDED};
+        int (*decoders[])(uint8_t*, uint32_t, uint8_t**, uint32_t*) = {arc_parity_decode, arc_hamming_decode, arc_secded_decode, arc_reed_solomon_decode};
+        int split_layout = ARC_SPLIT_LAYOUT;
+        int format_version = ARC_FORMAT_VERSION;
+        int m, packed;
+        ARC_FORMAT_VERSION = 1;
+        for (packed = 0; packed < 2; packed++){
+            ARC_SPLIT_LAYOUT = !packed;
+            for (m = 0; m < (packed ? 3 : 4); m++){
+                if (packed){
+                    err = arc_packed_encode(packed_methods[m], data, data_size, 1, 4, &arc_layout_encoded, &arc_layout_encoded_size);
+                } else if (m == 0){
+                    err = arc_parity_encode(data, data_size, 8, 4, &arc_layout_encoded, &arc_layout_encoded_size);
+                } else if (m == 1){
+                    err = arc_hamming_encode(data, data_size, 8, 4, &arc_layout_encoded, &arc_layout_encoded_size);
+                } else if (m == 2){
+                    err = arc_secded_encode(data, data_size, 8, 4, &arc_layout_encoded, &arc_layout_encoded_size);
+                } else {
+                    err = arc_reed_solomon_encode(data, data_size, 4, 2, 4, &arc_layout_encoded, &arc_layout_encoded_size);
+                }
+                layout_pass = layout_pass && err == 1;
+                if (err == 1){
+                    err = decoders[m](arc_layout_encoded, arc_layout_encoded_size, &arc_layout_decoded, &arc_layout_decoded_size);
+                    layout_pass = layout_pass && err == 1 && arc_layout_decoded_size == data_size && memcmp(arc_layout_decoded, data, data_size) == 0;
+                    if (err == 1){
+                        free(arc_layout_decoded);
+                    }
+                    free(arc_layout_encoded);
+                }
+            }
+        }
+        ARC_SPLIT_LAYOUT = split_layout;
+        ARC_FORMAT_VERSION = format_version;
+
+        if (layout_pass == 1){
+            printf("\nARC Method Decoder Layout Test Passed!\n\n");
+        } else {
+            printf("\nERROR: ARC Method Decoder Layout Test Failed!\n\n");
+        }
+    }
+
     printf("\nALL TESTS HAVE FINISHED!\n");
     arc_save();
     arc_close();